@@ -88,6 +88,7 @@ bool DaikinController::connect(HardwareSerial *serial)
   this->_serial = serial;
   daikinUART->setSerial(serial);
   bool res = daikinUART->setup();
+  syncIndex = 0;
   if (res)
   {
     sync(); // get initial data
@@ -155,61 +156,75 @@ void DaikinController::onFirstQuerySuccess()
 
 bool DaikinController::sync()
 {
-  // Log.ln(TAG, "Start Sync");
-  // delay(100);
+  SyncResult result;
+  do
+  {
+    result = syncStep();
+    if (result == SYNC_GUARD)
+      delay(SYNC_LINE_GUARD_MS);
+  } while (result == SYNC_BUSY || result == SYNC_GUARD);
+  return result == SYNC_DONE;
+}
 
+SyncResult DaikinController::syncStep()
+{
   static bool firstSuccess = true;
-  bool success = true;
   bool res = false;
 
-  if (millis() - lastSyncMs < SYNC_INTEVAL)
+  if (syncIndex == 0)
   {
-    return false;
+    if (millis() - lastSyncMs < SYNC_INTEVAL)
+    {
+      return SYNC_WAIT;
+    }
+    // Quiet line before the X50 queries, as the blocking sync() had it. The short gaps between the
+    // steps of a cycle have not been verified on X50 hardware, this guard has.
+    if (daikinUART->currentProtocol() == PROTOCOL_X50 && !lineGuarded)
+    {
+      LOGD(TAG, "Query X50");
+      lineGuarded = true;
+      return SYNC_GUARD;
+    }
+    lineGuarded = false;
+    syncSuccess = true;
   }
 
+  uint8_t size = 0;
   if (daikinUART->currentProtocol() == PROTOCOL_S21)
   {
-
-    uint8_t size = sizeof(S21queryCmds) / sizeof(String);
-
-    for (int i = 0; i < size; i++)
+    size = sizeof(S21queryCmds) / sizeof(String);
+    if (syncIndex < size)
     {
+      LOGD(TAG, "Send command: %s", S21queryCmds[syncIndex].c_str());
 
-      Log.ln(TAG, String("Send command: " + S21queryCmds[i]));
-
-      res = daikinUART->sendCommandS21(S21queryCmds[i][0], S21queryCmds[i][1]);
+      res = daikinUART->sendCommandS21(S21queryCmds[syncIndex][0], S21queryCmds[syncIndex][1]);
       if (res)
       {
         ACResponse response = daikinUART->getResponse();
         parseResponse(&response);
       }
       // ("Result: %s\n\n", res ? "Success" : "Failed");
-      success = success | res;
+      syncSuccess = syncSuccess | res;
     }
   }
 
   else if (daikinUART->currentProtocol() == PROTOCOL_X50)
   {
-    Log.ln(TAG, "Query X50");
-    delay(100);
-
-    uint8_t cmdSize = sizeof(X50queryCmds) / sizeof(uint8_t);
-
-    // Periodically Query
-    for (int i = 0; i < cmdSize; i++)
+    size = sizeof(X50queryCmds) / sizeof(uint8_t);
+    if (syncIndex < size)
     {
       uint8_t payload[17] = {0};
 
-      Log.ln(TAG, "Send command: " + String(X50queryCmds[i], HEX));
+      LOGD(TAG, "Send command: %X", X50queryCmds[syncIndex]);
 
-      switch (X50queryCmds[i])
+      switch (X50queryCmds[syncIndex])
       {
       case 0xCA:
-        res = daikinUART->sendCommandX50(X50queryCmds[i], payload, sizeof(payload));
+        res = daikinUART->sendCommandX50(X50queryCmds[syncIndex], payload, sizeof(payload));
         break;
 
       default:
-        res = daikinUART->sendCommandX50(X50queryCmds[i], NULL, 0);
+        res = daikinUART->sendCommandX50(X50queryCmds[syncIndex], NULL, 0);
         break;
       }
 
@@ -219,11 +234,25 @@ bool DaikinController::sync()
         parseResponse(&response);
       }
       // ("Result: %s\n\n", res ? "Success" : "Failed");
-      success = success & res;
+      syncSuccess = syncSuccess & res;
     }
   }
 
-  if (success && firstSuccess)
+  if (++syncIndex < size)
+  {
+    return SYNC_BUSY;
+  }
+  // And after the cycle, before the commands and raw frames that were waiting for it. The cycle only
+  // ends on the step after this one, so syncIndex stays past the last query until then.
+  if (!lineGuarded)
+  {
+    lineGuarded = true;
+    return SYNC_GUARD;
+  }
+  lineGuarded = false;
+  syncIndex = 0;
+
+  if (syncSuccess && firstSuccess)
   {
     onFirstQuerySuccess();
     firstSuccess = false;
@@ -231,9 +260,16 @@ bool DaikinController::sync()
 
   lastSyncMs = millis();
 
-  Log.ln(TAG, "End Sync");
-  delay(100);
-  return success;
+  LOGD(TAG, "End Sync");
+  return syncSuccess ? SYNC_DONE : SYNC_FAILED;
+}
+
+uint32_t DaikinController::msUntilSync()
+{
+  if (syncIndex != 0)
+    return 0;
+  unsigned long elapsed = millis() - lastSyncMs;
+  return elapsed < SYNC_INTEVAL ? SYNC_INTEVAL - elapsed : 0;
 }
 
 const char *DaikinController::lookupByteMapValue(const char *valuesMap[], const byte byteMap[], int len, byte byteValue)
@@ -318,10 +354,11 @@ bool DaikinController::parseResponse(ACResponse *response)
         bool error = payload[0] & 0x01;
 
         if (error){
-          currentStatus.errorCode = S21errorCodeDivision[payload[1] >> 4];
-          currentStatus.errorCode += S21errorCodeDetail[payload[1] & 0xF];
+          currentStatus.errorCode[0] = S21errorCodeDivision[payload[1] >> 4];
+          currentStatus.errorCode[1] = S21errorCodeDetail[payload[1] & 0xF];
+          currentStatus.errorCode[2] = '\0';
         }else{
-          currentStatus.errorCode = "";
+          currentStatus.errorCode[0] = '\0';
         }
 
         return true;
@@ -367,7 +404,7 @@ bool DaikinController::parseResponse(ACResponse *response)
         if (payloadSize == 1)
         {
           this->currentSettings.fan = lookupByteMapValue(S21_FAN_MAP, S21_FAN, 7, payload[0]);
-          Log.ln(TAG, "New fan speed found " + String(this->currentSettings.fan));
+          Log.ln(TAG, "New fan speed found %s", this->currentSettings.fan);
           use_RG_fan = true;
           return true;
         }
@@ -396,13 +433,12 @@ bool DaikinController::parseResponse(ACResponse *response)
     // HVAC Name
     if (cmd == 0xBA && payloadSize >= 20)
     {
-      char model[256];
       uint8_t modelLen = 0;
-      for (int i = 0; i < payloadSize; i++)
+      for (int i = 0; i < payloadSize && modelLen < sizeof(currentStatus.modelName) - 1; i++)
       {
         if (isalnum(payload[i]))
         {
-          model[i] = payload[i];
+          this->currentStatus.modelName[modelLen] = payload[i];
           modelLen++;
         }
         else
@@ -410,7 +446,7 @@ bool DaikinController::parseResponse(ACResponse *response)
           break;
         }
       }
-      this->currentStatus.modelName = String(model, modelLen);
+      this->currentStatus.modelName[modelLen] = '\0';
       return true;
     }
     // Main Status
@@ -427,15 +463,13 @@ bool DaikinController::parseResponse(ACResponse *response)
 
       // Has an error
       if (payload[14]){
-          this->currentStatus.errorCode = "";
-          this->currentStatus.errorCode += X50errorCodeDivision[payload[12] >> 4];
-          this->currentStatus.errorCode += X50errorCodeDetail[payload[12] & 0xF];
           if (payload[13]){
-            this->currentStatus.errorCode += "-";
-            this->currentStatus.errorCode += String(payload[13] >> 2);
+            snprintf(this->currentStatus.errorCode, sizeof(currentStatus.errorCode), "%c%c-%d", X50errorCodeDivision[payload[12] >> 4], X50errorCodeDetail[payload[12] & 0xF], payload[13] >> 2);
+          }else{
+            snprintf(this->currentStatus.errorCode, sizeof(currentStatus.errorCode), "%c%c", X50errorCodeDivision[payload[12] >> 4], X50errorCodeDetail[payload[12] & 0xF]);
           }
       }else{
-          this->currentStatus.errorCode = "";
+          this->currentStatus.errorCode[0] = '\0';
       }
 
       newSettings = currentSettings;
@@ -539,24 +573,24 @@ bool DaikinController::parseResponse(ACResponse *response)
 
 bool DaikinController::readState()
 {
-  Log.ln(TAG, "** AC Status *****************************");
-  if (!this->currentStatus.modelName.isEmpty())
-    Log.ln(TAG, "\tModel: " + this->currentStatus.modelName);
-  Log.ln(TAG, "\tPower: " + String(this->currentSettings.power));
-  Log.ln(TAG, "\tMode: " + String(this->currentSettings.mode) + "(" + String(this->currentStatus.operating ? "active" : "idle") + ")");
+  LOGD(TAG, "** AC Status *****************************");
+  if (this->currentStatus.modelName[0] != '\0')
+    LOGD(TAG, "\tModel: %s", this->currentStatus.modelName);
+  LOGD(TAG, "\tPower: %s", this->currentSettings.power);
+  LOGD(TAG, "\tMode: %s(%s)", this->currentSettings.mode, this->currentStatus.operating ? "active" : "idle");
   float degc = this->currentSettings.temperature;
   float degf = degc * 1.8 + 32.0;
-  Log.ln(TAG, "\tTarget: " + String(degc, 1));
-  Log.ln(TAG, "\tFan: " + String(this->currentSettings.fan) + " RPM:" + String(this->currentStatus.fanRPM));
-  Log.ln(TAG, "\tSwing: H:" + String(this->currentSettings.horizontalVane) + " V:" + String(currentSettings.verticalVane));
-  Log.ln(TAG, "\tInside: " + String(this->currentStatus.roomTemperature, 1));
-  Log.ln(TAG, "\tOutside: " + String(this->currentStatus.outsideTemperature, 1));
-  Log.ln(TAG, "\tCoil: " + String(this->currentStatus.coilTemperature, 1));
-  Log.ln(TAG, "\tCompressor Freq: " + String(this->currentStatus.compressorFrequency) + " Hz");
-  Log.ln(TAG, "\tEnergy Meter: " + String(this->currentStatus.energyMeter) + " kWh");
-  Log.ln(TAG, "\tError Code: " + this->currentStatus.errorCode );
-
-  Log.ln(TAG, "******************************************\n");
+  LOGD(TAG, "\tTarget: %.1f", degc);
+  LOGD(TAG, "\tFan: %s RPM:%d", this->currentSettings.fan, this->currentStatus.fanRPM);
+  LOGD(TAG, "\tSwing: H:%s V:%s", this->currentSettings.horizontalVane, currentSettings.verticalVane);
+  LOGD(TAG, "\tInside: %.1f", this->currentStatus.roomTemperature);
+  LOGD(TAG, "\tOutside: %.1f", this->currentStatus.outsideTemperature);
+  LOGD(TAG, "\tCoil: %.1f", this->currentStatus.coilTemperature);
+  LOGD(TAG, "\tCompressor Freq: %d Hz", this->currentStatus.compressorFrequency);
+  LOGD(TAG, "\tEnergy Meter: %.2f kWh", this->currentStatus.energyMeter);
+  LOGD(TAG, "\tError Code: %s", this->currentStatus.errorCode);
+
+  LOGD(TAG, "******************************************\n");
 
   return true;
 }
@@ -592,7 +626,7 @@ bool DaikinController::update(bool updateAll)
 
   if (!daikinUART->isConnected())
   {
-    Log.ln(TAG, "AC is not connected!");
+    LOGW(TAG, "AC is not connected!");
     return false;
   }
 
@@ -899,6 +933,40 @@ void DaikinController::setHorizontalVaneSetting(const char *setting)
   }
 }
 
+static bool inValuesMap(const char *valuesMap[], int len, const char *value)
+{
+  for (int i = 0; i < len; i++)
+  {
+    if (strcasecmp(valuesMap[i], value) == 0)
+      return true;
+  }
+  return false;
+}
+
+bool DaikinController::isFanSpeed(uint8_t protocol, const char *setting)
+{
+  if (protocol == PROTOCOL_S21)
+    return inValuesMap(S21_FAN_MAP, 7, setting);
+  if (protocol == PROTOCOL_X50)
+    return inValuesMap(X50_FAN_MAP, 7, setting);
+  return false;
+}
+
+bool DaikinController::isVerticalVaneSetting(uint8_t protocol, const char *setting)
+{
+  if (protocol == PROTOCOL_S21)
+    return inValuesMap(VERTICALVANE_MAP, 2, setting);
+  if (protocol == PROTOCOL_X50)
+    return inValuesMap(X50_VERTICALVANE_MAP, 6, setting);
+  return false;
+}
+
+bool DaikinController::isHorizontalVaneSetting(uint8_t protocol, const char *setting)
+{
+  // X50 units have no horizontal vane
+  return protocol == PROTOCOL_S21 && inValuesMap(HORIZONTALVANE_MAP, 2, setting);
+}
+
 void DaikinController::setSettingsChangedCallback(SETTINGS_CHANGED_CALLBACK_SIGNATURE)
 {
   this->settingsChangedCallback = settingsChangedCallback;
@@ -911,5 +979,5 @@ void DaikinController::setStatusChangedCallback(STATUS_CHANGED_CALLBACK_SIGNATUR
 
 String DaikinController::getModelName()
 {
-  return this->currentStatus.modelName;
+  return String(this->currentStatus.modelName);
 }
\ No newline at end of file
@@ -33,6 +33,7 @@
 #define S21_RESPONSE_TIMEOUT 250
 
 #define SYNC_INTEVAL 10000
+#define SYNC_LINE_GUARD_MS 100 // quiet line around a sync cycle
 
 #define S21_BAUD_RATE 2400
 #define S21_STOP_BITS 2
@@ -80,8 +81,8 @@ struct HVACStatus
   int fanRPM;
   bool operating; // if true, the heatpump is operating to reach the desired temperature
   int compressorFrequency;
-  String modelName;
-  String errorCode;
+  char modelName[32];
+  char errorCode[8];
 };
 
 const char X50errorCodeDivision[] = { ' ', 'A', 'C', 'E', 'H', 'F', 'J', 'L', 'P', 'U', 'M', '6', '8', '9', ' ',' '};
@@ -90,6 +91,16 @@ const char X50errorCodeDetail[] = {'0', '1', '2', '3', '4', '5', '6', '7', '8',
 const char S21errorCodeDivision[] = {' ', ' ', ' ', 'A', 'C', 'E', 'H', 'F', 'J', 'L', 'P', 'U', 'M', '6', '8', '9'};
 const char S21errorCodeDetail[] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'H', 'C', 'J', 'E', 'F'};
 
+// What a sync step did, see DaikinController::syncStep
+enum SyncResult
+{
+  SYNC_WAIT,   // the next cycle is not due yet
+  SYNC_BUSY,   // one query exchanged, more to go
+  SYNC_GUARD,  // keeping the line quiet, the next step is due SYNC_LINE_GUARD_MS from now
+  SYNC_DONE,   // cycle finished
+  SYNC_FAILED, // cycle finished, queries went unanswered
+};
+
 #define SETTINGS_CHANGED_CALLBACK_SIGNATURE std::function<void()> settingsChangedCallback
 #define STATUS_CHANGED_CALLBACK_SIGNATURE std::function<void(HVACStatus newStatus)> statusChangedCallback
 
@@ -99,7 +110,11 @@ class DaikinController
 public:
   DaikinController();
   bool connect(HardwareSerial *serial);
-  bool sync();   // Synchronize AC State to local state
+  bool sync();   // Synchronize AC State to local state, a whole cycle at once
+  // Same one query exchange per call, so the caller can do other work between the exchanges of a cycle.
+  // A cycle starts SYNC_INTEVAL after the previous one ended.
+  SyncResult syncStep();
+  uint32_t msUntilSync(); // until syncStep has something to do, 0 in the middle of a cycle
   bool update(bool updateAll = false); // Update local settings to AC.
 
   DaikinUART *daikinUART{nullptr};
@@ -121,6 +136,10 @@ public:
   void setVerticalVaneSetting(const char *setting);
   const char *getHorizontalVaneSetting();
   void setHorizontalVaneSetting(const char *setting);
+  // Whether the setters above know a value, so a command can be checked before any of it is applied
+  static bool isFanSpeed(uint8_t protocol, const char *setting);
+  static bool isVerticalVaneSetting(uint8_t protocol, const char *setting);
+  static bool isHorizontalVaneSetting(uint8_t protocol, const char *setting);
   String getModelName();
 
   // Converter
@@ -130,6 +149,7 @@ public:
   // status
   HVACStatus getStatus() { return this->currentStatus; };
   HVACSettings getSettings() { return currentSettings; };
+  HVACSettings getPendingSettings() { return newSettings; }; // Settings that the next update() will send
   float getRoomTemperature() { return this->currentStatus.roomTemperature; };
   bool isConnected() { return daikinUART->isConnected(); };
   // bool is_power_on() { return this->power_on; }
@@ -158,6 +178,9 @@ private:
   PendingSettings pendingSettings = {false, false};
 
   unsigned long lastSyncMs = 0;
+  uint8_t syncIndex = 0; // next query of the cycle in progress, 0 between cycles
+  bool syncSuccess = true;
+  bool lineGuarded = false; // the quiet line before the step now due has been waited out
   bool use_RG_fan = false;
 
   SETTINGS_CHANGED_CALLBACK_SIGNATURE{nullptr};
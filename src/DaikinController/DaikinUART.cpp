@@ -18,25 +18,13 @@
 
 
 #include "DaikinUART.h"
+#include "metrics.h"
+#include "reset_report.h"
 
 #define TAG "DKUART"
 
 
 
-String getHEXformatted(uint8_t *bytes, size_t len)
-{
-  String res;
-  char buf[5];
-  for (size_t i = 0; i < len; i++)
-  {
-    if (i > 0)
-      res += ':';
-    sprintf(buf, "%02X", bytes[i]);
-    res += buf;
-  }
-  return res;
-}
-
 //------------------ DakinUART Class functions -----------------
 
 void DaikinUART::setSerial(HardwareSerial *hardwareSerial)
@@ -113,11 +101,11 @@ bool DaikinUART::checkX50ready(){
     uint8_t payloadSize = lastResponse.dataSize;
 
     if (payloadSize == 1 &&  lastResponse.data[0] == 0x01 ){
-      Log.ln(TAG,String("X50 ready"));
+      Log.ln(TAG, "X50 ready");
       return true;
     }
     else{
-      Log.ln(TAG,String("X50 NOT ready"));
+      Log.ln(TAG, "X50 NOT ready");
       return false;
     }
 }
@@ -179,7 +167,13 @@ bool DaikinUART::sendCommandX50(uint8_t cmd, uint8_t *payload, uint8_t payloadLe
   len = 6 + payloadLen;
 
   // Send payload
-  Log.ln(TAG,String("X50 >> " + getHEXformatted(buf, len)));
+  LOGT(TAG, "X50 >> %H", buf, (int)len);
+  char cmdName[4];
+  snprintf(cmdName, sizeof(cmdName), "%02X", cmd);
+  resetReport.uartCommand(cmdName);
+  unsigned long tTx = micros();
+  if (!firstTxMicros)
+    firstTxMicros = tTx;
   _serial->write(buf, len);
 
   if (!waitResponse)
@@ -188,11 +182,13 @@ bool DaikinUART::sendCommandX50(uint8_t cmd, uint8_t *payload, uint8_t payloadLe
   // Read incoming payload
   uint8_t buf_in[256];
   uint8_t size_in = _serial->readBytes(buf_in, 255);
+  lastRxMicros = micros();
 
 
 
-  Log.ln(TAG, String("X50 << " + getHEXformatted(buf_in, size_in)));
+  LOGT(TAG, "X50 << %H", buf_in, (int)size_in);
   bool responseOK = checkResponseX50(cmd, buf_in, size_in);
+  metrics.uartExchange(cmdName, lastRxMicros - tTx, responseOK, size_in == 0);
 
 
   if (responseOK){
@@ -229,7 +225,12 @@ bool DaikinUART::sendCommandS21(uint8_t cmd1, uint8_t cmd2, uint8_t *payload, ui
   len = S21_MIN_PKT_LEN + payloadLen;
 
   // Send payload
-  Log.ln(TAG,String("S21 >> " + getHEXformatted(buf, len)));
+  LOGT(TAG, "S21 >> %H", buf, (int)len);
+  char cmdName[3] = {(char)cmd1, (char)cmd2, '\0'};
+  resetReport.uartCommand(cmdName);
+  unsigned long tTx = micros();
+  if (!firstTxMicros)
+    firstTxMicros = tTx;
   _serial->write(buf, len);
 
   if (!waitResponse)
@@ -242,6 +243,7 @@ bool DaikinUART::sendCommandS21(uint8_t cmd1, uint8_t cmd2, uint8_t *payload, ui
 
   unsigned long tStart = millis();
   bool isSetCMD = isS21SetCmd(cmd1,cmd2);
+  bool timedOut = false;
   while(1){
     if (_serial->available() > 0) {
       int c = _serial->read();
@@ -257,13 +259,16 @@ bool DaikinUART::sendCommandS21(uint8_t cmd1, uint8_t cmd2, uint8_t *payload, ui
       }
     }
     if(millis() - tStart > SERIAL_TIMEOUT){
-      Log.ln(TAG,"Serial read timedout");
+      LOGW(TAG, "Serial read timedout");
+      timedOut = true;
       break;
     }
   }
 
-  Log.ln(TAG,String("S21 << " + getHEXformatted(buf_in, size_in)));
+  lastRxMicros = micros();
+  LOGT(TAG, "S21 << %H", buf_in, (int)size_in);
   bool responseOK = (checkResponseS21(cmd1, cmd2, buf_in, size_in) == S21_OK);
+  metrics.uartExchange(cmdName, lastRxMicros - tTx, responseOK, timedOut && size_in == 0);
   // LOGD_f(TAG,"Response %s\n", responseOK ? "YES" : "NO");
 
   if (responseOK){
@@ -276,12 +281,96 @@ bool DaikinUART::sendCommandS21(uint8_t cmd1, uint8_t cmd2, uint8_t *payload, ui
   return responseOK;
 }
 
+uint8_t DaikinUART::requestFrameLength(uint8_t protocol, const uint8_t *buf, uint8_t len)
+{
+  if (protocol == PROTOCOL_S21)
+  {
+    // [STX, CMD1, CMD2, <DATA>, CRC, ETX]
+    if (len < S21_MIN_PKT_LEN || buf[0] != STX)
+      return 0;
+    for (uint8_t i = S21_MIN_PKT_LEN - 1; i < len; i++)
+    {
+      if (buf[i] == ETX)
+        return i + 1;
+    }
+  }
+  else if (protocol == PROTOCOL_X50)
+  {
+    // [0x06, CMD, total length, 1, 0, <DATA>, CRC]
+    if (len < 6 || buf[0] != 0x06 || buf[2] < 6 || buf[2] > len)
+      return 0;
+    return buf[2];
+  }
+  return 0;
+}
+
+uint8_t DaikinUART::exchangeRaw(const uint8_t *frame, uint8_t len, uint8_t *response, uint8_t responseSize, bool &truncated)
+{
+  // Drop leftovers so the response is not mixed with a previous exchange.
+  while (_serial->available() > 0)
+    _serial->read();
+
+  LOGT(TAG, "RAW >> %H", frame, (int)len);
+  resetReport.uartCommand("raw");
+  unsigned long tTx = micros();
+  _serial->write(frame, len);
+
+  bool isSetCMD = protocol == PROTOCOL_S21 && len >= 3 && isS21SetCmd(frame[1], frame[2]);
+  uint8_t size = 0;
+  uint16_t received = 0;
+  uint8_t expected = 0;
+  unsigned long tStart = millis();
+  while (millis() - tStart <= SERIAL_TIMEOUT)
+  {
+    if (_serial->available() <= 0)
+    {
+      // A byte takes about 4 ms at 2400 baud, leave the core to the other tasks meanwhile
+      vTaskDelay(1);
+      continue;
+    }
+    int c = _serial->read();
+    if (c == -1)
+      break;
+    // Past the end of the buffer the frame is still read to its end, so S21 queries get their ACK
+    received++;
+    if (size < responseSize)
+      response[size++] = c;
+
+    if (protocol == PROTOCOL_S21)
+    {
+      // A set command is only acknowledged, a query answers [ACK, STX, ..., ETX] that we confirm like the poller does.
+      if (c == NAK || (c == ACK && received == 1 && isSetCMD))
+        break;
+      if (c == ETX && received > 1)
+      {
+        _serial->write(ACK);
+        break;
+      }
+    }
+    else if (protocol == PROTOCOL_X50)
+    {
+      // Third byte is the frame length
+      if (received == 3)
+        expected = c;
+      if (expected && received >= expected)
+        break;
+    }
+  }
+  lastRxMicros = micros();
+  truncated = received > size;
+
+  LOGT(TAG, "RAW << %H", response, (int)size);
+  // The answer is not checked here, only timeouts count against raw exchanges
+  metrics.uartExchange("raw", lastRxMicros - tTx, true, size == 0);
+  return size;
+}
+
 // Check integrety of the new protocol
 bool DaikinUART::checkResponseX50(uint8_t cmd, uint8_t *buf, uint8_t size)
 {
   if (size <= 0)
   {
-    Log.ln(TAG,"checkResponseX50: Empty Response");
+    LOGW(TAG, "checkResponseX50: Empty Response");
     return false;
   }
 
@@ -294,31 +383,31 @@ bool DaikinUART::checkResponseX50(uint8_t cmd, uint8_t *buf, uint8_t size)
   }
   if (checksum != 0xFF)
   {
-    Log.ln(TAG,"checkResponseX50: Bad Checksum");
+    LOGW(TAG, "checkResponseX50: Bad Checksum");
     return false;
   }
 
   // Process response
   if (buf[1] == 0xFF)
   {
-    Log.ln(TAG,"checkResponseX50: Wrong byte 1");
+    LOGW(TAG, "checkResponseX50: Wrong byte 1");
     return false;
   }
   if (size < 6 || buf[0] != 0x06 || buf[1] != cmd || buf[2] != size || buf[3] != 1)
   { // Basic checks
     if (buf[0] != 0x06)
-      Log.ln(TAG,"checkResponseX50: Bad Header");
+      LOGW(TAG, "checkResponseX50: Bad Header");
     if (buf[1] != cmd)
-      Log.ln(TAG,"checkResponseX50: Received response mismatch sent command");
+      LOGW(TAG, "checkResponseX50: Received response mismatch sent command");
     if (buf[2] != size || size < 6)
-      Log.ln(TAG,"checkResponseX50: Bad size");
+      LOGW(TAG, "checkResponseX50: Bad size");
     if (buf[3] != 1)
-      Log.ln(TAG,"checkResponseX50: Bad form");
+      LOGW(TAG, "checkResponseX50: Bad form");
     return false;
   }
   if (!buf[4]) // Loopback
   {
-    Log.ln(TAG,"checkResponseX50: Loopback Detected");
+    LOGW(TAG, "checkResponseX50: Loopback Detected");
     return false;
   }
 
@@ -336,7 +425,7 @@ int DaikinUART::checkResponseS21(uint8_t cmd1, uint8_t cmd2, uint8_t *buf, uint8
 
   if (size <= 0)
   {
-    Log.ln(TAG,"checkResponseS21: Empty response");
+    LOGW(TAG, "checkResponseS21: Empty response");
     connected = false;
     return S21_BAD;
   }
@@ -347,12 +436,12 @@ int DaikinUART::checkResponseS21(uint8_t cmd1, uint8_t cmd2, uint8_t *buf, uint8
     if (buf[idx] == NAK)
     {
       // Got an explicit NAK
-      Log.ln(TAG,"checkResponseS21: Got explicted NAK");
+      LOGW(TAG, "checkResponseS21: Got explicted NAK");
       connected = true;   //HVAC is connected but does not understand the command
       return S21_NAK;
     }
 
-    Log.ln(TAG,"checkResponseS21: Got unexpected data, protocol broken.");
+    LOGW(TAG, "checkResponseS21: Got unexpected data, protocol broken.");
     connected = false;
     return S21_NOACK;
   }
@@ -378,7 +467,7 @@ int DaikinUART::checkResponseS21(uint8_t cmd1, uint8_t cmd2, uint8_t *buf, uint8
     if (!foundSTX)
     {
       connected = false;
-      Log.ln(TAG,"checkResponseS21: Got no STX");
+      LOGW(TAG, "checkResponseS21: Got no STX");
       return S21_NOACK;
     }
   }
@@ -400,7 +489,7 @@ int DaikinUART::checkResponseS21(uint8_t cmd1, uint8_t cmd2, uint8_t *buf, uint8
   if (!foundETX)
   {
     connected = false;
-    Log.ln(TAG,"checkResponseS21: Got no ETX");
+    LOGW(TAG, "checkResponseS21: Got no ETX");
     return S21_NOACK;
   }
   // Send confirm receive to AC
@@ -412,7 +501,7 @@ int DaikinUART::checkResponseS21(uint8_t cmd1, uint8_t cmd2, uint8_t *buf, uint8
   {
 
     connected = false;
-    Log.ln(TAG,"checkResponseS21: Checksum Error");
+    LOGW(TAG, "checkResponseS21: Checksum Error");
     return S21_BAD;
 
   }
@@ -422,7 +511,7 @@ int DaikinUART::checkResponseS21(uint8_t cmd1, uint8_t cmd2, uint8_t *buf, uint8
   if (size < S21_MIN_PKT_LEN + 1 || buf[S21_STX_OFFSET + 1] != STX || buf[size - 1] != ETX || buf[S21_CMD1_OFFSET+1] != cmd1 + 1 || buf[S21_CMD2_OFFSET+1] != cmd2)
   {
     connected = false;
-    Log.ln(TAG,"checkResponseS21: Message Malformed");
+    LOGW(TAG, "checkResponseS21: Message Malformed");
     return S21_BAD;
   }
 
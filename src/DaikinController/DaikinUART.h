@@ -108,15 +108,30 @@ public:
   bool sendCommandS21(uint8_t cmd1, uint8_t cmd2);
   bool sendCommandS21(uint8_t cmd1, uint8_t cmd_2, uint8_t *payload, uint8_t payloadLen, bool waitResponse = true);
   ACResponse getResponse();
+
+  // Raw passthrough. requestFrameLength returns the length of the complete request frame at the start of buf
+  // for the given protocol (0 if there is none), it does not touch the UART so any task may call it.
+  // exchangeRaw writes one frame as is and reads back exactly one response frame. Returns the response length,
+  // truncated is set when the frame did not fit in response (the rest is read and dropped).
+  static uint8_t requestFrameLength(uint8_t protocol, const uint8_t *buf, uint8_t len);
+  uint8_t exchangeRaw(const uint8_t *frame, uint8_t len, uint8_t *response, uint8_t responseSize, bool &truncated);
   bool isConnected(){return this->connected;};
   uint8_t currentProtocol(){return this->protocol;};
 
+  // Wire timing in micros(), used for command latency reporting.
+  // The first write is kept until markTiming() so a multi frame update reports when it started.
+  void markTiming(){this->firstTxMicros = 0;};
+  unsigned long getFirstTxMicros(){return this->firstTxMicros;};
+  unsigned long getLastRxMicros(){return this->lastRxMicros;};
+
 private:
 
   HardwareSerial *_serial;
   bool connected = false;
   uint8_t protocol = PROTOCOL_UNKNOWN;
   ACResponse lastResponse;
+  unsigned long firstTxMicros = 0;
+  unsigned long lastRxMicros = 0;
   
   bool testX50Protocol();
   bool testS21Protocol();
@@ -0,0 +1,687 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "benchmark.h"
+
+#ifdef DK2MQTT_BENCHMARK
+
+#include <ArduinoJson.h>
+#include <WiFi.h>
+#include <PubSubClient.h>
+#include "DaikinController/DaikinController.h"
+#include "state_encoder.h"
+#include "state_snapshot.h"
+#include "scheduler.h"
+#include "power_save.h"
+#include "logger.h"
+// Page arrays have internal linkage, benchmark builds carry a second copy of them for the template tables.
+#include "html_common.h"
+#include "html_init.h"
+#include "html_menu.h"
+#include "html_pages.h"
+#include "html_templates.h"
+
+// Defined in main.cpp
+void commonPageField(uint8_t field, HtmlWriter &out);
+void renderControlPage(HtmlWriter &response);
+std::function<void(uint8_t field, HtmlWriter &out)> controlPageResolver();
+unsigned long benchmarkCommandRoundTrip(const char *id, uint32_t timeoutMs);
+void setPowerSave(bool on);
+uint32_t loopPass();
+extern StateSnapshot controllerSnapshot;
+extern Scheduler controllerScheduler;
+extern int hvacJob;
+extern int mqttState;
+extern String mqtt_server;
+extern String mqtt_port;
+extern String mqtt_username;
+extern String mqtt_password;
+extern String mqtt_client_id;
+extern String ha_command_topic;
+extern String ha_command_ack_topic;
+
+#define TAG "bench"
+
+#define BENCH_ITERATIONS 1000
+#define BENCH_HTTP_REQUESTS 50
+#define BENCH_HTTP_INTERVAL_MS 100
+#define BENCH_HTTP_TIMEOUT_MS 5000
+#define BENCH_COMMANDS 20
+#define BENCH_COMMAND_INTERVAL_MS 250
+#define BENCH_COMMAND_TIMEOUT_MS 2000
+#define BENCH_BROKER_PORT 18830
+#define BENCH_MQTT_CONNECT_TIMEOUT_MS 15000
+#define BENCH_IDLE_WINDOW_MS 30000
+
+static HVACState sampleState()
+{
+  HVACState state = {};
+  state.temperature = 25.5;
+  state.roomTemperature = 27;
+  state.outsideTemperature = 33.5;
+  state.coilTemperature = 12;
+  state.energyMeter = 1234.56;
+  state.fanRPM = 1120;
+  state.compressorFrequency = 42;
+  state.hasEnergyMeter = true;
+  state.mode = "cool";
+  state.action = "cooling";
+  strlcpy(state.fan, "AUTO", sizeof(state.fan));
+  strlcpy(state.vane, "SWING", sizeof(state.vane));
+  strlcpy(state.wideVane, "HOLD", sizeof(state.wideVane));
+  return state;
+}
+
+// The publish path as it was before StateEncoder: global document refilled with String values
+// (hpGetMode / hpGetAction returned String) and serialised into a fresh String.
+static StaticJsonDocument<JSON_OBJECT_SIZE(256)> legacyRootInfo;
+
+static String legacyStatePublish(const HVACState &state)
+{
+  legacyRootInfo.clear();
+  legacyRootInfo["outsideTemperature"] = state.outsideTemperature;
+  legacyRootInfo["internalCoilTemperature"] = state.coilTemperature;
+  legacyRootInfo["temperature"] = state.temperature;
+  legacyRootInfo["fan"] = state.fan;
+  legacyRootInfo["fanRPM"] = state.fanRPM;
+  legacyRootInfo["roomTemperature"] = state.roomTemperature;
+  legacyRootInfo["vane"] = state.vane;
+  legacyRootInfo["wideVane"] = state.wideVane;
+  legacyRootInfo["mode"] = String(state.mode);
+  legacyRootInfo["action"] = String(state.action);
+  legacyRootInfo["compressorFrequency"] = state.compressorFrequency;
+  legacyRootInfo["errorCode"] = String(state.errorCode);
+  legacyRootInfo["energyMeter"] = state.energyMeter;
+  String mqttOutput;
+  serializeJson(legacyRootInfo, mqttOutput);
+  return mqttOutput;
+}
+
+static void benchmarkStatePublish()
+{
+  HVACState state = sampleState();
+  static char buffer[STATE_JSON_SIZE];
+
+  // Heap held while the payload is alive, this is what the publish call has to work with.
+  uint32_t heapBefore = ESP.getFreeHeap();
+  String legacyOutput = legacyStatePublish(state);
+  uint32_t legacyBytes = heapBefore - ESP.getFreeHeap();
+  legacyOutput = String();
+
+  heapBefore = ESP.getFreeHeap();
+  size_t encodedLen = StateEncoder::encodeState(state, buffer, sizeof(buffer));
+  uint32_t encoderBytes = heapBefore - ESP.getFreeHeap();
+
+  unsigned long tStart = micros();
+  size_t legacyLen = 0;
+  for (int i = 0; i < BENCH_ITERATIONS; i++)
+  {
+    legacyLen = legacyStatePublish(state).length();
+  }
+  unsigned long legacyUs = micros() - tStart;
+
+  tStart = micros();
+  for (int i = 0; i < BENCH_ITERATIONS; i++)
+  {
+    encodedLen = StateEncoder::encodeState(state, buffer, sizeof(buffer));
+  }
+  unsigned long encoderUs = micros() - tStart;
+
+  // What an /events subscriber gets for a typical update, only the room temperature moved
+  HVACState next = state;
+  next.roomTemperature += 0.5;
+  size_t deltaLen = 0;
+  tStart = micros();
+  for (int i = 0; i < BENCH_ITERATIONS; i++)
+  {
+    deltaLen = StateEncoder::encodeDelta(state, next, buffer, sizeof(buffer));
+  }
+  unsigned long deltaUs = micros() - tStart;
+
+  Log.ln(TAG, "State publish, ArduinoJson+String: %u bytes heap, %.2f us/publish, %u bytes payload", legacyBytes, (float)legacyUs / BENCH_ITERATIONS, legacyLen);
+  Log.ln(TAG, "State publish, StateEncoder:       %u bytes heap, %.2f us/publish, %u bytes payload", encoderBytes, (float)encoderUs / BENCH_ITERATIONS, encodedLen);
+  Log.ln(TAG, "State event, delta of one field:   %.2f us/event, %u bytes payload", (float)deltaUs / BENCH_ITERATIONS, deltaLen);
+}
+
+// Legacy page rendering: copy the page from flash into a String and run one replace pass per
+// placeholder, resolving values the same way the template engine does.
+static String legacyRender(const HtmlTemplate &page, HTML_RESOLVER_SIGNATURE, uint32_t &minFreeHeap)
+{
+  String result = FPSTR(page.text);
+  bool replaced[HF_COUNT] = {false};
+  for (uint16_t i = 0; i < page.count; i++)
+  {
+    uint8_t field = page.segments[i].field;
+    if (field == HF_NONE || replaced[field])
+      continue;
+    replaced[field] = true;
+
+    String value;
+    HtmlWriter valueWriter([&value](const char *data, size_t len)
+                           { value.concat(data, len); });
+    resolver(field, valueWriter);
+    valueWriter.flush();
+    result.replace(html_field_names[field], value);
+    minFreeHeap = min(minFreeHeap, ESP.getFreeHeap());
+  }
+  return result;
+}
+
+struct PageStats
+{
+  uint32_t heapUsed;  // peak, bytes
+  unsigned long ttfb; // us until the first byte could be sent
+  unsigned long total; // us
+  size_t size;
+};
+
+static PageStats benchmarkLegacyPage(const HtmlTemplate &page, HTML_RESOLVER_SIGNATURE)
+{
+  uint32_t heapBefore = ESP.getFreeHeap();
+  uint32_t minFreeHeap = heapBefore;
+  unsigned long tStart = micros();
+  String header = legacyRender(html_common_header_template, commonPageField, minFreeHeap);
+  String content = legacyRender(page, resolver, minFreeHeap);
+  String footer = legacyRender(html_common_footer_template, commonPageField, minFreeHeap);
+  // sendWrappedHTML concatenated the three before sending
+  String toSend = header + content + footer;
+  minFreeHeap = min(minFreeHeap, ESP.getFreeHeap());
+  unsigned long ttfb = micros() - tStart;
+  return {heapBefore - minFreeHeap, ttfb, ttfb, toSend.length()};
+}
+
+static PageStats benchmarkTemplatePage(std::function<void(HtmlWriter &out)> render)
+{
+  uint32_t heapBefore = ESP.getFreeHeap();
+  uint32_t minFreeHeap = heapBefore;
+  unsigned long tStart = micros();
+  unsigned long ttfb = 0;
+  HtmlWriter out([&](const char *data, size_t len)
+                 {
+                   if (!ttfb)
+                     ttfb = micros() - tStart;
+                   minFreeHeap = min(minFreeHeap, ESP.getFreeHeap()); });
+  render(out);
+  out.flush();
+  unsigned long total = micros() - tStart;
+  return {heapBefore - minFreeHeap, ttfb, total, out.size()};
+}
+
+static void logPageStats(const char *name, const char *engine, const PageStats &stats)
+{
+  Log.ln(TAG, "Page %s, %s: %u bytes heap peak, TTFB %lu us, total %lu us, %u bytes", name, engine, stats.heapUsed, stats.ttfb, stats.total, stats.size);
+}
+
+static void benchmarkPages()
+{
+  // Writer buffers live on the stack, the heap figures only count String copies.
+  logPageStats("control", "String::replace", benchmarkLegacyPage(html_page_control_template, controlPageResolver()));
+  logPageStats("control", "template", benchmarkTemplatePage(renderControlPage));
+
+  auto noFields = [](uint8_t field, HtmlWriter &out) {};
+  logPageStats("reboot", "String::replace", benchmarkLegacyPage(html_page_reboot_template, noFields));
+  logPageStats("reboot", "template", benchmarkTemplatePage([&](HtmlWriter &out)
+                                                           {
+                                                             renderTemplate(out, html_common_header_template, commonPageField);
+                                                             renderTemplate(out, html_page_reboot_template, noFields);
+                                                             renderTemplate(out, html_common_footer_template, commonPageField); }));
+}
+
+// The log store as it was before the record ring: append at the end, and once nearly full move
+// everything down by 512 bytes, which happens again on almost every following line.
+static void legacyStoreLog(char *buffer, unsigned int &used, const char *line, size_t size)
+{
+  memcpy(buffer + used, line, size);
+  used += size;
+  if (used + 512 >= LOG_SIZE)
+  {
+    memmove(buffer, buffer + 512, used - 512);
+    used -= 512;
+  }
+}
+
+// Frame dump as DaikinUART built it before log records were binary.
+static String legacyHexLine(const uint8_t *bytes, size_t len)
+{
+  String res("S21 << ");
+  char buf[5];
+  for (size_t i = 0; i < len; i++)
+  {
+    if (i > 0)
+      res += ':';
+    sprintf(buf, "%02X", bytes[i]);
+    res += buf;
+  }
+  return res;
+}
+
+static void packRecord(LogRecord &record, uint8_t *args, size_t size, const char *format, ...)
+{
+  va_list list;
+  va_start(list, format);
+  int len = Logging::packArgs(format, list, args, size);
+  va_end(list);
+  record.format = format;
+  record.len = len < 0 ? 0 : len;
+}
+
+static void benchmarkLogStore()
+{
+  // A typical UART frame dump, logged as text the way call sites used to and as a binary record.
+  static const uint8_t frame[] = {0x02, 0x47, 0x31, 0x30, 0x30, 0x30, 0x41, 0x38, 0x03};
+  LogRecord record;
+  record.ms = millis();
+  record.tag = "DKUART";
+  record.format = nullptr;
+  record.len = 0;
+  record.newline = true;
+  uint8_t args[LOG_MESSAGE_MAX];
+  char line[LOG_RECORD_MAX];
+
+  unsigned long tStart = micros();
+  for (int i = 0; i < BENCH_ITERATIONS; i++)
+  {
+    String text = legacyHexLine(frame, sizeof(frame));
+    memcpy(args, text.c_str(), text.length());
+  }
+  unsigned long textUs = micros() - tStart;
+
+  tStart = micros();
+  for (int i = 0; i < BENCH_ITERATIONS; i++)
+    packRecord(record, args, sizeof(args), "S21 << %H", frame, (int)sizeof(frame));
+  unsigned long packUs = micros() - tStart;
+  const size_t recordSize = sizeof(LogRecord) + record.len;
+
+  size_t lineLen = 0;
+  tStart = micros();
+  for (int i = 0; i < BENCH_ITERATIONS; i++)
+    lineLen = Logging::formatRecord(record, args, line, sizeof(line));
+  unsigned long formatUs = micros() - tStart;
+
+  // Both stores are filled first, the cost that matters is once rotating.
+  char *legacyBuffer = (char *)malloc(LOG_SIZE);
+  unsigned long legacyUs = 0;
+  if (legacyBuffer != nullptr)
+  {
+    unsigned int used = 0;
+    for (size_t i = 0; i < 2 * LOG_SIZE / lineLen; i++)
+      legacyStoreLog(legacyBuffer, used, line, lineLen);
+    tStart = micros();
+    for (int i = 0; i < BENCH_ITERATIONS; i++)
+      legacyStoreLog(legacyBuffer, used, line, lineLen);
+    legacyUs = micros() - tStart;
+    free(legacyBuffer);
+  }
+
+  // Goes into the real log, the boot messages before the benchmarks are rotated out
+  for (size_t i = 0; i < 2 * LOG_SIZE / recordSize; i++)
+    Log.storeRecord(record, args);
+  tStart = micros();
+  for (int i = 0; i < BENCH_ITERATIONS; i++)
+    Log.storeRecord(record, args);
+  unsigned long ringUs = micros() - tStart;
+
+  Log.ln(TAG, "Log call site, String text:   %.2f us/line, %u bytes/line stored", (float)textUs / BENCH_ITERATIONS, (unsigned)lineLen);
+  Log.ln(TAG, "Log call site, binary record: %.2f us/line, %u bytes/line stored", (float)packUs / BENCH_ITERATIONS, (unsigned)recordSize);
+  Log.ln(TAG, "Log format on read:           %.2f us/line", (float)formatUs / BENCH_ITERATIONS);
+  Log.ln(TAG, "Log store, memmove rotation:  %.2f us/line", (float)legacyUs / BENCH_ITERATIONS);
+  Log.ln(TAG, "Log store, record ring:       %.2f us/line", (float)ringUs / BENCH_ITERATIONS);
+}
+
+struct HttpLatency
+{
+  uint32_t requests;
+  uint32_t failed;
+  unsigned long totalUs; // time to first byte, summed
+  unsigned long maxUs;
+  uint32_t notModified; // 304 answers to If-None-Match
+  volatile bool done;
+};
+
+// Polls /api/acstatus like the status page does, from a task of its own so the requests really
+// overlap with whatever the caller is doing.
+static void httpLatencyClient(void *parameter)
+{
+  HttpLatency *stats = (HttpLatency *)parameter;
+  String etag;
+  for (int i = 0; i < BENCH_HTTP_REQUESTS; i++)
+  {
+    WiFiClient client;
+    unsigned long tStart = micros();
+    if (!client.connect(WiFi.localIP(), 80))
+    {
+      stats->failed++;
+      continue;
+    }
+    // Revalidate like a browser does once it has the first answer
+    client.print("GET /api/acstatus HTTP/1.1\r\nConnection: close\r\n");
+    if (etag.length())
+      client.print("If-None-Match: " + etag + "\r\n");
+    client.print("\r\n");
+    while (client.connected() && !client.available() && micros() - tStart < BENCH_HTTP_TIMEOUT_MS * 1000UL)
+      vTaskDelay(1);
+    unsigned long latency = micros() - tStart;
+    if (!client.available())
+    {
+      stats->failed++;
+    }
+    else
+    {
+      stats->requests++;
+      stats->totalUs += latency;
+      stats->maxUs = max(stats->maxUs, latency);
+      String line = client.readStringUntil('\n');
+      if (line.startsWith("HTTP/1.1 304"))
+        stats->notModified++;
+      while (line.length() > 1)
+      {
+        line = client.readStringUntil('\n');
+        if (line.startsWith("ETag: "))
+          etag = line.substring(6, line.length() - 1);
+      }
+    }
+    client.stop();
+    vTaskDelay(pdMS_TO_TICKS(BENCH_HTTP_INTERVAL_MS));
+  }
+  stats->done = true;
+  vTaskDelete(NULL);
+}
+
+static void runHttpLatency(HttpLatency &stats)
+{
+  stats = {};
+  xTaskCreatePinnedToCore(httpLatencyClient, "benchHttp", 4096, &stats, 1, NULL, 0);
+  while (!stats.done)
+    delay(50);
+}
+
+static void benchmarkHttpLatency()
+{
+  if (WiFi.getMode() != WIFI_STA || WiFi.status() != WL_CONNECTED)
+  {
+    Log.ln(TAG, "HTTP latency: skipped, no station connection");
+    return;
+  }
+
+  // The controller task keeps polling the unit on its own core meanwhile. Before the web task the
+  // worst case page latency was a whole sync, requests were only served between two.
+  HttpLatency stats;
+  SchedulerJob before = controllerScheduler.job(hvacJob);
+  runHttpLatency(stats);
+  SchedulerJob after = controllerScheduler.job(hvacJob);
+
+  uint32_t steps = after.runs - before.runs;
+  Log.ln(TAG, "HTTP latency under polling: %u requests (%u failed, %u not modified), TTFB avg %lu us, max %lu us",
+         stats.requests, stats.failed, stats.notModified, stats.requests ? stats.totalUs / stats.requests : 0, stats.maxUs);
+  Log.ln(TAG, "Concurrent sync steps: %u runs, avg %lu us, max since boot %u us",
+         steps, steps ? (unsigned long)((after.totalUs - before.totalUs) / steps) : 0, after.maxUs);
+}
+
+struct BrokerLoad
+{
+  uint32_t messages;
+  uint32_t bytes;
+  volatile bool stop;
+  volatile uint8_t running; // tasks still up
+};
+
+// Stand-in for the broker: swallows whatever the publisher sends as fast as lwIP hands it over.
+static void brokerSink(void *parameter)
+{
+  BrokerLoad *load = (BrokerLoad *)parameter;
+  WiFiServer server(BENCH_BROKER_PORT);
+  server.begin();
+  WiFiClient client;
+  uint8_t buffer[512];
+  while (!load->stop)
+  {
+    if (!client.connected())
+    {
+      client = server.available();
+      vTaskDelay(1);
+      continue;
+    }
+    int len = client.read(buffer, sizeof(buffer));
+    if (len > 0)
+      load->bytes += len;
+    else
+      vTaskDelay(1);
+  }
+  client.stop();
+  server.end();
+  load->running--;
+  vTaskDelete(NULL);
+}
+
+// Publishes state documents back to back, encoding included, like a flood of MQTT traffic would.
+static void brokerPublisher(void *parameter)
+{
+  BrokerLoad *load = (BrokerLoad *)parameter;
+  HVACState state = sampleState();
+  char json[STATE_JSON_SIZE];
+  WiFiClient client;
+  while (!load->stop)
+  {
+    if (!client.connected() && !client.connect(WiFi.localIP(), BENCH_BROKER_PORT))
+    {
+      vTaskDelay(pdMS_TO_TICKS(10));
+      continue;
+    }
+    state.fanRPM++;
+    size_t len = StateEncoder::encodeState(state, json, sizeof(json));
+    client.write((const uint8_t *)json, len);
+    load->messages++;
+    taskYIELD();
+  }
+  client.stop();
+  load->running--;
+  vTaskDelete(NULL);
+}
+
+// Commands resent to the unit one after the other, each timed from the post to its ack.
+static void benchmarkCommandPhase(const char *benchmark, const char *phase)
+{
+  SchedulerJob before = controllerScheduler.job(hvacJob);
+  uint32_t acked = 0, failed = 0;
+  unsigned long totalUs = 0, maxUs = 0;
+  for (int i = 0; i < BENCH_COMMANDS; i++)
+  {
+    char id[24];
+    snprintf(id, sizeof(id), "bench-%s-%d", phase, i);
+    unsigned long us = benchmarkCommandRoundTrip(id, BENCH_COMMAND_TIMEOUT_MS);
+    if (us == 0)
+    {
+      failed++;
+      continue;
+    }
+    acked++;
+    totalUs += us;
+    maxUs = max(maxUs, us);
+    delay(BENCH_COMMAND_INTERVAL_MS);
+  }
+  SchedulerJob after = controllerScheduler.job(hvacJob);
+
+  uint32_t steps = after.runs - before.runs;
+  Log.ln(TAG, "%s, %s: %u commands acked (%u failed), post to ack avg %lu us, max %lu us",
+         benchmark, phase, acked, failed, acked ? totalUs / acked : 0, maxUs);
+  Log.ln(TAG, "%s, %s: %u sync steps, avg %lu us, %u overruns, latest start since boot %u ms",
+         benchmark, phase, steps, steps ? (unsigned long)((after.totalUs - before.totalUs) / steps) : 0,
+         after.overruns - before.overruns, after.maxLateMs);
+}
+
+// The controller task polling the unit and taking commands while the network core is flooded.
+// Run once quiet, then under load: with the UART on its own core the two should look alike.
+static void benchmarkDualCore()
+{
+  if (!controllerSnapshot.read().connected)
+  {
+    Log.ln(TAG, "Dual core: skipped, unit not connected");
+    return;
+  }
+  if (WiFi.getMode() != WIFI_STA || WiFi.status() != WL_CONNECTED)
+  {
+    Log.ln(TAG, "Dual core: skipped, no station connection");
+    return;
+  }
+
+  benchmarkCommandPhase("Dual core", "quiet");
+
+  BrokerLoad load = {};
+  load.running = 2;
+  xTaskCreatePinnedToCore(brokerSink, "benchSink", 4096, &load, 1, NULL, 0);
+  xTaskCreatePinnedToCore(brokerPublisher, "benchPub", 4096, &load, 1, NULL, 0);
+  unsigned long tStart = millis();
+  benchmarkCommandPhase("Dual core", "loaded");
+  unsigned long elapsed = millis() - tStart;
+  load.stop = true;
+  while (load.running)
+    delay(10);
+
+  Log.ln(TAG, "Dual core, loaded: %u messages, %u bytes through lwIP in %lu ms",
+         load.messages, load.bytes, elapsed);
+}
+
+// loop() as it runs once setup() has returned: the jobs at their intervals, asleep in between.
+static void runLoopFor(uint32_t windowMs)
+{
+  unsigned long tStart = millis();
+  while (millis() - tStart < windowMs)
+    vTaskDelay(max(pdMS_TO_TICKS(loopPass()), (TickType_t)1));
+}
+
+// Commands published to the command topic by a client of its own, each timed until its ack comes
+// back through the broker. The loop jobs are run here, so the command waits for the mqtt job at
+// whatever interval setPowerSave() gave it.
+static void benchmarkMqttCommandPhase(const char *phase)
+{
+  static int sequence = 0;
+  unsigned long tStart = millis();
+  while (mqttState != MQTT_CONNECTED && millis() - tStart < BENCH_MQTT_CONNECT_TIMEOUT_MS)
+    runLoopFor(10);
+
+  WiFiClient net;
+  PubSubClient client(net);
+  char clientId[48];
+  snprintf(clientId, sizeof(clientId), "%s-bench", mqtt_client_id.c_str());
+  char expected[64] = "";
+  const char *result = nullptr;
+  client.setServer(mqtt_server.c_str(), atoi(mqtt_port.c_str()));
+  client.setCallback([&](char *topic, uint8_t *payload, unsigned int length)
+                     {
+                       size_t len = strlen(expected);
+                       if (length <= len || memcmp(payload, expected, len) != 0)
+                         return;
+                       // Later results for the same id (confirmed, ...) are not what is timed
+                       if (length >= len + 4 && memcmp(payload + len, "ack\"", 4) == 0)
+                         result = "ack";
+                       else if (length >= len + 5 && memcmp(payload + len, "nack\"", 5) == 0)
+                         result = "nack"; });
+  if (mqttState != MQTT_CONNECTED || !client.connect(clientId, mqtt_username.c_str(), mqtt_password.c_str()) ||
+      !client.subscribe(ha_command_ack_topic.c_str()))
+  {
+    Log.ln(TAG, "Power save, %s: MQTT commands skipped, broker not reachable", phase);
+    return;
+  }
+
+  ControllerSnapshot snapshot = controllerSnapshot.read();
+  const char *power = snapshot.settings.power != nullptr ? snapshot.settings.power : "OFF";
+  uint32_t acked = 0, failed = 0;
+  unsigned long totalUs = 0, maxUs = 0;
+  for (int i = 0; i < BENCH_COMMANDS; i++)
+  {
+    char id[24], payload[96];
+    snprintf(id, sizeof(id), "bench-mqtt-%d", sequence++);
+    snprintf(expected, sizeof(expected), "{\"id\":\"%s\",\"result\":\"", id);
+    snprintf(payload, sizeof(payload), "{\"id\":\"%s\",\"power\":\"%s\"}", id, power);
+    result = nullptr;
+    unsigned long tPublish = micros();
+    client.publish(ha_command_topic.c_str(), payload);
+    unsigned long tWait = millis();
+    while (result == nullptr && millis() - tWait < BENCH_COMMAND_TIMEOUT_MS)
+    {
+      client.loop();
+      loopPass();
+      vTaskDelay(1);
+    }
+    unsigned long us = micros() - tPublish;
+    if (result == nullptr || strcmp(result, "ack") != 0)
+    {
+      failed++;
+      continue;
+    }
+    acked++;
+    totalUs += us;
+    maxUs = max(maxUs, us);
+    runLoopFor(BENCH_COMMAND_INTERVAL_MS);
+  }
+  client.disconnect();
+  Log.ln(TAG, "Power save, %s: %u MQTT commands acked (%u failed), publish to ack avg %lu us, max %lu us",
+         phase, acked, failed, acked ? totalUs / acked : 0, maxUs);
+}
+
+// Idle share while only polling, then command and page latency, with power save off and on. The
+// loop jobs run as they would after setup(), at the intervals setPowerSave() chose.
+static void benchmarkPowerPhase(const char *phase)
+{
+  powerSave.sample();
+  runLoopFor(BENCH_IDLE_WINDOW_MS);
+  powerSave.sample();
+  Log.ln(TAG, "Power save, %s: idle core 0 %.1f%%, core 1 %.1f%% over %u ms",
+         phase, powerSave.idlePercent(0), powerSave.idlePercent(1), BENCH_IDLE_WINDOW_MS);
+
+  if (controllerSnapshot.read().connected)
+  {
+    benchmarkCommandPhase("Power save", phase);
+    benchmarkMqttCommandPhase(phase);
+  }
+  if (WiFi.status() == WL_CONNECTED)
+  {
+    HttpLatency stats;
+    runHttpLatency(stats);
+    Log.ln(TAG, "Power save, %s: %u requests (%u failed), TTFB avg %lu us, max %lu us",
+           phase, stats.requests, stats.failed, stats.requests ? stats.totalUs / stats.requests : 0, stats.maxUs);
+  }
+}
+
+static void benchmarkPowerSave()
+{
+  if (WiFi.getMode() != WIFI_STA)
+  {
+    Log.ln(TAG, "Power save: skipped, not in station mode");
+    return;
+  }
+  bool configured = powerSave.enabled();
+  setPowerSave(false);
+  benchmarkPowerPhase("off");
+  setPowerSave(true);
+  benchmarkPowerPhase("modem sleep");
+  setPowerSave(configured);
+}
+
+void runBenchmarks()
+{
+  Log.ln(TAG, "---Benchmarks---");
+  benchmarkStatePublish();
+  benchmarkPages();
+  benchmarkLogStore();
+  benchmarkHttpLatency();
+  benchmarkDualCore();
+  benchmarkPowerSave();
+  Log.ln(TAG, "---Benchmarks completed---");
+}
+
+#endif
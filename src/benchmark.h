@@ -0,0 +1,26 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+// On-device benchmarks, build with -D DK2MQTT_BENCHMARK (see platformio.ini).
+// Results are written to the log once at the end of setup().
+#ifdef DK2MQTT_BENCHMARK
+
+void runBenchmarks();
+
+#endif
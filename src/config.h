@@ -67,7 +67,10 @@ const PROGMEM char* HA_alert = "mdi:alert-circle";
 //Define global variables for Others settings
 bool others_haa;
 bool others_avail_report;
+bool others_state_history;
+bool others_power_save;
 String others_haa_topic;
+String others_syslog; // "host" or "host:port" of the remote syslog server, empty for none
 
 // Define global variables for HA topics
 String ha_power_set_topic;
@@ -81,10 +84,14 @@ String ha_settings_topic;
 String ha_unit_settings_topic;
 
 String ha_state_topic;
+String ha_state_history_topic;
 String ha_debug_topic;
 String ha_serial_recv_topic;
+String ha_profile_topic;
 String ha_serial_send_topic;
 String ha_debug_set_topic;
+String ha_log_level_set_topic;
+String ha_reset_topic;
 String ha_climate_config_topic;
 String ha_sensor_room_temp_config_topic;
 String ha_sensor_outside_temp_config_topic;
@@ -101,9 +108,12 @@ String ha_switch_unit_beep_config_topic;
 String ha_discovery_topic;
 String ha_custom_packet_s21;
 String ha_custom_query_experimental;
+String ha_custom_query_experimental_response;
 String ha_availability_topic;
 String ha_switch_unit_led_set_topic;
 String ha_switch_unit_beep_set_topic;
+String ha_command_topic;
+String ha_command_ack_topic;
 String hvac_name;
 
 //login
@@ -119,6 +129,36 @@ const PROGMEM uint32_t SEND_ROOM_TEMP_INTERVAL_MS = 15000; // send MQTT every 15
 const PROGMEM uint32_t POLL_DELAY_AFTER_SET_MS = 25000; // After send command, wait at least 25 seconds for A/C to update status.
 const PROGMEM uint32_t MQTT_RETRY_INTERVAL_MS = 1000; // 1 seconds
 const PROGMEM uint32_t HP_RETRY_INTERVAL_MS = 1000; // 1 seconds
+const PROGMEM uint16_t MQTT_BUFFER_SIZE = 1280; // Fits a S21EXP_MAX_LEN query plus topic and MQTT header
+const PROGMEM uint16_t S21EXP_MAX_LEN = 1024; // Bulk query payload, about 340 commands
+const PROGMEM uint16_t S21EXP_RESPONSE_SIZE = 192; // One s21exp result message
+const PROGMEM uint8_t PASSTHROUGH_QUEUE_SIZE = 16; // Raw serial frames waiting to be sent
+const PROGMEM uint8_t PASSTHROUGH_FRAME_SIZE = 64; // Largest raw request frame, S21/X50 requests are well below this
+const PROGMEM uint8_t PASSTHROUGH_RESPONSE_SIZE = 255; // Largest raw response kept, any X50 frame (its length is one byte)
+const PROGMEM uint32_t COMMAND_CONFIRM_TIMEOUT_MS = 60000; // Report a command as unconfirmed if the unit does not show it within 60 seconds
+const PROGMEM uint32_t STATE_HISTORY_REPLAY_INTERVAL_MS = 200; // Publish one buffered state sample every 200ms after reconnect
+const PROGMEM uint16_t LOG_CHUNK_SIZE = 1024; // /api/logs is copied out of the log buffer and sent this much at a time
+const PROGMEM uint32_t EVENT_PING_INTERVAL_MS = 15000; // Keep-alive comment on /events, detects subscribers that went away
+const PROGMEM uint32_t WEB_TASK_STACK_SIZE = 12 * 1024; // Web server task, page rendering and the settings handlers' JSON documents
+const PROGMEM uint32_t CONTROLLER_TASK_STACK_SIZE = 8 * 1024; // Controller task, UART exchanges and the command ack documents
+const PROGMEM uint8_t CONTROLLER_TASK_CORE = 1; // The loop task is moved to core 0 next to WiFi (ARDUINO_RUNNING_CORE in platformio.ini)
+const PROGMEM uint8_t CONTROLLER_COMMAND_QUEUE_SIZE = 8; // Control page, MQTT and button requests waiting for the controller task
+const PROGMEM uint8_t CONTROLLER_RESULT_QUEUE_SIZE = 8; // Controller answers waiting to be published by the loop task
+const PROGMEM uint16_t CONTROLLER_RESULT_SIZE = 1100; // Largest answer, a passthrough exchange with both frames in hex
+const PROGMEM uint32_t HP_SYNC_STEP_INTERVAL_MS = 20; // Between the query exchanges of a sync cycle, commands and raw frames run in the gap
+const PROGMEM uint32_t COMMAND_CONFIRM_CHECK_INTERVAL_MS = 1000; // Time out the pending command even when no sync completes
+const PROGMEM uint32_t MQTT_POLL_INTERVAL_MS = 10; // MQTT client loop and state publishing
+const PROGMEM uint32_t WIFI_CHECK_INTERVAL_MS = 1000;
+const PROGMEM uint32_t OTA_POLL_INTERVAL_MS = 50;
+const PROGMEM uint32_t DNS_POLL_INTERVAL_MS = 10; // Captive portal DNS answers
+const PROGMEM uint32_t BUTTON_POLL_INTERVAL_MS = 50;
+const PROGMEM uint32_t LED_INTERVAL_MS = 250;
+const PROGMEM uint32_t POWER_SAMPLE_INTERVAL_MS = 10000; // Window of the CPU idle share on the status page
+// Power save, polls that can wait longer so the cores stay idle in between
+const PROGMEM uint32_t MQTT_POWER_SAVE_POLL_INTERVAL_MS = 100; // Also the added latency of an MQTT command
+const PROGMEM uint32_t OTA_POWER_SAVE_POLL_INTERVAL_MS = 500;
+const PROGMEM uint32_t WEB_POWER_SAVE_POLL_INTERVAL_MS = 20; // New HTTP connections, a request in progress is served at full pace
+const PROGMEM uint32_t PROFILE_PUBLISH_INTERVAL_MS = 60000; // Section latencies to the profile topic, they are cumulative since boot
 const PROGMEM uint32_t HP_MAX_RETRIES = 10; // Double the interval between retries up to this many times, then keep retrying forever at that maximum interval.
 // Default values give a final retry interval of 1000ms * 2^10, which is 1024 seconds, about 17 minutes. 
 
@@ -136,8 +176,8 @@ bool useFahrenheit = false;
 bool supportHeatMode = false;
 
 
-// Languages
-#include "languages/en-GB.h" // default language English
+// Languages, src/languages/*.h are packed into language_packs.h by tools/language_packs.py
+String language_code = "en-GB"; // until a language is picked on the Unit page
 
 //IOs
 #define LED_PWR 5
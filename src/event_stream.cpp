@@ -0,0 +1,151 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "event_stream.h"
+#include "logger.h"
+
+#define TAG "events"
+
+// Log text sent per event, split into one data: line per log line.
+#define EVENT_LOG_CHUNK 512
+
+bool EventStream::add(WiFiClient client, bool wantsState, bool wantsLog, uint32_t logFrom)
+{
+  for (EventClient &slot : slots)
+  {
+    if (slot.active)
+      continue;
+    slot.client = client;
+    slot.active = true;
+    slot.wantsState = wantsState;
+    slot.wantsLog = wantsLog;
+    slot.hasState = false;
+    slot.logFrom = logFrom;
+    clients++;
+    // Written by hand, WebServer would use chunked encoding for a response of unknown length
+    static const char headers[] = "HTTP/1.1 200 OK\r\n"
+                                  "Content-Type: text/event-stream\r\n"
+                                  "Cache-Control: no-cache\r\n"
+                                  "Connection: keep-alive\r\n"
+                                  "\r\n"
+                                  "retry: 10000\n\n";
+    return write(slot, headers, sizeof(headers) - 1);
+  }
+  return false;
+}
+
+bool EventStream::needsState() const
+{
+  for (const EventClient &slot : slots)
+  {
+    if (slot.active && slot.wantsState && !slot.hasState)
+      return true;
+  }
+  return false;
+}
+
+void EventStream::sendState(const HVACState &state)
+{
+  char json[STATE_JSON_SIZE];
+  for (EventClient &slot : slots)
+  {
+    if (!slot.active || !slot.wantsState)
+      continue;
+    size_t len = slot.hasState ? StateEncoder::encodeDelta(slot.lastState, state, json, sizeof(json))
+                               : StateEncoder::encodeState(state, json, sizeof(json));
+    // "{}", nothing this subscriber cares about changed
+    if (len <= 2)
+      continue;
+    if (sendEvent(slot, "state", json, len))
+    {
+      slot.lastState = state;
+      slot.hasState = true;
+    }
+  }
+}
+
+void EventStream::sendLogs()
+{
+  char text[EVENT_LOG_CHUNK];
+  uint32_t end = Log.end();
+  for (EventClient &slot : slots)
+  {
+    if (!slot.active || !slot.wantsLog || slot.logFrom == end)
+      continue;
+    // Whole lines only, the log hands out complete records
+    uint32_t from = slot.logFrom;
+    size_t len = Log.read(from, end, text, sizeof(text));
+    if (len == 0)
+    {
+      // Everything it still wanted was rotated out
+      slot.logFrom = from;
+      continue;
+    }
+    // The id comes back as Last-Event-ID when the browser reconnects, see handleEvents
+    if (sendEvent(slot, "log", text, len, &from))
+      slot.logFrom = from;
+  }
+}
+
+void EventStream::ping()
+{
+  for (EventClient &slot : slots)
+  {
+    if (slot.active)
+      write(slot, ":\n\n", 3);
+  }
+}
+
+bool EventStream::sendEvent(EventClient &slot, const char *event, const char *data, size_t len, const uint32_t *id)
+{
+  char prefix[40];
+  int prefixLen = id == nullptr ? snprintf(prefix, sizeof(prefix), "event: %s\n", event)
+                                : snprintf(prefix, sizeof(prefix), "event: %s\nid: %lu\n", event, (unsigned long)*id);
+  if (!write(slot, prefix, prefixLen))
+    return false;
+  // Every line of the payload goes into its own data: field, the browser joins them back with \n
+  size_t start = 0;
+  while (start < len)
+  {
+    size_t stop = start;
+    while (stop < len && data[stop] != '\n')
+      stop++;
+    if (!write(slot, "data: ", 6) || !write(slot, data + start, stop - start) || !write(slot, "\n", 1))
+      return false;
+    start = stop + 1;
+  }
+  return write(slot, "\n", 1);
+}
+
+bool EventStream::write(EventClient &slot, const char *data, size_t len)
+{
+  if (!slot.client.connected() || slot.client.write((const uint8_t *)data, len) != len)
+  {
+    drop(slot);
+    return false;
+  }
+  return true;
+}
+
+void EventStream::drop(EventClient &slot)
+{
+  slot.client.stop();
+  slot.client = WiFiClient();
+  slot.active = false;
+  clients--;
+  LOGD(TAG, "Subscriber dropped, %u left", clients);
+}
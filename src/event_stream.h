@@ -0,0 +1,73 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <WebServer.h>
+#include "state_encoder.h"
+
+// Browsers allow about six connections per host, leave room for the page requests.
+#define EVENT_STREAM_CLIENTS 4
+
+struct EventClient
+{
+  WiFiClient client;
+  bool active;
+  bool wantsState;
+  bool wantsLog;
+  bool hasState;     // lastState has been sent, further state events are deltas
+  HVACState lastState;
+  uint32_t logFrom;  // log position, see Logging::read
+};
+
+// Server-Sent Events (/events). The request handler hands the connection over with add(), the web
+// task then pushes "state" events (changed fields only) and "log" events (new log text) to it.
+// All calls come from the web task.
+class EventStream
+{
+public:
+  // Writes the response headers, false (nothing written) when all slots are taken.
+  bool add(WiFiClient client, bool wantsState, bool wantsLog, uint32_t logFrom);
+  // Full state to new subscribers, the fields that changed since the last event to the others.
+  void sendState(const HVACState &state);
+  bool needsState() const;
+  void sendLogs();
+  // Comment line, lets a dead connection fail its write and free the slot.
+  void ping();
+  size_t count() const { return clients; }
+
+private:
+  EventClient slots[EVENT_STREAM_CLIENTS];
+  size_t clients = 0;
+
+  bool write(EventClient &slot, const char *data, size_t len);
+  bool sendEvent(EventClient &slot, const char *event, const char *data, size_t len, const uint32_t *id = nullptr);
+  void drop(EventClient &slot);
+};
+
+// WebServer that can let go of the request it is handling. When a handler returns with the socket
+// still open, WebServer waits up to HTTP_MAX_CLOSE_WAIT (2 s) for the browser to close it and serves
+// nobody else meanwhile; an event stream never closes.
+class EventWebServer : public WebServer
+{
+public:
+  EventWebServer(int port) : WebServer(port) {}
+  // Drops WebServer's reference to the connection without closing it, call after EventStream::add().
+  void release() { _currentClient = WiFiClient(); }
+};
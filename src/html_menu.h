@@ -34,7 +34,7 @@ const char html_menu_root[] PROGMEM = R"====(
 </div>
 <div>
     <form action='/logging' method='get'>
-        <button>_TXT_LOGGING</button>
+        <button>_TXT_LOGGING_</button>
     </form>
 </div>
 <div>
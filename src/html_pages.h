@@ -116,12 +116,36 @@ const char html_page_others[] PROGMEM =
                     "<option value='OFF' _HA_AVAIL_REPORT_OFF_>_TXT_F_OFF_</option>"
                 "</select>"
             "</p>"
+            "<p><b>_TXT_OTHERS_STATE_HISTORY_</b>"
+                "<select name='STATE_HISTORY'>"
+                    "<option value='ON' _STATE_HISTORY_ON_>_TXT_F_ON_</option>"
+                    "<option value='OFF' _STATE_HISTORY_OFF_>_TXT_F_OFF_</option>"
+                "</select>"
+            "</p>"
+            "<p><b>_TXT_OTHERS_POWER_SAVE_</b>"
+                "<select name='POWER_SAVE'>"
+                    "<option value='ON' _POWER_SAVE_ON_>_TXT_F_ON_</option>"
+                    "<option value='OFF' _POWER_SAVE_OFF_>_TXT_F_OFF_</option>"
+                "</select>"
+            "</p>"
             "<p><b>_TXT_OTHERS_DEBUG_</b>"
                 "<select name='Debug'>"
                     "<option value='ON' _DEBUG_ON_>_TXT_F_ON_</option>"
                     "<option value='OFF' _DEBUG_OFF_>_TXT_F_OFF_</option>"
                 "</select>"
             "</p>"
+            "<p><b>_TXT_OTHERS_LOG_LEVELS_</b>"
+                "<br/>"
+                "<input id='log_levels' name='LOG_LEVELS' "
+                "autocomplete='off' autocorrect='off' autocapitalize='off' spellcheck='false' "
+                "placeholder='*=info,DKUART=trace' value='_LOG_LEVELS_'>"
+            "</p>"
+            "<p><b>_TXT_OTHERS_SYSLOG_</b>"
+                "<br/>"
+                "<input id='syslog' name='SYSLOG' "
+                "autocomplete='off' autocorrect='off' autocapitalize='off' spellcheck='false' "
+                "placeholder='192.168.1.10:514' value='_SYSLOG_'>"
+            "</p>"
             "<br/>"
             "<button name='save' type='submit' class='button bgrn'>_TXT_SAVE_</button>"
         "</form>"
@@ -152,6 +176,16 @@ const char html_page_status[] PROGMEM =
         " ==> "
         "_WIFI_STATUS_ dBm"
     "</p>"
+    "<p><b>_TXT_STATUS_RESET_</b>"
+        " ==> "
+        "_RESET_REASON_ (<a href='/logging'>log</a>)"
+    "</p>"
+    "<p><b>_TXT_STATUS_CPU_IDLE_</b>"
+        " ==> "
+        "_CPU_IDLE_"
+    "</p>"
+    "<p><b>_TXT_STATUS_PROFILE_</b> (&micro;s)</p>"
+    "_PROFILE_"
     "</fieldset>"
     "<br />"
     "<p>"
@@ -199,7 +233,7 @@ const char html_page_wifi[] PROGMEM =
 
 
 const char html_page_control[] PROGMEM =
-"<h2>_TXT_CTRL_CTEMP_ _ROOMTEMP_&#176;</h2>"
+"<h2>_TXT_CTRL_CTEMP_ <span id='roomTemp'>_ROOMTEMP_</span>&#176;</h2>"
 "<div id='l1' name='l1'>"
     "<fieldset>"
         "<legend><b>&nbsp; _TXT_CTRL_TITLE_ &nbsp;</b></legend>"
@@ -265,44 +299,8 @@ const char html_page_control[] PROGMEM =
         "<a class='button back' href='/'>_TXT_BACK_</a>"
     "</p>"
 "</div>"
-"<script>"
-"const queryParams = (window.location.search.split('?')[1] || '')"
-        ".split('&')"
-        ".reduce((QS, current) => {"
-            "const [key, value] = current.split('=');"
-            "return Object.assign(QS, {[key]: value !== undefined ? value : ''});"
-        "}, {});"
-
-"function setTemp(b) {"
-    "var t = document.getElementById('TEMP');"
-    "if (b && t.value < _MAX_TEMP_) {"
-        "t.value = Number(t.value) + _TEMP_STEP_;"
-    "} else if (!b && t.value > _MIN_TEMP_) {"
-        "t.value = Number(t.value) - _TEMP_STEP_;"
-    "}"
-    "document.getElementById('FTEMP_').submit();"
-"}"
-
-"if (queryParams['TEMP']) {"
-    "document.getElementById('TEMP').value = queryParams['TEMP'];"
-"}"
-
-"if (!_HEAT_MODE_SUPPORT_) {"
-    "var options = document.getElementById('MODE').options;"
-    "options[3].disabled = (options[3].value == 'HEAT');"
-"}"
-"if (_X50_PROTOCOL_) {"
-
-    "var options = document.getElementById('MODE').options;"
-    "options[0].disabled = (options[0].value == 'AUTO');"
-
-    "options = document.getElementById('FAN').options;"
-    "options[1].disabled = (options[1].value == 'QUIET');"
-
-    "document.getElementById('VANE').disabled = true;"
-    "document.getElementById('WIDEVANE').disabled = true;"
-"}"
-"</script>"
+"<script>var cfg={min:_MIN_TEMP_,max:_MAX_TEMP_,step:_TEMP_STEP_,heat:_HEAT_MODE_SUPPORT_,x50:_X50_PROTOCOL_};</script>"
+"<script src='/control.js?v=_ASSET_VERSION_'></script>"
 ;
 
 const char html_page_unit[] PROGMEM =
@@ -324,6 +322,12 @@ const char html_page_unit[] PROGMEM =
                     "<option value='1' _LED_ON_> _TXT_F_LED_ON_ </option>"
                 "</select>"
             "</p>"
+            "<p>"
+                "<b>_TXT_UNIT_LANGUAGE_</b>"
+                "<select name='language'>"
+                    "_LANGUAGE_OPTIONS_"
+                "</select>"
+            "</p>"
             "<p>"
                 "<b>_TXT_UNIT_TEMP_</b>"
                 "<select name='tu'>"
@@ -353,11 +357,11 @@ const char html_page_unit[] PROGMEM =
             "<p>"
                 "<b>_TXT_UNIT_UPDATE_INTERVAL_</b>"
                 "<select name='update_int'>"
-                    "<option value='5' _UPDATE_5S_>_TXT_F_5_S</option>"
-                    "<option value='15' _UPDATE_15S_>_TXT_F_15_S</option>"
-                    "<option value='30' _UPDATE_30S_>_TXT_F_30_S</option>"
-                    "<option value='45' _UPDATE_45S_>_TXT_F_45_S</option>"
-                    "<option value='60' _UPDATE_60S_>_TXT_F_60_S</option>"
+                    "<option value='5' _UPDATE_5S_>_TXT_F_5S_</option>"
+                    "<option value='15' _UPDATE_15S_>_TXT_F_15S_</option>"
+                    "<option value='30' _UPDATE_30S_>_TXT_F_30S_</option>"
+                    "<option value='45' _UPDATE_45S_>_TXT_F_45S_</option>"
+                    "<option value='60' _UPDATE_60S_>_TXT_F_60S_</option>"
                 "</select>"
             "</p>"
             "<p><b>_TXT_UNIT_PASSWORD_</b>"
@@ -424,7 +428,12 @@ const char html_page_upgrade[] PROGMEM =
                 "<input type='file' accept='.bin' name='upload'>"
                 "<br>"
                 "<br>"
-                "<button type='submit' onclick=\"eb('f1').style.display='none';eb('f2').style.display='block';this.form.submit();\" class='button bgrn'>_TXT_B_UPGRADE_</button>"
+                "<p><b>_TXT_UPGRADE_SHA256_</b>"
+                    "<br/>"
+                    "<input id='sha256' autocomplete='off' spellcheck='false' placeholder=' '>"
+                "</p>"
+                // the digest goes in the query string, the device needs it before the file part arrives
+                "<button type='submit' onclick=\"this.form.action='upload?sha256='+encodeURIComponent(eb('sha256').value.trim());eb('f1').style.display='none';eb('f2').style.display='block';this.form.submit();\" class='button bgrn'>_TXT_B_UPGRADE_</button>"
             "</form>"
         "</fieldset>"
         "<p>"
@@ -436,14 +445,28 @@ const char html_page_upgrade[] PROGMEM =
 
 const char html_page_logging[] PROGMEM =
 "<script>"
-    "getLogs();"
-    "window.setInterval(getLogs, 5000);"
+    "var logNext = 0;"
+    "var logPoll = null;"
+    // history once, then new lines are pushed on /events; back to polling if that is refused
+    "getLogs().then(() => {"
+        "var events = new EventSource('/events?log=' + logNext);"
+        "events.addEventListener('log', (e) => appendLogs(e.data + '\\n'));"
+        "events.onerror = () => { if (events.readyState == EventSource.CLOSED && !logPoll) logPoll = window.setInterval(getLogs, 5000); };"
+    "});"
+    "function appendLogs(text) {"
+        "var textarea = document.getElementById('logArea');"
+        "textarea.value = (textarea.value + text).slice(-50000); textarea.scrollTop = textarea.scrollHeight;"
+    "}"
     "function getLogs() {"
-        // "fetch('/api/logs').then(response => document.getElementById('logArea').value=response.data;);"
-        "fetch('/api/logs').then(response => response.text())"
-                ".then((response) => { var textarea = document.getElementById('logArea'); textarea.value=response; textarea.scrollTop  = textarea.scrollHeight;"
+        // only fetch what was logged since the last poll, X-Log-Next is where the next one starts
+        "return fetch('/api/logs?since=' + logNext).then((response) => {"
+                "var reset = logNext == 0 || response.headers.get('X-Log-Reset');"
+                "logNext = response.headers.get('X-Log-Next') || 0;"
+                "return response.text().then((text) => {"
+                    "if (reset) document.getElementById('logArea').value = '';"
+                    "if (text.length) appendLogs(text);"
                 "});"
-        // "document.getElementById('logArea').value=logs"
+        "});"
     "}"
 "</script>"
     "<div id='f1' style='display:block;'>"
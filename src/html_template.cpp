@@ -0,0 +1,72 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "html_template.h"
+#include "language.h"
+
+void HtmlWriter::write(const char *data, size_t dataLen)
+{
+  total += dataLen;
+  while (dataLen > 0)
+  {
+    size_t n = min(dataLen, sizeof(buffer) - len);
+    // PROGMEM is memory mapped on the ESP32, page literals can be copied directly.
+    memcpy(buffer + len, data, n);
+    len += n;
+    data += n;
+    dataLen -= n;
+    if (len == sizeof(buffer))
+      flush();
+  }
+}
+
+void HtmlWriter::print(int value)
+{
+  char number[12];
+  write(number, snprintf(number, sizeof(number), "%d", value));
+}
+
+void HtmlWriter::print(float value)
+{
+  char number[16];
+  write(number, snprintf(number, sizeof(number), "%.2f", value));
+}
+
+void HtmlWriter::flush()
+{
+  if (len == 0)
+    return;
+  sink(buffer, len);
+  len = 0;
+}
+
+void renderTemplate(HtmlWriter &out, const HtmlTemplate &page, HTML_RESOLVER_SIGNATURE)
+{
+  for (uint16_t i = 0; i < page.count; i++)
+  {
+    const HtmlSegment &segment = page.segments[i];
+    out.write(page.text + segment.offset, segment.length);
+    if (segment.field == 0)
+      continue;
+    // Messages come straight from the inflated language pack, resolvers only see the other fields
+    TextId text = (TextId)page.texts[segment.field];
+    if (text != TXT_NONE)
+      out.print(language.text(text));
+    else
+      resolver(segment.field, out);
+  }
+}
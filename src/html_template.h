@@ -0,0 +1,70 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include <functional>
+
+// Bytes buffered before a chunk is handed to the sink, a few TCP segments worth.
+#define HTML_CHUNK_SIZE 1460
+
+// Tables are generated at build time by tools/html_templates.py into html_templates.h.
+struct HtmlSegment
+{
+  uint16_t offset;
+  uint16_t length;
+  uint8_t field; // HtmlField written after the literal, HF_NONE (0) for none
+};
+
+struct HtmlTemplate
+{
+  const char *text;
+  const HtmlSegment *segments;
+  uint16_t count;
+  const uint8_t *texts; // TextId of each HtmlField, TXT_NONE (0) when it is not a message
+};
+
+#define HTML_SINK_SIGNATURE std::function<void(const char *data, size_t len)> sink
+
+// Buffers page output and passes it to the sink in HTML_CHUNK_SIZE chunks (WebServer::sendContent for a response).
+class HtmlWriter
+{
+public:
+  HtmlWriter(HTML_SINK_SIGNATURE) : sink(sink){};
+
+  void write(const char *data, size_t len);
+  void print(const char *text) { write(text, strlen(text)); };
+  void print(const String &text) { write(text.c_str(), text.length()); };
+  void print(int value);
+  void print(float value); // Two decimals, same as String(float)
+  void flush();
+  size_t size() { return total; };
+
+private:
+  HTML_SINK_SIGNATURE;
+  char buffer[HTML_CHUNK_SIZE];
+  size_t len = 0;
+  size_t total = 0;
+};
+
+#define HTML_RESOLVER_SIGNATURE std::function<void(uint8_t field, HtmlWriter &out)> resolver
+
+// Writes the template literals, the message of each _TXT_*_ field in the selected language and
+// asks the resolver for the other placeholders. Fields the resolver does not write stay empty,
+// unlike String::replace which left the placeholder text in the page.
+void renderTemplate(HtmlWriter &out, const HtmlTemplate &page, HTML_RESOLVER_SIGNATURE);
@@ -0,0 +1,922 @@
+// Generated by tools/html_templates.py from html_common.h, html_init.h, html_menu.h, html_pages.h, do not edit.
+// Each page is a list of {offset, length, field}: write length bytes of the page
+// from offset, then the value of field (HF_NONE for the last segment).
+
+#pragma once
+
+#include "html_template.h"
+#include "language_packs.h"
+
+enum HtmlField : uint8_t
+{
+  HF_NONE = 0,
+  HF_ASSET_VERSION,
+  HF_BEEP_OFF,
+  HF_BEEP_ON,
+  HF_CPU_IDLE,
+  HF_DEBUG_OFF,
+  HF_DEBUG_ON,
+  HF_FAN_1,
+  HF_FAN_2,
+  HF_FAN_3,
+  HF_FAN_4,
+  HF_FAN_5,
+  HF_FAN_A,
+  HF_FAN_Q,
+  HF_HAA_OFF,
+  HF_HAA_ON,
+  HF_HAA_TOPIC,
+  HF_HA_AVAIL_REPORT_OFF,
+  HF_HA_AVAIL_REPORT_ON,
+  HF_HEAT_MODE_SUPPORT,
+  HF_HVAC_PROTOCOL,
+  HF_HVAC_RETRIES,
+  HF_HVAC_STATUS,
+  HF_LANGUAGE_OPTIONS,
+  HF_LED_OFF,
+  HF_LED_ON,
+  HF_LOGIN_MSG,
+  HF_LOGIN_PASSWORD,
+  HF_LOGIN_SUCCESS,
+  HF_LOG_LEVELS,
+  HF_MAX_TEMP,
+  HF_MD_ALL,
+  HF_MD_NONHEAT,
+  HF_MIN_TEMP,
+  HF_MODE_A,
+  HF_MODE_C,
+  HF_MODE_D,
+  HF_MODE_F,
+  HF_MODE_H,
+  HF_MQTT_FN,
+  HF_MQTT_HOST,
+  HF_MQTT_PASSWORD,
+  HF_MQTT_PORT,
+  HF_MQTT_REASON,
+  HF_MQTT_STATUS,
+  HF_MQTT_TOPIC,
+  HF_MQTT_USER,
+  HF_OTA_PWD,
+  HF_POWER_OFF,
+  HF_POWER_ON,
+  HF_POWER_SAVE_OFF,
+  HF_POWER_SAVE_ON,
+  HF_PROFILE,
+  HF_PSK,
+  HF_RESET_REASON,
+  HF_ROOMTEMP,
+  HF_SHOW_CONTROL,
+  HF_SHOW_LOGOUT,
+  HF_SSID,
+  HF_STATE_HISTORY_OFF,
+  HF_STATE_HISTORY_ON,
+  HF_SYSLOG,
+  HF_TEMP,
+  HF_TEMP_SCALE,
+  HF_TEMP_STEP,
+  HF_TU_CEL,
+  HF_TU_FAH,
+  HF_TXT_BACK,
+  HF_TXT_B_UPGRADE,
+  HF_TXT_CONTROL,
+  HF_TXT_CTRL_CTEMP,
+  HF_TXT_CTRL_FAN,
+  HF_TXT_CTRL_MODE,
+  HF_TXT_CTRL_POWER,
+  HF_TXT_CTRL_TEMP,
+  HF_TXT_CTRL_TITLE,
+  HF_TXT_CTRL_VANE,
+  HF_TXT_CTRL_WVANE,
+  HF_TXT_FW_UPGRADE,
+  HF_TXT_F_15S,
+  HF_TXT_F_30S,
+  HF_TXT_F_45S,
+  HF_TXT_F_5S,
+  HF_TXT_F_60S,
+  HF_TXT_F_ALLMODES,
+  HF_TXT_F_AUTO,
+  HF_TXT_F_BEEP_OFF,
+  HF_TXT_F_BEEP_ON,
+  HF_TXT_F_CELSIUS,
+  HF_TXT_F_COOL,
+  HF_TXT_F_DRY,
+  HF_TXT_F_FAN,
+  HF_TXT_F_FH,
+  HF_TXT_F_HEAT,
+  HF_TXT_F_HOLD,
+  HF_TXT_F_LED_OFF,
+  HF_TXT_F_LED_ON,
+  HF_TXT_F_NOHEAT,
+  HF_TXT_F_OFF,
+  HF_TXT_F_ON,
+  HF_TXT_F_QUIET,
+  HF_TXT_F_SPEED,
+  HF_TXT_F_SWING,
+  HF_TXT_INIT_HOST,
+  HF_TXT_INIT_OTA,
+  HF_TXT_INIT_PSK,
+  HF_TXT_INIT_REBOOT,
+  HF_TXT_INIT_REBOOT_MESS,
+  HF_TXT_INIT_SSID,
+  HF_TXT_INIT_TITLE,
+  HF_TXT_LOGGING,
+  HF_TXT_LOGGING_TITLE,
+  HF_TXT_LOGIN,
+  HF_TXT_LOGIN_PASSWORD,
+  HF_TXT_LOGIN_TITLE,
+  HF_TXT_LOGOUT,
+  HF_TXT_MQTT,
+  HF_TXT_MQTT_FN,
+  HF_TXT_MQTT_HOST,
+  HF_TXT_MQTT_PASSWORD,
+  HF_TXT_MQTT_PORT,
+  HF_TXT_MQTT_TITLE,
+  HF_TXT_MQTT_TOPIC,
+  HF_TXT_MQTT_USER,
+  HF_TXT_M_REBOOT,
+  HF_TXT_M_RESET,
+  HF_TXT_M_SAVE,
+  HF_TXT_OTHERS,
+  HF_TXT_OTHERS_AVAILABILITY_REPORT,
+  HF_TXT_OTHERS_DEBUG,
+  HF_TXT_OTHERS_HAAUTO,
+  HF_TXT_OTHERS_HATOPIC,
+  HF_TXT_OTHERS_LOG_LEVELS,
+  HF_TXT_OTHERS_POWER_SAVE,
+  HF_TXT_OTHERS_STATE_HISTORY,
+  HF_TXT_OTHERS_SYSLOG,
+  HF_TXT_OTHERS_TITLE,
+  HF_TXT_REBOOT,
+  HF_TXT_RESETCONFIRM,
+  HF_TXT_RESET,
+  HF_TXT_RETRIES_HVAC,
+  HF_TXT_SAVE,
+  HF_TXT_SETUP,
+  HF_TXT_STATUS,
+  HF_TXT_STATUS_CPU_IDLE,
+  HF_TXT_STATUS_HVAC,
+  HF_TXT_STATUS_MQTT,
+  HF_TXT_STATUS_PROFILE,
+  HF_TXT_STATUS_RESET,
+  HF_TXT_STATUS_TITLE,
+  HF_TXT_STATUS_WIFI,
+  HF_TXT_UNIT,
+  HF_TXT_UNIT_BEEP,
+  HF_TXT_UNIT_LANGUAGE,
+  HF_TXT_UNIT_LED,
+  HF_TXT_UNIT_MAXTEMP,
+  HF_TXT_UNIT_MINTEMP,
+  HF_TXT_UNIT_MODES,
+  HF_TXT_UNIT_PASSWORD,
+  HF_TXT_UNIT_STEPTEMP,
+  HF_TXT_UNIT_TEMP,
+  HF_TXT_UNIT_TITLE,
+  HF_TXT_UNIT_UPDATE_INTERVAL,
+  HF_TXT_UPGRADE_INFO,
+  HF_TXT_UPGRADE_SHA256,
+  HF_TXT_UPGRADE_START,
+  HF_TXT_UPGRADE_TITLE,
+  HF_TXT_WIFI,
+  HF_TXT_WIFI_HOST,
+  HF_TXT_WIFI_OTAP,
+  HF_TXT_WIFI_PSK,
+  HF_TXT_WIFI_SSID,
+  HF_TXT_WIFI_TITLE,
+  HF_UNIT_NAME,
+  HF_UPDATE_15S,
+  HF_UPDATE_30S,
+  HF_UPDATE_45S,
+  HF_UPDATE_5S,
+  HF_UPDATE_60S,
+  HF_UPLOAD_MSG,
+  HF_VANE_H,
+  HF_VANE_S,
+  HF_VERSION,
+  HF_WIFI_STATUS,
+  HF_WVANE_H,
+  HF_WVANE_S,
+  HF_X50_PROTOCOL,
+  HF_COUNT
+};
+
+// Placeholder text of each field, for code that still uses String::replace
+const char *const html_field_names[HF_COUNT] PROGMEM = {
+    "",
+    "_ASSET_VERSION_",
+    "_BEEP_OFF_",
+    "_BEEP_ON_",
+    "_CPU_IDLE_",
+    "_DEBUG_OFF_",
+    "_DEBUG_ON_",
+    "_FAN_1_",
+    "_FAN_2_",
+    "_FAN_3_",
+    "_FAN_4_",
+    "_FAN_5_",
+    "_FAN_A_",
+    "_FAN_Q_",
+    "_HAA_OFF_",
+    "_HAA_ON_",
+    "_HAA_TOPIC_",
+    "_HA_AVAIL_REPORT_OFF_",
+    "_HA_AVAIL_REPORT_ON_",
+    "_HEAT_MODE_SUPPORT_",
+    "_HVAC_PROTOCOL_",
+    "_HVAC_RETRIES_",
+    "_HVAC_STATUS_",
+    "_LANGUAGE_OPTIONS_",
+    "_LED_OFF_",
+    "_LED_ON_",
+    "_LOGIN_MSG_",
+    "_LOGIN_PASSWORD_",
+    "_LOGIN_SUCCESS_",
+    "_LOG_LEVELS_",
+    "_MAX_TEMP_",
+    "_MD_ALL_",
+    "_MD_NONHEAT_",
+    "_MIN_TEMP_",
+    "_MODE_A_",
+    "_MODE_C_",
+    "_MODE_D_",
+    "_MODE_F_",
+    "_MODE_H_",
+    "_MQTT_FN_",
+    "_MQTT_HOST_",
+    "_MQTT_PASSWORD_",
+    "_MQTT_PORT_",
+    "_MQTT_REASON_",
+    "_MQTT_STATUS_",
+    "_MQTT_TOPIC_",
+    "_MQTT_USER_",
+    "_OTA_PWD_",
+    "_POWER_OFF_",
+    "_POWER_ON_",
+    "_POWER_SAVE_OFF_",
+    "_POWER_SAVE_ON_",
+    "_PROFILE_",
+    "_PSK_",
+    "_RESET_REASON_",
+    "_ROOMTEMP_",
+    "_SHOW_CONTROL_",
+    "_SHOW_LOGOUT_",
+    "_SSID_",
+    "_STATE_HISTORY_OFF_",
+    "_STATE_HISTORY_ON_",
+    "_SYSLOG_",
+    "_TEMP_",
+    "_TEMP_SCALE_",
+    "_TEMP_STEP_",
+    "_TU_CEL_",
+    "_TU_FAH_",
+    "_TXT_BACK_",
+    "_TXT_B_UPGRADE_",
+    "_TXT_CONTROL_",
+    "_TXT_CTRL_CTEMP_",
+    "_TXT_CTRL_FAN_",
+    "_TXT_CTRL_MODE_",
+    "_TXT_CTRL_POWER_",
+    "_TXT_CTRL_TEMP_",
+    "_TXT_CTRL_TITLE_",
+    "_TXT_CTRL_VANE_",
+    "_TXT_CTRL_WVANE_",
+    "_TXT_FW_UPGRADE_",
+    "_TXT_F_15S_",
+    "_TXT_F_30S_",
+    "_TXT_F_45S_",
+    "_TXT_F_5S_",
+    "_TXT_F_60S_",
+    "_TXT_F_ALLMODES_",
+    "_TXT_F_AUTO_",
+    "_TXT_F_BEEP_OFF_",
+    "_TXT_F_BEEP_ON_",
+    "_TXT_F_CELSIUS_",
+    "_TXT_F_COOL_",
+    "_TXT_F_DRY_",
+    "_TXT_F_FAN_",
+    "_TXT_F_FH_",
+    "_TXT_F_HEAT_",
+    "_TXT_F_HOLD_",
+    "_TXT_F_LED_OFF_",
+    "_TXT_F_LED_ON_",
+    "_TXT_F_NOHEAT_",
+    "_TXT_F_OFF_",
+    "_TXT_F_ON_",
+    "_TXT_F_QUIET_",
+    "_TXT_F_SPEED_",
+    "_TXT_F_SWING_",
+    "_TXT_INIT_HOST_",
+    "_TXT_INIT_OTA_",
+    "_TXT_INIT_PSK_",
+    "_TXT_INIT_REBOOT_",
+    "_TXT_INIT_REBOOT_MESS_",
+    "_TXT_INIT_SSID_",
+    "_TXT_INIT_TITLE_",
+    "_TXT_LOGGING_",
+    "_TXT_LOGGING_TITLE_",
+    "_TXT_LOGIN_",
+    "_TXT_LOGIN_PASSWORD_",
+    "_TXT_LOGIN_TITLE_",
+    "_TXT_LOGOUT_",
+    "_TXT_MQTT_",
+    "_TXT_MQTT_FN_",
+    "_TXT_MQTT_HOST_",
+    "_TXT_MQTT_PASSWORD_",
+    "_TXT_MQTT_PORT_",
+    "_TXT_MQTT_TITLE_",
+    "_TXT_MQTT_TOPIC_",
+    "_TXT_MQTT_USER_",
+    "_TXT_M_REBOOT_",
+    "_TXT_M_RESET_",
+    "_TXT_M_SAVE_",
+    "_TXT_OTHERS_",
+    "_TXT_OTHERS_AVAILABILITY_REPORT_",
+    "_TXT_OTHERS_DEBUG_",
+    "_TXT_OTHERS_HAAUTO_",
+    "_TXT_OTHERS_HATOPIC_",
+    "_TXT_OTHERS_LOG_LEVELS_",
+    "_TXT_OTHERS_POWER_SAVE_",
+    "_TXT_OTHERS_STATE_HISTORY_",
+    "_TXT_OTHERS_SYSLOG_",
+    "_TXT_OTHERS_TITLE_",
+    "_TXT_REBOOT_",
+    "_TXT_RESETCONFIRM_",
+    "_TXT_RESET_",
+    "_TXT_RETRIES_HVAC_",
+    "_TXT_SAVE_",
+    "_TXT_SETUP_",
+    "_TXT_STATUS_",
+    "_TXT_STATUS_CPU_IDLE_",
+    "_TXT_STATUS_HVAC_",
+    "_TXT_STATUS_MQTT_",
+    "_TXT_STATUS_PROFILE_",
+    "_TXT_STATUS_RESET_",
+    "_TXT_STATUS_TITLE_",
+    "_TXT_STATUS_WIFI_",
+    "_TXT_UNIT_",
+    "_TXT_UNIT_BEEP_",
+    "_TXT_UNIT_LANGUAGE_",
+    "_TXT_UNIT_LED_",
+    "_TXT_UNIT_MAXTEMP_",
+    "_TXT_UNIT_MINTEMP_",
+    "_TXT_UNIT_MODES_",
+    "_TXT_UNIT_PASSWORD_",
+    "_TXT_UNIT_STEPTEMP_",
+    "_TXT_UNIT_TEMP_",
+    "_TXT_UNIT_TITLE_",
+    "_TXT_UNIT_UPDATE_INTERVAL_",
+    "_TXT_UPGRADE_INFO_",
+    "_TXT_UPGRADE_SHA256_",
+    "_TXT_UPGRADE_START_",
+    "_TXT_UPGRADE_TITLE_",
+    "_TXT_WIFI_",
+    "_TXT_WIFI_HOST_",
+    "_TXT_WIFI_OTAP_",
+    "_TXT_WIFI_PSK_",
+    "_TXT_WIFI_SSID_",
+    "_TXT_WIFI_TITLE_",
+    "_UNIT_NAME_",
+    "_UPDATE_15S_",
+    "_UPDATE_30S_",
+    "_UPDATE_45S_",
+    "_UPDATE_5S_",
+    "_UPDATE_60S_",
+    "_UPLOAD_MSG_",
+    "_VANE_H_",
+    "_VANE_S_",
+    "_VERSION_",
+    "_WIFI_STATUS_",
+    "_WVANE_H_",
+    "_WVANE_S_",
+    "_X50_PROTOCOL_",
+};
+
+// Message written for each field by renderTemplate, TXT_NONE for fields left to the page resolver
+const uint8_t html_field_texts[HF_COUNT] PROGMEM = {
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_BACK,
+    TXT_NONE,
+    TXT_CONTROL,
+    TXT_CTRL_CTEMP,
+    TXT_CTRL_FAN,
+    TXT_CTRL_MODE,
+    TXT_CTRL_POWER,
+    TXT_CTRL_TEMP,
+    TXT_CTRL_TITLE,
+    TXT_CTRL_VANE,
+    TXT_CTRL_WVANE,
+    TXT_NONE,
+    TXT_F_15S,
+    TXT_F_30S,
+    TXT_F_45S,
+    TXT_F_5S,
+    TXT_F_60S,
+    TXT_F_ALLMODES,
+    TXT_F_AUTO,
+    TXT_F_BEEP_OFF,
+    TXT_F_BEEP_ON,
+    TXT_F_CELSIUS,
+    TXT_F_COOL,
+    TXT_F_DRY,
+    TXT_F_FAN,
+    TXT_F_FH,
+    TXT_F_HEAT,
+    TXT_F_HOLD,
+    TXT_F_LED_OFF,
+    TXT_F_LED_ON,
+    TXT_F_NOHEAT,
+    TXT_F_OFF,
+    TXT_F_ON,
+    TXT_F_QUIET,
+    TXT_F_SPEED,
+    TXT_F_SWING,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_INIT_REBOOT,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_INIT_TITLE,
+    TXT_LOGGING,
+    TXT_LOGGING_TITLE,
+    TXT_LOGIN,
+    TXT_LOGIN_PASSWORD,
+    TXT_LOGIN_TITLE,
+    TXT_LOGOUT,
+    TXT_MQTT,
+    TXT_MQTT_FN,
+    TXT_MQTT_HOST,
+    TXT_MQTT_PASSWORD,
+    TXT_MQTT_PORT,
+    TXT_MQTT_TITLE,
+    TXT_MQTT_TOPIC,
+    TXT_MQTT_USER,
+    TXT_M_REBOOT,
+    TXT_M_RESET,
+    TXT_M_SAVE,
+    TXT_OTHERS,
+    TXT_OTHERS_AVAILABILITY_REPORT,
+    TXT_OTHERS_DEBUG,
+    TXT_OTHERS_HAAUTO,
+    TXT_OTHERS_HATOPIC,
+    TXT_OTHERS_LOG_LEVELS,
+    TXT_OTHERS_POWER_SAVE,
+    TXT_OTHERS_STATE_HISTORY,
+    TXT_OTHERS_SYSLOG,
+    TXT_OTHERS_TITLE,
+    TXT_REBOOT,
+    TXT_NONE,
+    TXT_RESET,
+    TXT_RETRIES_HVAC,
+    TXT_SAVE,
+    TXT_SETUP,
+    TXT_STATUS,
+    TXT_STATUS_CPU_IDLE,
+    TXT_STATUS_HVAC,
+    TXT_STATUS_MQTT,
+    TXT_STATUS_PROFILE,
+    TXT_STATUS_RESET,
+    TXT_STATUS_TITLE,
+    TXT_STATUS_WIFI,
+    TXT_UNIT,
+    TXT_UNIT_BEEP,
+    TXT_UNIT_LANGUAGE,
+    TXT_UNIT_LED,
+    TXT_UNIT_MAXTEMP,
+    TXT_UNIT_MINTEMP,
+    TXT_UNIT_MODES,
+    TXT_UNIT_PASSWORD,
+    TXT_UNIT_STEPTEMP,
+    TXT_UNIT_TEMP,
+    TXT_UNIT_TITLE,
+    TXT_UNIT_UPDATE_INTERVAL,
+    TXT_UPGRADE_INFO,
+    TXT_UPGRADE_SHA256,
+    TXT_UPGRADE_START,
+    TXT_UPGRADE_TITLE,
+    TXT_WIFI,
+    TXT_NONE,
+    TXT_WIFI_OTAP,
+    TXT_WIFI_PSK,
+    TXT_WIFI_SSID,
+    TXT_WIFI_TITLE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+    TXT_NONE,
+};
+
+const HtmlSegment html_common_header_segments[] PROGMEM = {
+    {0, 195, HF_UNIT_NAME},
+    {206, 55, HF_ASSET_VERSION},
+    {276, 188, HF_UNIT_NAME},
+    {475, 21, HF_NONE},
+};
+const HtmlTemplate html_common_header_template = {html_common_header, html_common_header_segments, sizeof(html_common_header_segments) / sizeof(HtmlSegment), html_field_texts};
+
+const HtmlSegment html_common_footer_segments[] PROGMEM = {
+    {0, 111, HF_VERSION},
+    {120, 44, HF_NONE},
+};
+const HtmlTemplate html_common_footer_template = {html_common_footer, html_common_footer_segments, sizeof(html_common_footer_segments) / sizeof(HtmlSegment), html_field_texts};
+
+const HtmlSegment html_init_setup_segments[] PROGMEM = {
+    {0, 575, HF_TXT_INIT_TITLE},
+    {591, 92, HF_TXT_INIT_HOST},
+    {698, 83, HF_UNIT_NAME},
+    {792, 30, HF_TXT_INIT_SSID},
+    {837, 111, HF_TXT_INIT_PSK},
+    {962, 109, HF_TXT_INIT_OTA},
+    {1085, 176, HF_TXT_MQTT_TITLE},
+    {1277, 29, HF_TXT_MQTT_FN},
+    {1319, 186, HF_MQTT_FN},
+    {1514, 115, HF_TXT_MQTT_HOST},
+    {1644, 198, HF_MQTT_HOST},
+    {1853, 30, HF_TXT_MQTT_PORT},
+    {1898, 101, HF_MQTT_PORT},
+    {2010, 30, HF_TXT_MQTT_USER},
+    {2055, 193, HF_MQTT_USER},
+    {2259, 30, HF_TXT_MQTT_PASSWORD},
+    {2308, 106, HF_MQTT_PASSWORD},
+    {2429, 30, HF_TXT_MQTT_TOPIC},
+    {2475, 190, HF_MQTT_TOPIC},
+    {2677, 118, HF_TXT_SAVE},
+    {2805, 67, HF_TXT_REBOOT},
+    {2884, 22, HF_NONE},
+};
+const HtmlTemplate html_init_setup_template = {html_init_setup, html_init_setup_segments, sizeof(html_init_setup_segments) / sizeof(HtmlSegment), html_field_texts};
+
+const HtmlSegment html_init_save_segments[] PROGMEM = {
+    {0, 5, HF_TXT_INIT_REBOOT_MESS},
+    {27, 6, HF_NONE},
+};
+const HtmlTemplate html_init_save_template = {html_init_save, html_init_save_segments, sizeof(html_init_save_segments) / sizeof(HtmlSegment), html_field_texts};
+
+const HtmlSegment html_init_reboot_segments[] PROGMEM = {
+    {0, 5, HF_TXT_INIT_REBOOT},
+    {22, 6, HF_NONE},
+};
+const HtmlTemplate html_init_reboot_template = {html_init_reboot, html_init_reboot_segments, sizeof(html_init_reboot_segments) / sizeof(HtmlSegment), html_field_texts};
+
+const HtmlSegment html_menu_root_segments[] PROGMEM = {
+    {0, 99, HF_TXT_CONTROL},
+    {112, 91, HF_TXT_SETUP},
+    {214, 92, HF_TXT_STATUS},
+    {318, 93, HF_TXT_LOGGING},
+    {424, 93, HF_TXT_FW_UPGRADE},
+    {533, 110, HF_TXT_REBOOT},
+    {655, 184, HF_TXT_LOGOUT},
+    {851, 46, HF_SHOW_LOGOUT},
+    {910, 80, HF_SHOW_CONTROL},
+    {1004, 83, HF_NONE},
+};
+const HtmlTemplate html_menu_root_template = {html_menu_root, html_menu_root_segments, sizeof(html_menu_root_segments) / sizeof(HtmlSegment), html_field_texts};
+
+const HtmlSegment html_menu_setup_segments[] PROGMEM = {
+    {0, 60, HF_TXT_MQTT},
+    {70, 86, HF_TXT_WIFI},
+    {166, 86, HF_TXT_UNIT},
+    {262, 89, HF_TXT_OTHERS},
+    {363, 68, HF_TXT_RESETCONFIRM},
+    {449, 70, HF_TXT_RESET},
+    {530, 82, HF_TXT_BACK},
+    {622, 27, HF_NONE},
+};
+const HtmlTemplate html_menu_setup_template = {html_menu_setup, html_menu_setup_segments, sizeof(html_menu_setup_segments) / sizeof(HtmlSegment), html_field_texts};
+
+const HtmlSegment html_page_reboot_segments[] PROGMEM = {
+    {0, 3, HF_TXT_M_REBOOT},
+    {17, 35, HF_NONE},
+};
+const HtmlTemplate html_page_reboot_template = {html_page_reboot, html_page_reboot_segments, sizeof(html_page_reboot_segments) / sizeof(HtmlSegment), html_field_texts};
+
+const HtmlSegment html_page_reset_segments[] PROGMEM = {
+    {0, 3, HF_TXT_M_RESET},
+    {16, 1, HF_SSID},
+    {23, 7, HF_NONE},
+};
+const HtmlTemplate html_page_reset_template = {html_page_reset, html_page_reset_segments, sizeof(html_page_reset_segments) / sizeof(HtmlSegment), html_field_texts};
+
+const HtmlSegment html_page_save_reboot_segments[] PROGMEM = {
+    {0, 3, HF_TXT_M_SAVE},
+    {15, 35, HF_NONE},
+};
+const HtmlTemplate html_page_save_reboot_template = {html_page_save_reboot, html_page_save_reboot_segments, sizeof(html_page_save_reboot_segments) / sizeof(HtmlSegment), html_field_texts};
+
+const HtmlSegment html_page_mqtt_segments[] PROGMEM = {
+    {0, 509, HF_TXT_MQTT_TITLE},
+    {525, 62, HF_TXT_MQTT_FN},
+    {600, 134, HF_MQTT_FN},
+    {743, 88, HF_TXT_MQTT_HOST},
+    {846, 146, HF_MQTT_HOST},
+    {1003, 12, HF_TXT_MQTT_PORT},
+    {1030, 75, HF_MQTT_PORT},
+    {1116, 12, HF_TXT_MQTT_USER},
+    {1143, 141, HF_MQTT_USER},
+    {1295, 12, HF_TXT_MQTT_PASSWORD},
+    {1326, 80, HF_MQTT_PASSWORD},
+    {1421, 12, HF_TXT_MQTT_TOPIC},
+    {1449, 138, HF_MQTT_TOPIC},
+    {1599, 82, HF_TXT_SAVE},
+    {1691, 67, HF_TXT_BACK},
+    {1768, 14, HF_NONE},
+};
+const HtmlTemplate html_page_mqtt_template = {html_page_mqtt, html_page_mqtt_segments, sizeof(html_page_mqtt_segments) / sizeof(HtmlSegment), html_field_texts};
+
+const HtmlSegment html_page_others_segments[] PROGMEM = {
+    {0, 51, HF_TXT_OTHERS_TITLE},
+    {69, 46, HF_TXT_OTHERS_HAAUTO},
+    {134, 42, HF_HAA_ON},
+    {184, 1, HF_TXT_F_ON},
+    {195, 29, HF_HAA_OFF},
+    {233, 1, HF_TXT_F_OFF},
+    {245, 28, HF_TXT_OTHERS_HATOPIC},
+    {293, 141, HF_HAA_TOPIC},
+    {445, 12, HF_TXT_OTHERS_AVAILABILITY_REPORT},
+    {489, 51, HF_HA_AVAIL_REPORT_ON},
+    {560, 1, HF_TXT_F_ON},
+    {571, 29, HF_HA_AVAIL_REPORT_OFF},
+    {621, 1, HF_TXT_F_OFF},
+    {633, 28, HF_TXT_OTHERS_STATE_HISTORY},
+    {687, 52, HF_STATE_HISTORY_ON},
+    {757, 1, HF_TXT_F_ON},
+    {768, 29, HF_STATE_HISTORY_OFF},
+    {816, 1, HF_TXT_F_OFF},
+    {828, 28, HF_TXT_OTHERS_POWER_SAVE},
+    {879, 49, HF_POWER_SAVE_ON},
+    {943, 1, HF_TXT_F_ON},
+    {954, 29, HF_POWER_SAVE_OFF},
+    {999, 1, HF_TXT_F_OFF},
+    {1011, 28, HF_TXT_OTHERS_DEBUG},
+    {1057, 44, HF_DEBUG_ON},
+    {1111, 1, HF_TXT_F_ON},
+    {1122, 29, HF_DEBUG_OFF},
+    {1162, 1, HF_TXT_F_OFF},
+    {1174, 28, HF_TXT_OTHERS_LOG_LEVELS},
+    {1225, 168, HF_LOG_LEVELS},
+    {1405, 12, HF_TXT_OTHERS_SYSLOG},
+    {1436, 157, HF_SYSLOG},
+    {1601, 65, HF_TXT_SAVE},
+    {1676, 67, HF_TXT_BACK},
+    {1753, 14, HF_NONE},
+};
+const HtmlTemplate html_page_others_template = {html_page_others, html_page_others_segments, sizeof(html_page_others_segments) / sizeof(HtmlSegment), html_field_texts};
+
+const HtmlSegment html_page_status_segments[] PROGMEM = {
+    {0, 51, HF_TXT_STATUS_TITLE},
+    {69, 26, HF_TXT_STATUS_HVAC},
+    {112, 9, HF_HVAC_STATUS},
+    {134, 1, HF_HVAC_PROTOCOL},
+    {150, 10, HF_TXT_STATUS_MQTT},
+    {177, 9, HF_MQTT_STATUS},
+    {199, 3, HF_MQTT_REASON},
+    {215, 12, HF_TXT_RETRIES_HVAC},
+    {245, 9, HF_HVAC_RETRIES},
+    {268, 10, HF_TXT_STATUS_WIFI},
+    {295, 9, HF_WIFI_STATUS},
+    {317, 14, HF_TXT_STATUS_RESET},
+    {349, 9, HF_RESET_REASON},
+    {372, 39, HF_TXT_STATUS_CPU_IDLE},
+    {432, 9, HF_CPU_IDLE},
+    {451, 10, HF_TXT_STATUS_PROFILE},
+    {481, 19, HF_PROFILE},
+    {509, 52, HF_TXT_BACK},
+    {571, 14, HF_NONE},
+};
+const HtmlTemplate html_page_status_template = {html_page_status, html_page_status_segments, sizeof(html_page_status_segments) / sizeof(HtmlSegment), html_field_texts};
+
+const HtmlSegment html_page_wifi_segments[] PROGMEM = {
+    {0, 51, HF_TXT_WIFI_TITLE},
+    {67, 46, HF_TXT_WIFI_HOST},
+    {128, 135, HF_UNIT_NAME},
+    {274, 12, HF_TXT_WIFI_SSID},
+    {301, 138, HF_SSID},
+    {445, 12, HF_TXT_WIFI_PSK},
+    {471, 75, HF_PSK},
+    {551, 12, HF_TXT_WIFI_OTAP},
+    {578, 142, HF_OTA_PWD},
+    {729, 65, HF_TXT_SAVE},
+    {804, 67, HF_TXT_BACK},
+    {881, 14, HF_NONE},
+};
+const HtmlTemplate html_page_wifi_template = {html_page_wifi, html_page_wifi_segments, sizeof(html_page_wifi_segments) / sizeof(HtmlSegment), html_field_texts};
+
+const HtmlSegment html_page_control_segments[] PROGMEM = {
+    {0, 4, HF_TXT_CTRL_CTEMP},
+    {20, 21, HF_ROOMTEMP},
+    {51, 69, HF_TXT_CTRL_TITLE},
+    {136, 52, HF_TXT_CTRL_TEMP},
+    {203, 33, HF_TEMP_SCALE},
+    {248, 232, HF_TEMP},
+    {486, 224, HF_TXT_CTRL_POWER},
+    {726, 89, HF_POWER_ON},
+    {825, 1, HF_TXT_F_ON},
+    {836, 29, HF_POWER_OFF},
+    {876, 1, HF_TXT_F_OFF},
+    {888, 35, HF_TXT_CTRL_MODE},
+    {938, 100, HF_MODE_A},
+    {1046, 9, HF_TXT_F_AUTO},
+    {1067, 29, HF_MODE_D},
+    {1104, 11, HF_TXT_F_DRY},
+    {1126, 30, HF_MODE_C},
+    {1164, 18, HF_TXT_F_COOL},
+    {1194, 30, HF_MODE_H},
+    {1232, 17, HF_TXT_F_HEAT},
+    {1261, 29, HF_MODE_F},
+    {1298, 10, HF_TXT_F_FAN},
+    {1319, 35, HF_TXT_CTRL_FAN},
+    {1368, 98, HF_FAN_A},
+    {1473, 9, HF_TXT_F_AUTO},
+    {1494, 31, HF_FAN_Q},
+    {1532, 11, HF_TXT_F_QUIET},
+    {1556, 27, HF_FAN_1},
+    {1590, 6, HF_TXT_F_SPEED},
+    {1609, 29, HF_FAN_2},
+    {1645, 6, HF_TXT_F_SPEED},
+    {1664, 29, HF_FAN_3},
+    {1700, 6, HF_TXT_F_SPEED},
+    {1719, 29, HF_FAN_4},
+    {1755, 6, HF_TXT_F_SPEED},
+    {1774, 29, HF_FAN_5},
+    {1810, 6, HF_TXT_F_SPEED},
+    {1829, 37, HF_TXT_CTRL_VANE},
+    {1881, 100, HF_VANE_H},
+    {1989, 2, HF_TXT_F_HOLD},
+    {2003, 31, HF_VANE_S},
+    {2042, 9, HF_TXT_F_SWING},
+    {2064, 35, HF_TXT_CTRL_WVANE},
+    {2115, 108, HF_WVANE_H},
+    {2232, 2, HF_TXT_F_HOLD},
+    {2246, 30, HF_WVANE_S},
+    {2285, 9, HF_TXT_F_SWING},
+    {2307, 75, HF_TXT_BACK},
+    {2392, 35, HF_MIN_TEMP},
+    {2437, 5, HF_MAX_TEMP},
+    {2452, 6, HF_TEMP_STEP},
+    {2469, 6, HF_HEAT_MODE_SUPPORT},
+    {2494, 5, HF_X50_PROTOCOL},
+    {2513, 38, HF_ASSET_VERSION},
+    {2566, 11, HF_NONE},
+};
+const HtmlTemplate html_page_control_template = {html_page_control, html_page_control_segments, sizeof(html_page_control_segments) / sizeof(HtmlSegment), html_field_texts};
+
+const HtmlSegment html_page_unit_segments[] PROGMEM = {
+    {0, 51, HF_TXT_UNIT_TITLE},
+    {67, 46, HF_TXT_UNIT_BEEP},
+    {128, 42, HF_BEEP_OFF},
+    {180, 2, HF_TXT_F_BEEP_OFF},
+    {198, 27, HF_BEEP_ON},
+    {234, 2, HF_TXT_F_BEEP_ON},
+    {251, 29, HF_TXT_UNIT_LED},
+    {294, 41, HF_LED_OFF},
+    {344, 2, HF_TXT_F_LED_OFF},
+    {361, 27, HF_LED_ON},
+    {396, 2, HF_TXT_F_LED_ON},
+    {412, 29, HF_TXT_UNIT_LANGUAGE},
+    {460, 28, HF_LANGUAGE_OPTIONS},
+    {506, 19, HF_TXT_UNIT_TEMP},
+    {540, 42, HF_TU_CEL},
+    {590, 1, HF_TXT_F_CELSIUS},
+    {606, 29, HF_TU_FAH},
+    {643, 1, HF_TXT_F_FH},
+    {654, 28, HF_TXT_UNIT_MINTEMP},
+    {700, 83, HF_MIN_TEMP},
+    {793, 12, HF_TXT_UNIT_MAXTEMP},
+    {823, 83, HF_MAX_TEMP},
+    {916, 12, HF_TXT_UNIT_STEPTEMP},
+    {947, 96, HF_TEMP_STEP},
+    {1054, 12, HF_TXT_UNIT_MODES},
+    {1082, 42, HF_MD_ALL},
+    {1132, 1, HF_TXT_F_ALLMODES},
+    {1149, 29, HF_MD_NONHEAT},
+    {1190, 1, HF_TXT_F_NOHEAT},
+    {1205, 28, HF_TXT_UNIT_UPDATE_INTERVAL},
+    {1259, 48, HF_UPDATE_5S},
+    {1318, 1, HF_TXT_F_5S},
+    {1329, 28, HF_UPDATE_15S},
+    {1369, 1, HF_TXT_F_15S},
+    {1381, 28, HF_UPDATE_30S},
+    {1421, 1, HF_TXT_F_30S},
+    {1433, 28, HF_UPDATE_45S},
+    {1473, 1, HF_TXT_F_45S},
+    {1485, 28, HF_UPDATE_60S},
+    {1525, 1, HF_TXT_F_60S},
+    {1537, 28, HF_TXT_UNIT_PASSWORD},
+    {1584, 75, HF_LOGIN_PASSWORD},
+    {1675, 65, HF_TXT_SAVE},
+    {1750, 75, HF_TXT_BACK},
+    {1835, 14, HF_NONE},
+};
+const HtmlTemplate html_page_unit_template = {html_page_unit, html_page_unit_segments, sizeof(html_page_unit_segments) / sizeof(HtmlSegment), html_field_texts};
+
+const HtmlSegment html_page_login_segments[] PROGMEM = {
+    {0, 26, HF_LOGIN_SUCCESS},
+    {41, 278, HF_TXT_LOGIN_TITLE},
+    {336, 217, HF_TXT_LOGIN_PASSWORD},
+    {573, 56, HF_TXT_LOGIN_PASSWORD},
+    {649, 67, HF_TXT_LOGIN},
+    {727, 102, HF_LOGIN_MSG},
+    {840, 6, HF_NONE},
+};
+const HtmlTemplate html_page_login_template = {html_page_login, html_page_login_segments, sizeof(html_page_login_segments) / sizeof(HtmlSegment), html_field_texts};
+
+const HtmlSegment html_page_upgrade_segments[] PROGMEM = {
+    {0, 132, HF_TXT_UPGRADE_TITLE},
+    {151, 95, HF_TXT_UPGRADE_INFO},
+    {264, 76, HF_TXT_UPGRADE_SHA256},
+    {360, 299, HF_TXT_B_UPGRADE},
+    {674, 62, HF_TXT_BACK},
+    {746, 70, HF_TXT_UPGRADE_START},
+    {835, 14, HF_NONE},
+};
+const HtmlTemplate html_page_upgrade_template = {html_page_upgrade, html_page_upgrade_segments, sizeof(html_page_upgrade_segments) / sizeof(HtmlSegment), html_field_texts};
+
+const HtmlSegment html_page_logging_segments[] PROGMEM = {
+    {0, 901, HF_TXT_LOGGING_TITLE},
+    {920, 126, HF_TXT_BACK},
+    {1056, 70, HF_TXT_UPGRADE_START},
+    {1145, 14, HF_NONE},
+};
+const HtmlTemplate html_page_logging_template = {html_page_logging, html_page_logging_segments, sizeof(html_page_logging_segments) / sizeof(HtmlSegment), html_field_texts};
+
+const HtmlSegment html_page_upload_segments[] PROGMEM = {
+    {0, 27, HF_UPLOAD_MSG},
+    {39, 42, HF_TXT_BACK},
+    {91, 14, HF_NONE},
+};
+const HtmlTemplate html_page_upload_template = {html_page_upload, html_page_upload_segments, sizeof(html_page_upload_segments) / sizeof(HtmlSegment), html_field_texts};
@@ -16,19 +16,7 @@
   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
-const char count_down_script[] PROGMEM = 
-"<script>"
-    "var count = 10;"
-    "(function countDown() {"
-        "document.getElementById('count').innerHTML = count + 's';"
-        "setTimeout(function() {"
-            "if(count > 0) {"
-                "count --;"
-                "return countDown();"
-            "} else {"
-                "window.location.href = '/';"
-            "}"
-        "}, 1000);"
-    "})();"
-"</script>"
-;
\ No newline at end of file
+#include "web_assets.h"
+
+// Script is served gzipped from web/countdown.js, the page only needs the tag.
+const char count_down_script[] PROGMEM = "<script src='/countdown.js?v=" WEB_ASSETS_VERSION "'></script>";
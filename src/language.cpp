@@ -0,0 +1,86 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "language.h"
+#include "logger.h"
+#include <rom/miniz.h>
+
+#define TAG "language"
+
+Language language;
+
+bool Language::select(const char *code)
+{
+  const LanguagePack *fallback = nullptr;
+  for (size_t i = 0; i < language_packs_count; i++)
+  {
+    if (strcmp(language_packs[i].code, code) == 0)
+      return load(language_packs[i]);
+    if (strcmp(language_packs[i].code, LANGUAGE_DEFAULT) == 0)
+      fallback = &language_packs[i];
+  }
+  LOGW(TAG, "Unknown language %s", code);
+  if (fallback != nullptr)
+    load(*fallback);
+  return false;
+}
+
+bool Language::load(const LanguagePack &candidate)
+{
+  if (pack == &candidate)
+    return true;
+
+  char *inflated = (char *)malloc(candidate.textSize);
+  // The inflate state is about 11 KB, too much for the stack of the task calling us
+  tinfl_decompressor *decompressor = (tinfl_decompressor *)malloc(sizeof(tinfl_decompressor));
+  bool ok = inflated != nullptr && decompressor != nullptr;
+  if (ok)
+  {
+    // The ROM has tinfl, no need to link an inflate implementation of our own
+    tinfl_init(decompressor);
+    size_t inSize = candidate.size;
+    size_t outSize = candidate.textSize;
+    tinfl_status status = tinfl_decompress(decompressor, candidate.data, &inSize, (uint8_t *)inflated, (uint8_t *)inflated, &outSize,
+                                           TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF);
+    ok = status == TINFL_STATUS_DONE && outSize == candidate.textSize;
+  }
+  free(decompressor);
+
+  // Index the texts, the pack has exactly one null terminated text per TextId
+  uint16_t index[TXT_COUNT];
+  size_t id = 0;
+  for (size_t i = 0; ok && i < candidate.textSize && id < TXT_COUNT; i++)
+  {
+    if (i == 0 || inflated[i - 1] == '\0')
+      index[id++] = i;
+  }
+  ok = ok && id == TXT_COUNT && inflated[candidate.textSize - 1] == '\0';
+  if (!ok)
+  {
+    LOGE(TAG, "Failed to load language %s", candidate.code);
+    free(inflated);
+    return false;
+  }
+
+  // Pages are rendered by the web task, which only starts once setup() has picked the language
+  free(texts);
+  texts = inflated;
+  memcpy(offsets, index, sizeof(offsets));
+  pack = &candidate;
+  Log.ln(TAG, "Language %s, %u bytes", candidate.code, (unsigned)candidate.textSize);
+  return true;
+}
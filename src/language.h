@@ -0,0 +1,41 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include "language_packs.h"
+
+// Web interface texts in the language picked on the Unit page. The packs are compressed in flash
+// (tools/language_packs.py), select() inflates one into RAM and indexes it, text() is then a lookup.
+class Language
+{
+public:
+  // Switches to the pack with this code, false (and the default language) for an unknown code.
+  bool select(const char *code);
+  const char *text(TextId id) const { return texts ? texts + offsets[id] : ""; };
+  const char *code() const { return pack ? pack->code : LANGUAGE_DEFAULT; };
+
+private:
+  const LanguagePack *pack = nullptr;
+  char *texts = nullptr;
+  uint16_t offsets[TXT_COUNT];
+
+  bool load(const LanguagePack &candidate);
+};
+
+extern Language language;
@@ -0,0 +1,572 @@
+// Generated by tools/language_packs.py from src/languages/*.h, do not edit.
+// Each pack is the null terminated texts of every TextId, in order, compressed with raw deflate.
+
+#pragma once
+
+#include <Arduino.h>
+
+enum TextId : uint8_t
+{
+  TXT_NONE = 0, // empty text, also marks template fields that are not a message
+  TXT_CONTROL,
+  TXT_SETUP,
+  TXT_STATUS,
+  TXT_FIRMWARE_UPGRADE,
+  TXT_REBOOT,
+  TXT_MQTT,
+  TXT_WIFI,
+  TXT_UNIT,
+  TXT_OTHERS,
+  TXT_LOGGING,
+  TXT_RESET,
+  TXT_RESET_CONFIRM,
+  TXT_BACK,
+  TXT_SAVE,
+  TXT_LOGOUT,
+  TXT_UPGRADE,
+  TXT_LOGIN,
+  TXT_F_ON,
+  TXT_F_OFF,
+  TXT_F_AUTO,
+  TXT_F_QUIET,
+  TXT_F_HEAT,
+  TXT_F_DRY,
+  TXT_F_COOL,
+  TXT_F_FAN,
+  TXT_F_SPEED,
+  TXT_F_SWING,
+  TXT_F_HOLD,
+  TXT_F_CELSIUS,
+  TXT_F_FH,
+  TXT_F_ALLMODES,
+  TXT_F_NOHEAT,
+  TXT_F_5S,
+  TXT_F_15S,
+  TXT_F_30S,
+  TXT_F_45S,
+  TXT_F_60S,
+  TXT_F_BEEP_ON,
+  TXT_F_BEEP_OFF,
+  TXT_F_LED_ON,
+  TXT_F_LED_OFF,
+  TXT_M_REBOOT,
+  TXT_M_RESET,
+  TXT_M_SAVE,
+  TXT_MQTT_TITLE,
+  TXT_MQTT_FN,
+  TXT_MQTT_HOST,
+  TXT_MQTT_PORT,
+  TXT_MQTT_USER,
+  TXT_MQTT_PASSWORD,
+  TXT_MQTT_TOPIC,
+  TXT_OTHERS_TITLE,
+  TXT_OTHERS_HAAUTO,
+  TXT_OTHERS_HATOPIC,
+  TXT_OTHERS_AVAILABILITY_REPORT,
+  TXT_OTHERS_STATE_HISTORY,
+  TXT_OTHERS_POWER_SAVE,
+  TXT_OTHERS_DEBUG,
+  TXT_OTHERS_LOG_LEVELS,
+  TXT_OTHERS_SYSLOG,
+  TXT_STATUS_TITLE,
+  TXT_STATUS_HVAC,
+  TXT_RETRIES_HVAC,
+  TXT_STATUS_MQTT,
+  TXT_STATUS_WIFI,
+  TXT_STATUS_RESET,
+  TXT_STATUS_CPU_IDLE,
+  TXT_STATUS_PROFILE,
+  TXT_STATUS_CONNECT,
+  TXT_STATUS_DISCONNECT,
+  TXT_WIFI_TITLE,
+  TXT_WIFI_HOSTNAME,
+  TXT_WIFI_SSID,
+  TXT_WIFI_PSK,
+  TXT_WIFI_OTAP,
+  TXT_CTRL_TITLE,
+  TXT_CTRL_TEMP,
+  TXT_CTRL_POWER,
+  TXT_CTRL_MODE,
+  TXT_CTRL_FAN,
+  TXT_CTRL_VANE,
+  TXT_CTRL_WVANE,
+  TXT_CTRL_CTEMP,
+  TXT_UNIT_TITLE,
+  TXT_UNIT_TEMP,
+  TXT_UNIT_MAXTEMP,
+  TXT_UNIT_MINTEMP,
+  TXT_UNIT_STEPTEMP,
+  TXT_UNIT_UPDATE_INTERVAL,
+  TXT_UNIT_MODES,
+  TXT_UNIT_PASSWORD,
+  TXT_UNIT_BEEP,
+  TXT_UNIT_LED,
+  TXT_UNIT_LANGUAGE,
+  TXT_LOGIN_TITLE,
+  TXT_LOGIN_PASSWORD,
+  TXT_LOGIN_SUCESS,
+  TXT_LOGIN_FAIL,
+  TXT_UPGRADE_TITLE,
+  TXT_UPGRADE_INFO,
+  TXT_UPGRADE_SHA256,
+  TXT_UPGRADE_START,
+  TXT_UPLOAD_NOFILE,
+  TXT_UPLOAD_FILETOOLARGE,
+  TXT_UPLOAD_FILEHEADER,
+  TXT_UPLOAD_FLASHSIZE,
+  TXT_UPLOAD_BUFFER,
+  TXT_UPLOAD_FAILED,
+  TXT_UPLOAD_ABORTED,
+  TXT_UPLOAD_SHA256_MISMATCH,
+  TXT_UPLOAD_CODE,
+  TXT_UPLOAD_ERROR,
+  TXT_UPLOAD_SUCESS,
+  TXT_UPLOAD_REFRESH,
+  TXT_INIT_TITLE,
+  TXT_INIT_REBOOT_MES,
+  TXT_INIT_REBOOT,
+  TXT_LOGGING_TITLE,
+  TXT_COUNT
+};
+
+struct LanguagePack
+{
+  const char *code;
+  const char *name;
+  const uint8_t *data;
+  uint16_t size;     // compressed
+  uint16_t textSize; // inflated, all texts with their terminating nulls
+};
+
+const uint8_t language_pack_da_DA[] PROGMEM = {
+    0x6d,0x55,0xef,0x6f,0xdb,0x38,0x0c,0xe5,0x9f,0xc2,0x7d,0x39,0xa4,0x40,0x2f,0xdd,0x6e,0xb7,0x61,0x77,
+    0xc0,0xe1,0x90,0xcb,0x8f,0x36,0x58,0x9a,0x64,0x4d,0xb2,0x62,0x1f,0x15,0x9b,0x76,0x84,0xc9,0x92,0x21,
+    0xc9,0x69,0xb3,0xbf,0xfe,0x9e,0xe5,0x24,0x4d,0xb1,0x01,0x01,0x62,0x53,0x24,0x45,0x3e,0x3e,0x3e,0xd3,
+    0x67,0x67,0xa3,0x77,0x86,0xa6,0x36,0x0f,0x51,0x1b,0xa3,0x6d,0x29,0x9e,0x56,0x51,0xc5,0x26,0xd0,0x44,
+    0xfb,0xea,0x49,0x79,0xe1,0x45,0x5d,0x7a,0x95,0x8b,0xc7,0x29,0xdd,0x8a,0x0d,0x51,0xf9,0x48,0xf7,0x5f,
+    0xd6,0x6b,0x7a,0x9c,0x4e,0xa6,0x34,0xb6,0x3b,0xc9,0x69,0xa4,0xf7,0xe2,0x83,0xd0,0xcc,0x95,0x65,0xeb,
+    0xf8,0x20,0x41,0x22,0x7f,0x77,0xb6,0xd0,0x65,0xe3,0x55,0xd4,0xce,0xd2,0xc8,0xf1,0xc1,0x35,0xec,0x45,
+    0x19,0x73,0xe0,0x27,0x65,0x23,0x47,0x87,0xd7,0xd6,0x33,0xee,0x74,0xe0,0xc6,0xea,0xf8,0x2f,0xad,0xb5,
+    0xd9,0xaa,0x52,0x70,0x57,0xc5,0xbf,0xf1,0xf9,0x46,0x64,0xe6,0x26,0x6f,0xab,0xf3,0x91,0xdd,0x45,0x4d,
+    0xb3,0xc5,0xed,0x74,0x4e,0x0b,0xfc,0x26,0x13,0x1a,0x6c,0xd6,0x0b,0xfa,0xb2,0x99,0x8e,0xd7,0x74,0x37,
+    0x1e,0xac,0x69,0xf4,0xf0,0x8d,0x86,0x8b,0xc5,0x8c,0x26,0x83,0x39,0xad,0x96,0xe3,0xf1,0x88,0x56,0x8f,
+    0xd3,0xf9,0x2d,0xdd,0x2d,0x66,0x23,0x1a,0x8a,0x09,0xba,0xed,0x55,0xed,0xbc,0xa0,0x0f,0x1d,0x69,0x60,
+    0x0c,0x57,0x2e,0x97,0xf0,0xf2,0xc4,0xf2,0x2c,0x99,0xd4,0x91,0x77,0xa2,0x22,0x7d,0xe0,0x20,0x99,0x03,
+    0x62,0xdc,0x93,0xe7,0x1a,0x25,0x54,0x62,0xa3,0x32,0x57,0xf4,0xee,0x7c,0x42,0xef,0xdf,0x9e,0x1f,0xff,
+    0x7c,0xb1,0x7e,0x7c,0xb1,0x1e,0xab,0x3d,0xfe,0x3d,0xc8,0xd6,0xb9,0x88,0x5e,0xfa,0xfd,0x3e,0x3f,0x48,
+    0x01,0x48,0x76,0xac,0x6d,0x07,0xe2,0xc9,0x3e,0x74,0xd6,0x4a,0x96,0x20,0x5b,0xad,0xa6,0x68,0x43,0xed,
+    0x71,0xc2,0xd9,0x25,0xc4,0xac,0x6c,0x0e,0x40,0x7f,0x9d,0xad,0x1d,0x19,0x2f,0x95,0x57,0x95,0x44,0xcc,
+    0x8a,0x26,0x5e,0x8b,0xcd,0x31,0x09,0x0b,0x0b,0xdd,0xb9,0x10,0x69,0xe9,0x80,0x6d,0x2f,0x97,0x42,0x35,
+    0x26,0xf2,0xbb,0x4f,0x9f,0xde,0x5f,0xd1,0x26,0x80,0x13,0x4b,0x15,0xc2,0x93,0xf3,0x39,0xad,0x5d,0xad,
+    0x33,0x5a,0xc4,0x1d,0x32,0x5c,0x26,0xbb,0x1b,0xf0,0xa0,0x89,0x2e,0xd7,0x21,0x73,0x60,0xc2,0xe1,0x27,
+    0x03,0xea,0x6e,0x23,0x5b,0xf3,0x5e,0x69,0xa3,0xb6,0xda,0xe8,0x78,0x40,0xb1,0x35,0xee,0x44,0xa7,0xb5,
+    0x51,0x07,0x76,0x45,0x01,0x12,0x0a,0x63,0xe2,0x11,0xb8,0xa3,0x55,0xd0,0x22,0xba,0x73,0xf4,0xd2,0x3d,
+    0x89,0xe7,0xa0,0xf6,0xc2,0xbd,0x47,0x3d,0xd1,0x69,0x3e,0x15,0x07,0x23,0x52,0x5f,0xe3,0x2f,0x1d,0xd7,
+    0xce,0x98,0x70,0x45,0x23,0xd9,0x36,0x65,0x62,0x8d,0x91,0x3d,0xe6,0xcc,0xbd,0xa8,0xca,0x7f,0xc4,0x7b,
+    0xe7,0x6f,0xc0,0x6b,0x7b,0xa3,0x6d,0xe1,0x6e,0xf2,0xd6,0xeb,0x26,0x7a,0x95,0xc9,0x15,0xad,0x0e,0x48,
+    0x51,0x62,0x48,0x1e,0x15,0x73,0x6f,0x07,0x48,0xfe,0x6e,0xcb,0xbb,0x66,0xa9,0x6a,0x14,0x5b,0x38,0xcf,
+    0xd6,0xd9,0xd6,0xb3,0xdb,0x91,0xbb,0xaf,0x83,0x21,0x5f,0x3e,0x1f,0x87,0xd4,0x8e,0xe2,0x41,0x22,0x00,
+    0x0e,0x1d,0xec,0x47,0x9f,0x76,0x61,0xf8,0x01,0xe3,0xa3,0x99,0x0a,0xb1,0xa3,0x3e,0x0d,0x97,0x1b,0xd6,
+    0xb9,0x11,0x5a,0x1d,0x23,0x0d,0x9a,0xb7,0xd9,0x01,0xbc,0x9d,0xcf,0xc7,0xc3,0x35,0x28,0x3b,0x9a,0xbe,
+    0x3c,0xa7,0x1c,0x97,0xc8,0xa3,0xca,0x34,0xc1,0xc4,0x8a,0xe5,0xea,0x33,0x2d,0xd6,0x03,0x3e,0x0f,0x6c,
+    0xd8,0xed,0x38,0x6f,0xb0,0x5b,0xb4,0x46,0x1f,0x02,0xaa,0x34,0x5e,0x3a,0x2c,0xe9,0x1e,0x00,0x82,0xfe,
+    0x96,0xbe,0x2a,0x2b,0xf4,0xa8,0x73,0xe1,0xf4,0x34,0x6c,0x3c,0x36,0x02,0x6c,0xbb,0x88,0x68,0x53,0xbc,
+    0xe6,0xdb,0x65,0xc2,0xb4,0xbd,0x74,0xaf,0x9e,0x75,0xd5,0xd8,0x57,0x71,0xf7,0xda,0xfe,0x64,0x43,0xe0,
+    0x29,0x2e,0x44,0xa9,0x69,0x53,0xe7,0xe8,0x1a,0x34,0x45,0x4f,0x7b,0x65,0x52,0x5d,0x1c,0x9a,0x3a,0xb1,
+    0xe3,0x51,0xb6,0x5c,0x9f,0x1a,0xfa,0x0f,0xb3,0xa6,0x19,0x80,0x98,0x29,0x5b,0x36,0xad,0x50,0x80,0x67,
+    0x3b,0xd4,0xaa,0xb3,0xae,0xa6,0x73,0xeb,0x98,0xbd,0xb6,0x48,0x92,0x65,0x12,0x42,0xd1,0x98,0xeb,0x24,
+    0x3f,0x4f,0x10,0x3a,0xde,0x0a,0xc0,0xcf,0xb5,0x6f,0x17,0x0a,0x3e,0x85,0x3c,0x9d,0x56,0xb3,0x4f,0x8f,
+    0xde,0x61,0xaf,0x1a,0xb0,0xa0,0x85,0xf5,0xe6,0x74,0xf1,0x1b,0x8e,0xe0,0xa1,0x2a,0x95,0xb6,0x7d,0x94,
+    0x9b,0xf4,0xe7,0x42,0x24,0x81,0x79,0xd3,0x19,0x79,0x7b,0xe0,0x6d,0x9b,0x54,0x1b,0x80,0x52,0x1b,0xa7,
+    0xa0,0x5a,0x77,0x83,0xdf,0xff,0xf8,0xf0,0x91,0x7b,0xae,0x6e,0x6b,0x6c,0xe5,0x62,0x93,0x4e,0x38,0x89,
+    0x1b,0x04,0x74,0xee,0xba,0x80,0x20,0x06,0x45,0xc1,0x30,0x49,0x6f,0xfa,0x07,0x40,0x09,0xa0,0x84,0x87,
+    0x34,0x43,0x25,0x15,0x76,0xbc,0xdb,0x1f,0x9c,0x62,0xb5,0xe1,0x52,0x83,0xbb,0x9d,0x77,0xa5,0x4a,0x9d,
+    0xb5,0x2a,0x05,0x65,0xe4,0xdc,0x61,0x83,0xac,0x8b,0xdd,0x0d,0x68,0x3b,0xee,0xf8,0xed,0xf3,0xf8,0xaf,
+    0xce,0xb5,0x30,0x0a,0xaa,0xf0,0xab,0xf4,0xb9,0xec,0x75,0x76,0xe9,0xd0,0x05,0x74,0x8d,0xf0,0xb6,0x29,
+    0x0a,0x78,0x56,0xed,0x5a,0x57,0xb5,0x6a,0x59,0xd1,0x1d,0x14,0x28,0x4a,0xf2,0x3e,0x8f,0x6d,0x2a,0xcd,
+    0x74,0xdf,0x01,0xee,0xfa,0xe5,0xf7,0x69,0x77,0x2a,0xe7,0xdb,0x11,0xe3,0xb1,0xea,0x46,0x75,0x8c,0x55,
+    0x5b,0x97,0x30,0x38,0xa1,0x74,0x2e,0x1d,0x6e,0xd9,0x0e,0x65,0x49,0xc2,0xe6,0x9a,0x4b,0x17,0x4f,0x31,
+    0x69,0x91,0xc1,0x46,0xe0,0x7d,0x22,0xcf,0x85,0xa9,0x17,0x80,0x4c,0x67,0xf6,0xfd,0xac,0xae,0xaf,0x98,
+    0x5e,0x78,0x40,0x17,0xa2,0x38,0x05,0x69,0xb5,0x32,0x80,0x3d,0x36,0xf5,0x8b,0x10,0x27,0x21,0xcd,0x8e,
+    0xcb,0x8c,0xd7,0x98,0x3e,0x5d,0x9e,0x93,0xe8,0x58,0x89,0x20,0xc4,0xf7,0x37,0xfc,0x0d,0x74,0x0a,0x3b,
+    0xd7,0x18,0x8c,0x11,0xf7,0x61,0x3b,0x0c,0xe4,0x4a,0xf2,0x96,0x52,0x68,0x3a,0x45,0xa8,0x74,0x2b,0x44,
+    0x09,0xd4,0xee,0xbf,0x52,0xfa,0xf3,0xb7,0xf2,0x7f,
+};
+
+const uint8_t language_pack_en_GB[] PROGMEM = {
+    0x6d,0x55,0xef,0x6f,0x1a,0x39,0x10,0xf5,0x9f,0x32,0xfd,0x72,0x22,0x52,0x4a,0xda,0xcb,0xb5,0xea,0x9d,
+    0x74,0x3a,0x51,0x7e,0x14,0x24,0x02,0x34,0x40,0x50,0x3f,0x9a,0xdd,0xd9,0xc5,0xaa,0xd7,0x5e,0xd9,0x5e,
+    0x08,0xfd,0xeb,0xfb,0xec,0x05,0x42,0xae,0x95,0x90,0x58,0xdb,0x33,0xe3,0x37,0x6f,0xde,0x8c,0x45,0xdf,
+    0x9a,0xe0,0xac,0x16,0x4b,0x0e,0x4d,0x2d,0x96,0x41,0x86,0xc6,0x8b,0x91,0x72,0xd5,0x41,0x3a,0xa6,0x75,
+    0x5d,0x3a,0x99,0xb3,0x78,0xe4,0xad,0xb5,0x41,0x3c,0x7c,0x5d,0xad,0xc4,0x66,0x32,0x9a,0x88,0xb5,0x51,
+    0x41,0xcc,0xc3,0x8e,0x9d,0x17,0x53,0x5b,0x96,0xca,0x94,0x30,0xf2,0x1c,0x28,0xb3,0xa6,0x50,0x65,0xe3,
+    0x64,0x50,0xd6,0x88,0x81,0xa5,0xa3,0x6d,0xc8,0xb1,0xd4,0xfa,0x48,0x07,0x69,0x02,0x05,0x8b,0x65,0xb4,
+    0x0c,0x3b,0xe5,0xa9,0x41,0xa0,0xff,0xc4,0x67,0x99,0x7d,0x17,0x4b,0xb9,0x67,0xfa,0x83,0x4e,0x77,0x21,
+    0xaa,0x6d,0x42,0x44,0xe4,0x02,0x35,0x27,0x1c,0xd3,0xf9,0x97,0xc9,0x4c,0xcc,0xf1,0x1b,0x8d,0x44,0x6f,
+    0xbd,0x9a,0x8b,0xaf,0xeb,0xc9,0x70,0x25,0xc6,0xc3,0xde,0x4a,0x0c,0x1e,0xbf,0x89,0xfe,0x7c,0x3e,0x15,
+    0xa3,0xde,0x4c,0x2c,0x17,0xc3,0xe1,0x40,0x2c,0x37,0x93,0xd9,0x17,0x31,0x9e,0x4f,0x07,0xa2,0xcf,0xda,
+    0xab,0x98,0x9b,0xdc,0x39,0x36,0x3b,0x06,0xfe,0x9e,0xd6,0x54,0xd9,0x9c,0xfd,0xcb,0x17,0xf1,0x73,0xc6,
+    0x75,0xa0,0x1d,0xcb,0x20,0x3e,0x90,0x67,0xa4,0x93,0x7b,0xea,0xf0,0x73,0xcd,0x4e,0x55,0x6c,0x82,0xd4,
+    0x37,0xe2,0xfd,0xe5,0x44,0xdc,0xbf,0xbb,0x7c,0xfe,0xf5,0xb2,0xfb,0xf1,0x65,0xf7,0x04,0xf6,0xf4,0xd7,
+    0x26,0x07,0xb6,0xba,0xdd,0x2e,0x32,0x2d,0xc0,0xc4,0x8e,0x94,0x69,0xb9,0x3b,0xef,0xa3,0x26,0x86,0xb3,
+    0xc4,0xd4,0x72,0x39,0x19,0x44,0x62,0x70,0xf2,0x9a,0x59,0x92,0x26,0x07,0x8f,0xbf,0x8f,0x16,0xeb,0x44,
+    0x0b,0xe9,0x64,0xc5,0x21,0x56,0x68,0xe4,0x14,0x9b,0x1c,0x05,0x30,0xd8,0x11,0x63,0xeb,0x83,0x58,0x58,
+    0xd0,0xda,0xc9,0xb9,0x90,0x8d,0x0e,0xf4,0xfe,0xd3,0xa7,0xfb,0x1b,0xb1,0xf6,0xec,0xc4,0x42,0x7a,0x7f,
+    0xb0,0x2e,0x17,0x2b,0x5b,0xab,0xec,0x54,0xe3,0xeb,0x60,0xe3,0x1e,0xf5,0x9a,0x60,0x73,0xe5,0x33,0xbb,
+    0x67,0x77,0xfc,0x65,0x03,0xb8,0xa3,0x67,0xdc,0xde,0x4b,0xa5,0xe5,0x56,0x69,0x15,0x8e,0x00,0x5b,0xe3,
+    0x4e,0x64,0x5a,0x6b,0x79,0x24,0x5b,0x14,0x5a,0x19,0x26,0x0f,0xc5,0x81,0x76,0xa4,0x0a,0x35,0x04,0x7b,
+    0xf1,0x5e,0xd8,0x03,0x3b,0xf2,0x51,0x12,0x9d,0x8d,0x1a,0xa9,0x54,0x9e,0x8a,0xbc,0x66,0xae,0x6f,0xf1,
+    0x97,0x8e,0x6b,0xab,0xb5,0xbf,0x11,0x03,0xde,0x36,0x65,0x14,0x0c,0x69,0xde,0xa3,0xcc,0xd4,0x09,0xb2,
+    0xfc,0x97,0x9d,0xb3,0xee,0x0e,0x32,0x36,0x77,0xca,0x14,0xf6,0x2e,0x8f,0x56,0x77,0xc1,0xc9,0x8c,0x6f,
+    0xc4,0xf2,0x88,0x10,0x25,0x8a,0xe4,0x80,0x98,0x3a,0x3b,0x50,0xf2,0x4f,0x84,0x77,0x4b,0x5c,0xd5,0x00,
+    0x5b,0x58,0x47,0xc6,0x9a,0x68,0xd9,0xb6,0xc4,0xf8,0xa9,0xd7,0xa7,0xeb,0xef,0x53,0x91,0x62,0x29,0x1e,
+    0x39,0x80,0x60,0xdf,0xd2,0x7e,0xb2,0x89,0x5d,0x42,0x8f,0x28,0x9f,0x98,0x4a,0x1f,0x5a,0xc5,0x8b,0xfe,
+    0x62,0x4d,0x2a,0xd7,0x8c,0x6e,0x6b,0x3d,0x35,0x92,0x37,0xd9,0x11,0xb2,0x9d,0xcd,0x86,0xfd,0x15,0x14,
+    0x3b,0x98,0x2c,0x5f,0x16,0x29,0xc8,0x35,0xf5,0x80,0x99,0x4a,0xb8,0x51,0x6f,0x41,0x49,0x12,0x47,0xfb,
+    0x79,0xa9,0xda,0x7c,0xd5,0x7b,0x59,0x9c,0x9a,0x9b,0x52,0xb7,0xae,0x90,0x19,0x43,0x3c,0x8d,0xe3,0x96,
+    0x5d,0xf1,0x00,0x4a,0xd1,0x0f,0x46,0x3c,0xb1,0x0b,0x2a,0x93,0x9a,0x9e,0xa4,0x89,0xfa,0x70,0xea,0x87,
+    0x8d,0x4a,0x6f,0xd7,0xfd,0xc6,0xa1,0x63,0x20,0xc7,0xab,0x00,0x31,0xe2,0xff,0x5a,0xfd,0x2a,0x7e,0xea,
+    0x6a,0xf1,0x20,0x9f,0x55,0xd5,0x54,0xaf,0xfc,0x1e,0x94,0xf9,0x65,0xef,0xda,0xd1,0x07,0xae,0xc5,0xba,
+    0xce,0xc1,0x0b,0x84,0x8c,0xa4,0xf7,0x52,0x27,0x9c,0xe4,0x9b,0x3a,0xe9,0x67,0xc3,0x5b,0xaa,0xcf,0x09,
+    0x7e,0x86,0x1a,0xc4,0x14,0x4c,0x4d,0xa5,0x29,0x1b,0x59,0xb2,0x80,0x12,0x77,0x00,0x8b,0x6c,0x12,0xa8,
+    0x0b,0x15,0x50,0x87,0x32,0x08,0x92,0x65,0xec,0x7d,0xd1,0xe8,0xdb,0x34,0x97,0x0e,0x0a,0x8d,0xbf,0x65,
+    0x94,0x27,0x57,0x0e,0x35,0xe1,0x1c,0xb7,0x92,0xa4,0x82,0x0f,0xe7,0x06,0xee,0x8a,0x8d,0xb3,0xe8,0xbe,
+    0x06,0x5a,0x89,0xdc,0xdf,0x9d,0x2f,0x7f,0x43,0x2b,0xa8,0x55,0x96,0x52,0x99,0xae,0x38,0x0f,0xca,0xcb,
+    0xe4,0x8c,0x75,0x38,0x4d,0x2d,0xda,0x1e,0x69,0x8b,0xb0,0x85,0xd2,0x60,0xa6,0xd6,0x56,0xe6,0x62,0x39,
+    0xee,0xbd,0xfd,0xf3,0xc3,0x47,0xea,0xd8,0x3a,0xe2,0x8c,0x43,0x65,0x9d,0x4e,0x62,0x43,0x38,0xe0,0x10,
+    0x33,0xdb,0x3a,0x78,0xd6,0x09,0x18,0x42,0xc7,0x95,0xfa,0x01,0x62,0x3c,0x84,0xe3,0x4a,0x08,0x37,0xec,
+    0x24,0xe0,0xb6,0x5d,0x86,0x53,0x0c,0x00,0x98,0xd4,0x50,0x78,0x6b,0x5d,0xc9,0x52,0x65,0x71,0x96,0xe5,
+    0xb0,0xcd,0x2d,0xfa,0xcc,0xd8,0xd0,0xde,0x80,0xd4,0xc3,0x8e,0xde,0x3d,0x0f,0xff,0x6e,0x4d,0x0b,0x2d,
+    0x31,0x3b,0x7e,0x17,0x3e,0xe7,0xbd,0xca,0xae,0x0d,0x5a,0x87,0x36,0x11,0xda,0x36,0x45,0x01,0xcb,0x2a,
+    0x36,0x7f,0x55,0xcb,0x28,0x8d,0xf6,0xa0,0x00,0x28,0xce,0xbb,0x34,0x34,0x09,0x9a,0x6e,0x1f,0x09,0x6a,
+    0xf3,0xa5,0xfb,0xd4,0x61,0x95,0x75,0xb1,0xcc,0xf8,0xac,0xda,0x72,0x9d,0x7c,0xe5,0xd6,0x26,0x0e,0xce,
+    0x2c,0x5d,0xa0,0xc3,0x2c,0xdb,0x01,0x16,0x27,0x6e,0x6e,0xa9,0xc4,0x43,0x71,0xf2,0x49,0xed,0x0e,0x49,
+    0x82,0xef,0xb3,0x80,0xae,0xb6,0x3a,0x9e,0xe3,0x6b,0x16,0xb7,0x5d,0x37,0xab,0xeb,0x1b,0x12,0xcb,0x8b,
+    0x16,0xc4,0xd5,0xe8,0x9c,0x40,0xb9,0x0a,0xca,0xf7,0xe9,0x3d,0xbc,0x8c,0xeb,0x34,0x6e,0xb3,0x53,0xcb,
+    0x63,0x19,0xd2,0xbb,0xe6,0x28,0x8d,0x26,0xc3,0x01,0x82,0xf8,0xfe,0x86,0xbe,0x41,0x52,0x7e,0x67,0x1b,
+    0x8d,0x32,0xe2,0x3e,0xb4,0x88,0xc6,0x50,0x6b,0x45,0x85,0xa4,0x93,0x87,0x4c,0xb7,0x62,0x74,0x41,0xde,
+    0xdd,0x57,0xef,0xc1,0xe5,0x21,0xfd,0x09,
+};
+
+const uint8_t language_pack_es_ES[] PROGMEM = {
+    0x95,0x56,0x6d,0x6e,0xdb,0x46,0x10,0xdd,0xa3,0x4c,0xfe,0xc9,0x80,0x6b,0x27,0x75,0x13,0xa4,0x05,0x8a,
+    0x82,0xb5,0xa4,0x48,0xa8,0x22,0x39,0x96,0xec,0xa0,0x3f,0x57,0xe4,0x90,0x5a,0x80,0xdc,0x65,0x76,0x97,
+    0x8e,0xed,0xdb,0xf8,0x00,0xf9,0x11,0xe4,0x06,0xf5,0xc5,0xfa,0x86,0xa4,0x65,0xda,0x4d,0x0b,0x14,0xb0,
+    0x4c,0xee,0xc7,0xcc,0xce,0xcc,0x7b,0xf3,0x96,0xea,0xd4,0xd9,0xe8,0x5d,0xa9,0xf0,0xcc,0x4d,0xd1,0x78,
+    0x9d,0x9a,0xfb,0x6f,0x56,0x4d,0x42,0xd4,0x99,0x53,0x49,0x1a,0x1b,0x5d,0x9a,0x5b,0xcc,0x3a,0x4b,0x19,
+    0x53,0x6e,0x7c,0xf5,0x59,0x7b,0x56,0xe7,0x6c,0xac,0x49,0x8d,0xf6,0xea,0xfd,0x87,0xcd,0x46,0x7d,0x9c,
+    0x4f,0xe7,0x2a,0xa9,0xb5,0xd7,0xd1,0xa9,0x15,0x3c,0x06,0xb5,0x70,0x45,0x61,0x6c,0x81,0x9d,0xf0,0xb5,
+    0x2d,0x39,0x65,0x4f,0x69,0x77,0x1a,0x5c,0xfb,0xee,0x44,0x5f,0x69,0x4f,0xfe,0x61,0x87,0xa9,0x0c,0xdb,
+    0xe8,0xe4,0xa0,0xc1,0xce,0xdf,0xd4,0xa5,0x2b,0xaf,0xd8,0xab,0x77,0x8d,0xf6,0x19,0xf6,0xdf,0xc0,0xe2,
+    0xe1,0xf4,0x35,0xc2,0x13,0x5f,0x15,0xdb,0x5b,0x2c,0xe9,0xc7,0x80,0x25,0x8d,0xc5,0xea,0xdd,0x7c,0xa9,
+    0x56,0xf8,0x9b,0x4e,0x55,0x72,0xb1,0x59,0xa9,0x0f,0x17,0xf3,0xc9,0x46,0xcd,0x26,0xc9,0x46,0x8d,0xcf,
+    0xff,0x54,0xa7,0xab,0xd5,0x42,0x4d,0x93,0xa5,0x5a,0x9f,0x4d,0x26,0x63,0xb5,0xfe,0x38,0x5f,0xbe,0x53,
+    0xb3,0xd5,0x62,0xac,0x4e,0xb9,0x0c,0xa6,0x09,0x6a,0xaa,0x77,0x9e,0xed,0x8e,0x4d,0x54,0x1b,0x97,0xb9,
+    0x40,0x25,0x7e,0x95,0xbc,0x3d,0x1f,0x13,0x5f,0xa7,0x5c,0x23,0xfc,0x54,0x97,0xc8,0xef,0x35,0x05,0x46,
+    0x16,0x59,0xa0,0x11,0x5f,0xd7,0xec,0x0d,0x42,0x8c,0xba,0x3c,0x50,0xaf,0x64,0xa5,0x68,0xac,0xb8,0x38,
+    0x79,0xf9,0xf8,0xfe,0xd3,0x60,0xfe,0xcd,0x60,0xbe,0x0f,0xbf,0x7f,0x3c,0x14,0x1e,0x4b,0x47,0x47,0x47,
+    0x74,0xce,0x39,0xca,0x97,0xca,0x90,0xd8,0x3e,0x16,0x1b,0x85,0xec,0x36,0xac,0x9d,0xe5,0x34,0xb6,0xeb,
+    0x9a,0xd6,0xeb,0xf9,0xb8,0x2f,0xa3,0x4c,0xa4,0x4f,0x40,0x27,0xcc,0xed,0x2b,0x3b,0x74,0xbf,0xf7,0x7e,
+    0x06,0x7c,0x2b,0x16,0x74,0xa9,0x45,0x7d,0xe9,0xaa,0xad,0x67,0xd2,0x95,0x29,0xe4,0x50,0xb5,0x66,0x7f,
+    0x65,0x04,0xdb,0xb3,0x86,0x3d,0x0a,0x31,0x7a,0xf5,0xf6,0xed,0x09,0xd5,0xce,0x03,0xd1,0x1c,0x51,0xb8,
+    0x03,0x75,0x11,0x70,0xba,0x71,0xaa,0xe5,0x9d,0x0e,0x7c,0xff,0x55,0xa3,0x8e,0xb5,0x49,0x3b,0xd6,0x10,
+    0x28,0x74,0x7f,0xd7,0x9d,0xa1,0x66,0x09,0x25,0x4d,0x74,0x99,0x09,0xa9,0x03,0xfe,0x37,0xff,0x98,0xa0,
+    0xd8,0x5a,0xca,0xf4,0x95,0x36,0xa5,0xde,0x9a,0xd2,0x44,0x61,0x07,0x8e,0x8c,0xa8,0x45,0x5d,0xea,0x1b,
+    0x72,0x79,0x5e,0x1a,0xcb,0x84,0xc2,0x44,0x0e,0x30,0xa1,0x9d,0x09,0xd1,0xed,0xad,0xcf,0xdc,0x67,0x30,
+    0x33,0xe8,0x2b,0xa6,0xd1,0x47,0x33,0x35,0x02,0x26,0x57,0x14,0x4a,0xe6,0xfa,0x10,0x8f,0x76,0xb9,0x76,
+    0x65,0x19,0x0e,0xd4,0x98,0xb7,0x4d,0x21,0xcc,0xa6,0x92,0xaf,0x40,0x10,0x1a,0x45,0x5d,0xfc,0xca,0xde,
+    0x3b,0x7f,0x8c,0xb6,0xb0,0xc7,0xc6,0xe6,0xee,0x38,0x93,0x5d,0xc7,0x48,0x2f,0xe5,0x03,0xb5,0xbe,0x81,
+    0x8b,0x02,0x68,0x7a,0x44,0x4c,0xa3,0x9d,0x0b,0xf1,0x17,0x09,0xef,0x90,0xb8,0xaa,0x11,0x6c,0x8e,0xea,
+    0x58,0x60,0x74,0xf0,0xd0,0x73,0xdd,0x83,0x66,0x97,0xc9,0xa9,0x92,0x7f,0x84,0x52,0x09,0x84,0xd2,0x81,
+    0xe7,0x28,0x8c,0xe1,0xf0,0xb0,0x67,0xdf,0x7a,0x74,0x0e,0x64,0xd5,0x42,0x87,0x28,0xcd,0xc4,0x51,0x9d,
+    0x9e,0x5d,0x90,0xc9,0x5a,0x48,0x3a,0xcb,0x12,0xc9,0xdb,0xf4,0x06,0x84,0x5f,0x2e,0x27,0xa7,0x9b,0x64,
+    0xbc,0x52,0xe3,0xc9,0x1a,0xa3,0x7e,0x30,0x80,0xb6,0xed,0xe5,0x19,0xe2,0xb4,0x98,0x51,0x2d,0x65,0xce,
+    0xd6,0x7f,0x0c,0x11,0xa3,0xd5,0x26,0x51,0xbd,0x72,0x00,0xda,0x92,0x74,0xdf,0xf9,0x1b,0xe4,0xc4,0x78,
+    0x03,0xa5,0xba,0xba,0xaa,0xf7,0xe8,0x0c,0x75,0x09,0xe6,0x9b,0xae,0xeb,0x93,0x92,0xa3,0x26,0x94,0x22,
+    0x1a,0xb4,0x49,0x3f,0xdc,0x39,0x6f,0x6e,0x9d,0x74,0xc7,0xd0,0x43,0xdf,0xcc,0x43,0x69,0x6a,0x45,0xe8,
+    0xbb,0xc7,0xfd,0xeb,0x7c,0x75,0x7f,0x77,0x6d,0x2a,0xfd,0x6c,0xee,0x8b,0x95,0xb9,0x4b,0x50,0xb1,0xe7,
+    0x3e,0x24,0x27,0x0e,0x82,0x9f,0xdb,0x08,0xc0,0xd0,0xc7,0xb2,0xf0,0x4c,0x54,0xde,0xb7,0xcd,0x1e,0x9c,
+    0xa0,0xa8,0xa5,0x41,0x87,0x95,0x31,0x62,0x98,0xeb,0x5b,0xf5,0x3b,0xe8,0xa3,0x16,0xd0,0x94,0x85,0xb6,
+    0x45,0xa3,0x0b,0x56,0xa0,0xae,0xd4,0x21,0x47,0xe2,0x9d,0xa3,0x61,0x0f,0x3c,0x5f,0x44,0x6f,0x7a,0x2f,
+    0x8d,0x0b,0x9e,0x58,0xd0,0x2f,0x95,0x23,0x7b,0x45,0x10,0x32,0xdd,0xdf,0x05,0x40,0x9d,0x19,0x6f,0x0a,
+    0x74,0xdc,0x91,0xfa,0xeb,0xae,0xef,0xac,0x4e,0x39,0xf7,0xd1,0x20,0x07,0xac,0x87,0x17,0x24,0x19,0x49,
+    0x85,0xdb,0x8c,0x6c,0xc3,0x57,0x30,0x4a,0x9e,0x26,0xb6,0x1f,0x7a,0x9a,0xf6,0x3a,0x2f,0x48,0x53,0x85,
+    0x73,0x34,0xcc,0x29,0x34,0x5b,0x93,0xe9,0xee,0x1e,0x48,0x77,0xec,0x1d,0x6d,0x8d,0x55,0xeb,0x59,0xf2,
+    0xc3,0x8f,0xaf,0xdf,0xd0,0xc8,0xd5,0x42,0x35,0x91,0xb8,0xa7,0x8e,0xa9,0x93,0x94,0x4c,0xab,0x25,0x2e,
+    0x84,0xc6,0x0e,0xad,0x91,0x8b,0xa8,0x15,0xcc,0x84,0xfa,0xe5,0x7e,0x09,0x9d,0x5a,0xe9,0x1b,0xf4,0xc6,
+    0xa7,0x86,0x09,0xd0,0x72,0xa8,0x05,0x7f,0x42,0xef,0xd7,0xce,0x1a,0x51,0x9b,0x85,0x86,0xd2,0x6e,0xe5,
+    0x5e,0xe9,0xd0,0x7f,0x30,0xb5,0x52,0x03,0xb9,0x49,0x6e,0xb5,0x14,0x83,0x5e,0x5e,0x4f,0x7e,0xfe,0x7f,
+    0xae,0xa5,0xe4,0x15,0x57,0x60,0xa5,0xa6,0xbc,0xd4,0x61,0x27,0xe6,0xdb,0x26,0x67,0x11,0xb2,0xef,0x54,
+    0x01,0x1e,0x45,0x03,0x2c,0x3b,0xb5,0xee,0x16,0x73,0x5d,0xa2,0xee,0xfa,0x88,0x66,0x9d,0x28,0x69,0x72,
+    0x75,0x4b,0xdf,0x13,0xb1,0xcb,0xb8,0xde,0x8b,0xae,0x50,0x16,0xf1,0x04,0x12,0xe9,0xc0,0x75,0xd8,0x41,
+    0xd1,0xbb,0xd1,0xdb,0x96,0x63,0x7a,0x5f,0xe3,0xcc,0xe1,0x2c,0xeb,0x22,0x2c,0x62,0xba,0xa3,0xb8,0x93,
+    0x20,0x4a,0x3e,0xa4,0xc2,0xa1,0xe9,0xef,0xbf,0x65,0xa6,0x68,0x01,0x6e,0x25,0xe9,0x31,0xd8,0xff,0x58,
+    0xa2,0x51,0x65,0x3c,0x10,0x47,0xca,0x17,0x75,0x06,0x95,0xf0,0x47,0x69,0x5d,0x1f,0x10,0x6e,0xd6,0x68,
+    0x42,0x0e,0xee,0x3b,0xd1,0x6b,0x5c,0x04,0x8f,0xd7,0x0c,0x3d,0xfb,0x5c,0xe8,0x01,0x2e,0x87,0x97,0x13,
+    0x6e,0xe9,0x74,0x78,0xf5,0x84,0x46,0xf8,0x4a,0xa2,0xb0,0x2f,0x08,0x3a,0x0a,0x0a,0x7f,0x69,0x85,0xa0,
+    0x85,0xe0,0x53,0x63,0xea,0xd6,0x33,0xb6,0xd5,0x4d,0xff,0x0d,0xa0,0xd3,0x94,0x03,0x68,0xfa,0xf4,0xca,
+    0xdb,0x7f,0x58,0xfc,0x0d,
+};
+
+const uint8_t language_pack_fr_FR[] PROGMEM = {
+    0x8d,0x56,0x4d,0x6f,0xe3,0x36,0x10,0xe5,0x4f,0x99,0x5e,0x1a,0x07,0x48,0x9c,0xdd,0x6e,0x77,0xb1,0x2d,
+    0x50,0x14,0xae,0x2d,0x37,0x06,0xfc,0x91,0xc6,0x76,0xb6,0x57,0x46,0x1a,0xcb,0x2c,0x28,0x52,0x4b,0x52,
+    0x4e,0x9c,0x5f,0xd3,0xab,0x7b,0xee,0xa9,0x97,0x1e,0xfc,0x4b,0xfa,0x4f,0xfa,0x28,0xd9,0x5e,0x39,0x87,
+    0xa2,0x40,0x12,0xd3,0x24,0x87,0x33,0xf3,0xe6,0xcd,0x9b,0x88,0xbe,0x35,0xc1,0xed,0xff,0xd4,0x2c,0xb0,
+    0x5a,0xa9,0xbc,0x72,0x32,0x28,0x6b,0x44,0x12,0x64,0xf0,0x62,0xa2,0x3c,0xd3,0xfe,0x77,0xfa,0xcd,0x56,
+    0x4e,0xdc,0x73,0xb6,0xdf,0x15,0xd2,0x39,0x99,0xb3,0x98,0xfc,0xb2,0x58,0x88,0x4f,0xa3,0xe1,0x48,0x2c,
+    0x8d,0x0a,0xfb,0x9d,0xe8,0x55,0xc1,0xb1,0x17,0x63,0x9b,0xe7,0xca,0xe4,0xb8,0x5c,0x1c,0x6c,0x5f,0xf6,
+    0x3b,0x67,0xc5,0x83,0xad,0x34,0xbf,0x5c,0x6f,0x6c,0xe5,0x69,0xe3,0xa4,0x2a,0xd8,0x04,0x72,0x5c,0x70,
+    0x80,0xd9,0xe9,0xda,0x8f,0xb0,0x0b,0xd1,0xd7,0x5c,0x56,0x1b,0xce,0xa5,0xcb,0x98,0xbe,0xa6,0x33,0xc7,
+    0x83,0xfd,0x2e,0xb5,0xc6,0xf0,0x73,0x8c,0x72,0x2c,0x4d,0xca,0x8e,0xb4,0xa4,0xa2,0x1d,0x69,0x82,0x9c,
+    0xd8,0x89,0x5e,0x1a,0xd4,0x06,0xa1,0xc1,0xc4,0xcb,0xc3,0xba,0xb7,0x5c,0xcc,0xc4,0x7c,0x34,0x4e,0xa6,
+    0xfd,0x51,0xb2,0xfc,0x55,0xf4,0x6f,0x7b,0xcb,0x81,0x98,0x27,0x7d,0x31,0xbc,0x9f,0x8d,0x06,0xe2,0x21,
+    0x99,0x2e,0x46,0xe3,0x71,0x6f,0x31,0x9a,0x4d,0xc5,0xc3,0x68,0x91,0xcc,0xe7,0x89,0x98,0xcc,0x96,0x0f,
+    0xc9,0x04,0x27,0xe2,0x76,0x36,0x1e,0x88,0x3e,0x6b,0x5f,0x79,0x31,0x94,0x6b,0xc7,0x66,0xcd,0x2a,0x88,
+    0xbe,0x56,0x05,0xb9,0xfd,0x6e,0xc3,0xce,0xab,0x47,0x80,0x09,0x50,0x3e,0x57,0x5c,0x27,0x99,0xe2,0x0c,
+    0x98,0x7a,0x46,0x60,0xef,0xc9,0x33,0xa2,0xcf,0xd8,0x53,0x87,0x9f,0x4b,0x76,0x35,0x0e,0x52,0x5f,0x8a,
+    0xb7,0x5f,0x8e,0xc4,0xbb,0x37,0x5f,0xd6,0xdf,0xb6,0xf6,0x3f,0xb4,0xf6,0x11,0xdd,0x6c,0x38,0x3c,0x7e,
+    0xb4,0x11,0xea,0x76,0xbb,0x74,0x2f,0x57,0xc0,0x38,0x5d,0xc3,0x6b,0x1d,0x43,0x26,0x8d,0x7f,0x5d,0x92,
+    0x78,0xaf,0x1f,0x91,0x4c,0x03,0x20,0xac,0x0b,0x23,0x2b,0x9a,0xcf,0x01,0x42,0x0b,0x7d,0xfc,0x00,0xdd,
+    0xb4,0xcd,0x0d,0xe2,0x58,0xb9,0xff,0xe1,0xf0,0x4e,0x3a,0x59,0xec,0x77,0x91,0x17,0x54,0xf3,0x65,0x6a,
+    0x0b,0x92,0xab,0x15,0xee,0xc5,0x4a,0x64,0xd8,0x47,0x3c,0x9e,0xdd,0x26,0x62,0x73,0x67,0x5d,0xa0,0x0e,
+    0x9e,0x5d,0xc9,0x2a,0xd0,0xdb,0x8f,0x1f,0xdf,0x5d,0x8a,0x65,0x50,0x5a,0x79,0x19,0xe2,0xf9,0xc4,0x86,
+    0x18,0x4d,0x29,0x61,0x24,0x16,0xb6,0x54,0xe9,0x81,0x73,0xd4,0xf2,0x23,0x6e,0x7b,0x54,0x33,0x04,0x09,
+    0xb8,0xc0,0xc8,0x28,0xd8,0x88,0x3e,0x8a,0x11,0x8f,0x6a,0xb3,0xff,0xba,0xd0,0xdb,0x48,0xa5,0xe5,0x23,
+    0xbc,0x86,0x2d,0x92,0x2c,0x11,0x13,0x70,0x2b,0xb5,0xdc,0x92,0x5d,0xad,0xb4,0x32,0x88,0x17,0x9d,0x01,
+    0xa7,0xc1,0x12,0xb2,0x0d,0xd6,0x6d,0xb1,0x8c,0xc1,0xdc,0xd9,0x27,0xe0,0xe8,0xe5,0x86,0xa9,0xf3,0x49,
+    0x0d,0x15,0x15,0x36,0xe3,0x82,0xbc,0x66,0x2e,0xaf,0xf0,0x51,0x1f,0x97,0x56,0x6b,0x7f,0x29,0x06,0xfc,
+    0x58,0xe5,0xb1,0x57,0x48,0xf3,0x06,0x6c,0xa2,0x4e,0x90,0xf9,0x0f,0xec,0x9c,0x75,0x37,0x4f,0xd2,0x99,
+    0x1b,0x65,0x56,0xf6,0x26,0x8b,0xb7,0x6e,0x82,0x93,0x29,0x5f,0x8a,0xf9,0x16,0x4f,0xe4,0x0d,0x5a,0x8e,
+    0x3a,0x6b,0xeb,0xc3,0xf7,0x31,0xbc,0x2b,0xe2,0xa2,0x44,0xb0,0x2b,0xeb,0xc8,0x58,0x83,0x9b,0x4d,0xeb,
+    0xc6,0xbf,0x74,0xfb,0xd0,0xeb,0x8b,0xf8,0xe7,0x58,0xe9,0x58,0x3e,0xb4,0x98,0x53,0x7c,0xb8,0x71,0xea,
+    0x63,0xba,0x47,0xe9,0xd1,0x50,0x3e,0x16,0xd7,0x33,0x38,0x7d,0xb7,0x24,0x95,0x81,0xcb,0xf3,0x83,0x9d,
+    0x46,0xde,0x26,0xdd,0x8a,0xfe,0x6c,0x3a,0x4d,0xfa,0x8b,0x44,0x0c,0x92,0xd3,0xb2,0x5d,0xea,0x5a,0x15,
+    0x62,0xa9,0x51,0xad,0x42,0x82,0x13,0x06,0x6f,0x44,0x5a,0xf5,0x35,0xaf,0xa8,0x44,0x9b,0x5c,0x97,0xd2,
+    0x21,0x61,0x90,0x60,0xb6,0xe8,0x01,0xa7,0x56,0x61,0x4f,0x7a,0x74,0xd6,0x37,0x0b,0xe4,0x08,0xce,0xca,
+    0x50,0x39,0x16,0x3d,0xdd,0x74,0x4d,0xad,0x53,0x13,0x80,0x2c,0x1e,0xf0,0x55,0xe9,0x86,0x26,0x3d,0xa5,
+    0xa1,0x29,0x48,0xef,0xb8,0xa0,0xb5,0x75,0xea,0xc5,0xc6,0x36,0xe3,0xb3,0x87,0x88,0x0d,0x88,0x5d,0x39,
+    0x5f,0xb7,0xef,0xc1,0xd5,0x39,0xd5,0x8f,0xe2,0x76,0x66,0x56,0xc8,0x67,0x55,0x54,0xe6,0xd5,0xa6,0x32,
+    0xf5,0xe6,0xcf,0x4e,0x66,0x55,0xd3,0x26,0xa1,0x1d,0xf4,0xc8,0xa0,0xcb,0x36,0x52,0xeb,0xba,0xa5,0xce,
+    0xd4,0x2a,0xa6,0xe0,0x29,0x53,0xbe,0xb4,0xa6,0x16,0x8f,0x36,0xd3,0xe9,0x89,0x1f,0xc5,0x4f,0xa0,0x90,
+    0x18,0x27,0x83,0xa8,0x77,0x79,0x15,0x55,0x10,0xcc,0x5f,0xc7,0xa4,0xd1,0x4b,0x47,0x1c,0x5a,0x20,0x9e,
+    0x4e,0x9b,0xc3,0xa8,0x4c,0x95,0xf7,0x8a,0xaf,0x0e,0x6d,0x8e,0x28,0x5e,0x68,0xff,0x47,0x54,0x5e,0x34,
+    0xb2,0x72,0x0a,0xa5,0xa8,0x5b,0x96,0xd0,0x06,0x1a,0xbf,0xfe,0x24,0x34,0x5d,0x31,0x81,0x18,0x48,0xe5,
+    0xcf,0xca,0xf4,0x15,0x25,0xde,0xcb,0x2d,0x88,0x88,0x24,0x4c,0xec,0x25,0x59,0x75,0xcf,0xa7,0x45,0xfb,
+    0x0b,0x8c,0x1c,0xd0,0xde,0x58,0x45,0xd9,0x45,0x65,0x28,0x2a,0x80,0x82,0xf1,0xa3,0x32,0x62,0x7e,0xdb,
+    0xbb,0xfe,0xe6,0xfd,0x07,0xea,0xd8,0x32,0xc6,0x1a,0xb5,0xf0,0xcc,0x54,0x43,0xe2,0xf7,0x3b,0x06,0xc3,
+    0x7c,0x74,0x7f,0x34,0xf5,0xfb,0x9d,0x6e,0x78,0x69,0x50,0x9f,0xe1,0x61,0xb7,0xd4,0x48,0x2f,0x77,0xb6,
+    0x4e,0x84,0xf4,0x05,0xfb,0x12,0xcd,0xd3,0xc6,0x16,0xa3,0xe1,0x9f,0xbf,0xfe,0x0e,0xb1,0x8a,0x79,0x6c,
+    0x7a,0xca,0xaa,0xd3,0x9b,0x78,0x3e,0xb5,0x05,0xb8,0x95,0xd6,0x69,0xd6,0x51,0xbf,0x79,0x4e,0xbe,0x03,
+    0xec,0x14,0xa0,0x0b,0xfa,0x28,0x87,0x2b,0x2d,0xfd,0xba,0x6d,0xc9,0xe8,0x9a,0xda,0xb7,0x96,0x2e,0xe7,
+    0xc6,0xf9,0xe9,0x5a,0x0c,0x64,0xbf,0xfb,0x5c,0xa9,0xb2,0xd6,0x46,0x91,0x38,0x17,0x89,0xd6,0x78,0x83,
+    0x0f,0x80,0x8b,0x1a,0xe1,0xb5,0x20,0x8b,0x32,0xae,0x2e,0x0e,0x50,0x9d,0xde,0x3f,0x99,0x34,0x27,0xdc,
+    0xa5,0x7a,0xb4,0xc5,0xc9,0x87,0x52,0x41,0x16,0x3c,0x35,0xe8,0xd1,0x3b,0x28,0x4c,0x75,0xc0,0x21,0xbb,
+    0x88,0x2a,0xe2,0x8a,0xc3,0x40,0xaf,0x2d,0x49,0x1a,0x53,0x69,0x20,0x76,0x84,0x3d,0xb3,0x78,0xc1,0xa0,
+    0xb4,0xb8,0x96,0xae,0x09,0xbc,0x81,0x53,0x0d,0xa6,0xe4,0x16,0x12,0x60,0xe3,0x04,0xb8,0xe0,0x33,0xef,
+    0xf4,0x7a,0xfb,0x9c,0xce,0xd4,0x01,0xc9,0x94,0xa3,0x65,0x99,0xa1,0x21,0x5d,0x37,0x2d,0xcb,0x4b,0x12,
+    0xf7,0x0d,0x03,0xbb,0x02,0x83,0xa2,0x99,0x13,0xad,0x41,0x41,0xe8,0x0e,0x15,0x94,0xac,0xa5,0x3e,0xc6,
+    0xda,0x1e,0x67,0x71,0xda,0x9c,0x06,0x7e,0x74,0xb2,0xb1,0x91,0xb7,0x51,0x64,0xba,0x34,0xbe,0x90,0x25,
+    0x10,0x64,0xa5,0x91,0x88,0x0a,0x54,0x7f,0x93,0x2a,0x5e,0xa8,0x1f,0x6e,0xee,0x82,0xfe,0x1e,0x04,0x7d,
+    0x3d,0x25,0x4f,0xff,0xab,0xfc,0x0b,
+};
+
+const uint8_t language_pack_it_IT[] PROGMEM = {
+    0x8d,0x56,0xd1,0x6e,0x1b,0x37,0x10,0xe4,0xa7,0x6c,0x5e,0x1a,0x19,0x70,0xe4,0xa4,0x69,0x82,0xb4,0x40,
+    0x51,0x28,0xb2,0x05,0x0b,0x71,0x2c,0xd5,0x67,0x27,0xcf,0xf4,0xdd,0x9e,0xb4,0x00,0x8f,0x3c,0x90,0xbc,
+    0x73,0xec,0xaf,0xe9,0x63,0xff,0x23,0x3f,0xd6,0x21,0xef,0x2c,0x4b,0x4e,0x51,0xf4,0x45,0x96,0x97,0x5c,
+    0x72,0x77,0x66,0x76,0x28,0x35,0x77,0x8d,0xb6,0x95,0xa8,0x65,0xd3,0xba,0x10,0xf5,0x83,0x38,0x2b,0xaa,
+    0x88,0x3a,0x3a,0x35,0xdb,0x6c,0xc4,0x79,0xab,0x1b,0xb6,0xd1,0xd1,0x42,0x7c,0x73,0xa7,0x3d,0xab,0x2b,
+    0xd1,0x7d,0x2f,0x4e,0x7d,0xfe,0xf3,0xfa,0x5a,0x7d,0x95,0x57,0x0b,0x51,0x37,0x56,0xe2,0xf7,0xbf,0xd4,
+    0xcc,0x44,0x2f,0xd4,0x6a,0x8f,0x14,0x7c,0x53,0x17,0x0e,0x27,0xd8,0x8d,0xba,0xe2,0xc0,0x91,0x4a,0x67,
+    0x6b,0xd9,0x74,0x3e,0xdf,0xc1,0xaa,0x60,0xa1,0x20,0x65,0xe7,0x1d,0x55,0x42,0xbd,0x33,0xec,0xc9,0xa7,
+    0x8d,0x11,0x97,0x90,0x79,0xd9,0xe5,0x33,0xff,0x50,0x4b,0x54,0x87,0xd3,0x9c,0x2a,0xb4,0xe9,0x35,0xfd,
+    0x44,0xc3,0xfd,0x3a,0x9d,0xee,0xba,0xa8,0x66,0xe9,0x1f,0xd2,0xfb,0xb5,0xa6,0x25,0xb1,0x6a,0x56,0x96,
+    0x1c,0x90,0xd7,0xe6,0xd8,0xac,0x8b,0x68,0x35,0x4a,0x89,0x88,0x18,0xb6,0xa8,0x02,0x8b,0x57,0x12,0x4a,
+    0x6d,0xaa,0x31,0xef,0x94,0xbb,0x46,0x2a,0xa9,0xa5,0x44,0xff,0x68,0x75,0xee,0x70,0x79,0x2a,0x77,0x5c,
+    0xff,0x82,0x4f,0x31,0x63,0x03,0x5f,0xd8,0xb8,0x32,0xf7,0xbd,0x0a,0xa5,0x98,0xc7,0xf0,0xf9,0xea,0xe2,
+    0x54,0xcd,0xd9,0x04,0xe9,0x82,0x5a,0xe8,0xad,0x67,0xbb,0x65,0x89,0xea,0xba,0x8b,0x11,0x7d,0x31,0x35,
+    0xae,0xd2,0x26,0xe7,0xfd,0x18,0x22,0x0e,0xa5,0xe9,0x82,0x23,0x7f,0x50,0xd7,0x3b,0x0a,0x5c,0xa6,0x5a,
+    0x68,0xc2,0xdf,0x5a,0xf6,0x92,0xc2,0xda,0x1c,0xa9,0x37,0xbb,0x15,0xf5,0xf6,0xf5,0xee,0xeb,0x2f,0x4f,
+    0xd1,0xf7,0x4f,0xd1,0xd5,0xa5,0x5a,0x2d,0x16,0x8f,0x7f,0x46,0x16,0xa7,0xd3,0x29,0x5d,0x71,0x0d,0xe0,
+    0xb7,0x04,0xc8,0x06,0xa6,0xc4,0x82,0x2c,0x1f,0xf2,0x22,0x20,0xb0,0xe0,0x84,0x7d,0x10,0xd2,0xc6,0xbc,
+    0x2c,0x8a,0xe5,0xe9,0x40,0x45,0xcc,0x98,0x3f,0xa3,0x95,0x18,0xa5,0xff,0xdb,0xc9,0xeb,0x47,0x55,0x50,
+    0xd6,0xcd,0xa5,0x6b,0x98,0x6a,0xdd,0x88,0x91,0xa4,0xa9,0x73,0x68,0x4f,0xad,0x9d,0x8f,0x9a,0x26,0x15,
+    0xd7,0xba,0x33,0x91,0xde,0x7c,0xf8,0xf0,0xf6,0x48,0xdd,0x04,0xf6,0x48,0x0e,0xe1,0xce,0xf9,0x4a,0x5d,
+    0xbb,0x56,0xca,0x43,0x9d,0x65,0xa5,0x9d,0xcf,0x28,0xf1,0x5b,0x01,0x35,0xd7,0xb3,0xbf,0xff,0x21,0x40,
+    0x31,0x67,0xa6,0x70,0xaf,0x41,0xe1,0x2d,0x2e,0x8e,0xf7,0x10,0x5c,0x8b,0x4b,0xd1,0x76,0x6b,0xf4,0x3d,
+    0xb9,0xba,0x36,0x82,0x1e,0x30,0x07,0x91,0x03,0x52,0x68,0x2b,0x01,0x42,0x78,0xcc,0x5e,0xbb,0x3b,0x88,
+    0x34,0xe8,0x9e,0x69,0xf2,0x55,0x16,0x92,0x78,0xe3,0x86,0x82,0x61,0x6e,0x8f,0xf1,0x27,0x2f,0xb7,0xce,
+    0x98,0x70,0x04,0x29,0xdd,0x76,0x9b,0x24,0x44,0xf0,0xdb,0x43,0x0d,0x34,0x01,0x5e,0xbf,0xb3,0xf7,0xce,
+    0x9f,0x60,0x8c,0xec,0x89,0xd8,0xda,0x9d,0x54,0x69,0xd7,0x49,0xf4,0xba,0xe4,0x23,0x55,0xdc,0xe3,0x88,
+    0x0d,0xf8,0xf2,0xa8,0x98,0x26,0x5b,0x60,0xf2,0x5b,0x2a,0xef,0x98,0xb8,0x69,0x51,0x6c,0xed,0x3c,0x59,
+    0x60,0x7c,0x34,0xce,0x67,0xfe,0xa4,0xf3,0x2f,0xb3,0xb9,0x4a,0x1f,0x03,0x55,0x65,0x04,0x0d,0x00,0x1e,
+    0xa8,0x70,0x18,0xb7,0x0c,0x93,0xba,0x5c,0x2c,0xe9,0x0a,0xf4,0xa9,0x0b,0x1d,0xe2,0x30,0x6a,0x6a,0xbe,
+    0xbe,0x21,0xa9,0x4c,0x9a,0xc6,0x21,0xd1,0xa0,0x73,0x5b,0xde,0xab,0xf9,0xea,0xf2,0xf2,0xac,0x28,0x56,
+    0xea,0x74,0x59,0xec,0xbe,0x3f,0x71,0x98,0x0e,0xcb,0xa4,0xa5,0xc9,0x50,0x59,0x13,0xeb,0xe2,0xd3,0x8e,
+    0x27,0x5a,0x5d,0xcf,0xd2,0xf0,0x60,0x6c,0x8d,0x71,0x34,0xda,0xc3,0x35,0xda,0x60,0xaf,0x23,0xb4,0x02,
+    0x0a,0x07,0x0d,0x0f,0x33,0xf3,0x79,0x37,0x12,0x07,0x13,0xb6,0x3f,0x57,0x04,0x4c,0x30,0xbc,0xda,0x3c,
+    0x0b,0x3b,0x2f,0x0f,0x0f,0x2e,0x4d,0x03,0xef,0x5f,0x40,0x3a,0xc6,0x2e,0xc5,0xe6,0x87,0xf2,0x1c,0x5c,
+    0x65,0x34,0x2c,0x8a,0x7b,0x15,0xed,0x27,0x37,0xe8,0x43,0x9a,0x67,0x31,0xb1,0x29,0x54,0x44,0x6e,0x0f,
+    0xf2,0x96,0x16,0xc3,0xd1,0xeb,0xd4,0x27,0xe6,0xf3,0xd0,0x87,0x76,0x7d,0x51,0xe8,0xda,0x44,0x25,0xd0,
+    0x7d,0x02,0xe9,0x2b,0xdf,0xaa,0x8f,0x90,0x8e,0xba,0x38,0x3b,0x05,0x29,0x76,0xd3,0xe9,0x0d,0x27,0x9f,
+    0x4a,0x18,0x94,0x23,0x06,0x3b,0xe9,0x67,0x4f,0x23,0x8c,0x16,0x5b,0x08,0xfb,0x38,0xe1,0xe1,0xb5,0x80,
+    0x47,0xb1,0x15,0x27,0x10,0x12,0xd3,0x50,0x12,0x04,0x58,0x6e,0xe5,0x71,0xea,0xa7,0x79,0x80,0x52,0x3d,
+    0x27,0xed,0xe3,0xbd,0x29,0x31,0xca,0x0b,0x18,0x69,0xeb,0x5d,0xaf,0xb1,0xa5,0xdd,0x78,0x5d,0xf1,0x33,
+    0xc3,0xaf,0x47,0xc3,0x4f,0x64,0xa6,0x83,0x1b,0x81,0x59,0x75,0xad,0x71,0xba,0xa2,0x8a,0x0d,0xd6,0xe1,
+    0x5c,0xb7,0x62,0xa7,0xaa,0x38,0x9f,0xbd,0xfa,0xf9,0xdd,0x7b,0x9a,0xb8,0x36,0x89,0x28,0x19,0xd3,0x5c,
+    0x7b,0xb4,0x30,0x1c,0x94,0xed,0x1a,0x68,0x5c,0x72,0x08,0x9d,0x1d,0xf2,0x02,0x1b,0xce,0xc6,0x9a,0xdc,
+    0x5a,0x03,0x39,0x6c,0x0d,0x99,0xa1,0xdd,0xd1,0xdf,0xff,0x06,0x0f,0xb9,0xa2,0x1c,0x04,0xbe,0xa1,0x4d,
+    0xa0,0x60,0x73,0x68,0xf1,0x4a,0x61,0x84,0x59,0x5d,0xbc,0xdc,0x32,0x4a,0xf7,0x4f,0x69,0x98,0x10,0xf8,
+    0x0d,0x5c,0x5b,0x27,0x6b,0xa2,0xd7,0xdf,0xce,0x7e,0xfd,0xbf,0x37,0xfc,0xb0,0x2b,0xdf,0x14,0x24,0x4a,
+    0xef,0xd4,0xc7,0xae,0xae,0xc7,0x7b,0xca,0xbd,0xe6,0xf2,0x41,0x19,0x51,0x77,0xd0,0x74,0x0d,0x45,0x48,
+    0x74,0x53,0x9a,0x65,0xab,0xd1,0x78,0xd1,0x5c,0x3b,0x68,0x10,0x32,0x49,0x73,0xfe,0x96,0xa0,0x21,0x82,
+    0xd3,0x81,0x3d,0xa8,0x98,0x92,0x21,0xf8,0x66,0x7c,0x81,0x0f,0xf0,0xb3,0xb6,0x43,0x71,0x69,0xe2,0x47,
+    0xa0,0x2b,0x07,0x7b,0xb2,0x2e,0xa2,0xfc,0x58,0x6e,0x29,0x6e,0x39,0xd7,0x71,0x4c,0x1b,0x17,0xd5,0x59,
+    0xf2,0x98,0x7c,0xcb,0x7e,0x9d,0x25,0xbc,0xb0,0x64,0xfa,0xef,0xd5,0x49,0xcf,0x58,0xb8,0x69,0x2b,0xe8,
+    0xd4,0x4f,0xcb,0xb6,0x3d,0x22,0x55,0x74,0xe9,0x19,0x4d,0x4f,0xe5,0x93,0x99,0x17,0x1c,0xbb,0x76,0x44,
+    0xd9,0xec,0x7e,0x11,0xc0,0xfb,0xcb,0x64,0x41,0x61,0x00,0x50,0x27,0x40,0x31,0x84,0x90,0x28,0x84,0x93,
+    0xfc,0xf2,0x05,0x9d,0xba,0x1e,0x67,0x44,0xbc,0xf7,0x0c,0xd2,0x40,0xa9,0xcd,0xb0,0x1b,0xd8,0xac,0xce,
+    0xd0,0xc6,0xce,0x51,0x7e,0xb7,0x03,0xad,0x9d,0xd8,0x38,0xdd,0x7b,0xa8,0x76,0xbf,0x27,0xfe,0x01,
+};
+
+const uint8_t language_pack_ja_JP[] PROGMEM = {
+    0x8d,0x56,0x5b,0x53,0xdb,0x46,0x14,0xde,0x9f,0xb2,0x7d,0x83,0x99,0x14,0x92,0xa6,0xc9,0xa4,0x9d,0xe9,
+    0x74,0x28,0x84,0xc2,0x94,0x86,0x14,0x92,0x32,0x7d,0x14,0xf6,0x62,0x34,0x15,0x5a,0x8f,0x24,0x42,0xfc,
+    0x66,0x49,0x09,0x18,0x8c,0x63,0xae,0x4e,0x42,0x4c,0x48,0x88,0x31,0x97,0xc4,0x40,0x87,0x24,0x98,0xfb,
+    0x8f,0x59,0xaf,0x6c,0x3f,0xe5,0x2f,0xf4,0xec,0x5a,0xd8,0x80,0xdd,0xcb,0x83,0xad,0x5d,0xed,0x9e,0x73,
+    0xbe,0x3d,0xe7,0x3b,0xdf,0x0a,0x31,0x67,0x83,0x39,0xab,0xcc,0xd9,0x63,0xee,0x9e,0x37,0x9f,0x28,0x9c,
+    0xa4,0x51,0x69,0x23,0xc7,0xb7,0x97,0x10,0x73,0x0e,0x98,0x3b,0xce,0xdc,0x63,0xe6,0x9c,0xc1,0x18,0x31,
+    0x77,0x91,0x39,0x6f,0xc5,0xdc,0x7d,0xc3,0x9c,0x2c,0x73,0xd6,0xc1,0xd0,0x7b,0xf5,0xd1,0x4b,0xed,0x22,
+    0x3e,0x9e,0x28,0x7d,0xda,0xe7,0xf1,0x45,0xf4,0xeb,0x6f,0x0f,0x1e,0xa0,0x81,0xee,0xce,0x6e,0x74,0xc9,
+    0x73,0xfa,0x43,0xe1,0x64,0x1e,0x31,0x7b,0x99,0xd9,0xdb,0x85,0xa3,0x14,0xea,0xa1,0xa1,0x90,0xaa,0x87,
+    0x10,0x8f,0x2d,0x7b,0xe9,0x15,0x3e,0x9d,0x42,0x1d,0x14,0x47,0xe8,0x28,0x36,0x88,0xa2,0x69,0x11,0x3c,
+    0xa6,0xe8,0x16,0xb6,0x28,0x4c,0x4d,0x02,0x83,0x61,0xd5,0xc4,0xa3,0xba,0x6a,0xfd,0x88,0xbc,0xd8,0x11,
+    0x73,0xe2,0xa8,0x70,0xb6,0xcc,0x73,0x2f,0x98,0xfd,0x9c,0xd9,0xd9,0x5a,0x70,0xe6,0xe6,0x98,0xb3,0x2b,
+    0xa3,0x66,0x99,0x1b,0x43,0x62,0xe4,0xba,0xcc,0x7d,0xce,0xdc,0x09,0x09,0x3c,0x56,0x4e,0xc5,0xf9,0x7a,
+    0x1c,0xf5,0xf4,0xfe,0xdc,0x7d,0x0f,0x96,0xb7,0x00,0x5b,0xe5,0xb1,0x88,0x4a,0x13,0x5b,0xc2,0x47,0x79,
+    0xf9,0x25,0xf2,0x96,0x52,0x5e,0xec,0x0c,0x95,0x5f,0x66,0xbc,0x83,0x33,0x38,0xdc,0xbe,0x9c,0x45,0xed,
+    0xf2,0xea,0x06,0x82,0x5f,0x39,0xba,0x22,0xb3,0xe3,0x64,0xc0,0x1c,0x02,0xa2,0xae,0xde,0x9e,0x0e,0xe4,
+    0xcd,0x3a,0xde,0x6e,0x12,0x95,0x92,0x3b,0xe2,0xc1,0x9f,0x6e,0x00,0x34,0x38,0xad,0xb7,0xb9,0x52,0x72,
+    0x4f,0x7c,0x97,0x85,0xa3,0x35,0x9e,0x49,0xc1,0xdb,0xab,0xcb,0xb7,0x8a,0xeb,0x73,0xb8,0x89,0x3c,0x0e,
+    0x13,0x43,0x1d,0x21,0xba,0xa5,0x68,0xcd,0xe8,0x86,0x78,0x89,0x6e,0x5e,0x17,0xff,0xdf,0xca,0xf1,0x6d,
+    0x39,0xee,0xbd,0x87,0x7a,0x3b,0x3b,0xcf,0x1f,0xd5,0xd3,0x17,0xf2,0xb9,0x5a,0x3a,0x61,0xd2,0xd2,0xd2,
+    0x82,0xfb,0xfb,0xbb,0x3b,0x98,0xfd,0xde,0x7b,0xb6,0x56,0xfc,0xbc,0x54,0xc9,0x16,0xb3,0x93,0xcc,0x7e,
+    0xc3,0xec,0x45,0x66,0x3f,0xf1,0x4b,0xcd,0x9c,0xb9,0x5a,0x3e,0xa3,0xf6,0x25,0x8f,0xa2,0x9e,0xe7,0x84,
+    0x00,0x02,0xb8,0x1f,0xc4,0x91,0xdd,0x49,0xe6,0x42,0xce,0x8e,0xf9,0x4c,0x02,0xde,0xbe,0x92,0x4c,0x81,
+    0x6c,0xbb,0xcb,0x95,0x24,0x7f,0x39,0x8e,0xf9,0x40,0xa2,0x19,0x7c,0xe3,0xce,0x9d,0x9b,0x5f,0x8e,0x27,
+    0x61,0x35,0x2b,0xb9,0xf4,0xb9,0x6a,0x37,0x2b,0xed,0x76,0xa4,0x8d,0x58,0x8f,0x31,0x77,0x41,0x94,0xcb,
+    0xd9,0xa9,0x11,0xc5,0x0f,0xdd,0xd5,0x56,0xa9,0x8e,0x97,0x49,0xf3,0x89,0xc3,0x2b,0xd3,0x4b,0x96,0x3c,
+    0xb9,0x53,0x5c,0xd8,0xf0,0xa2,0xeb,0x12,0xaa,0x0f,0x08,0xf5,0x91,0xb0,0xa6,0x44,0x30,0x1d,0x1a,0xd2,
+    0x54,0x9d,0x60,0xd3,0x52,0x2c,0x62,0x0a,0x7e,0x01,0xb1,0x2c,0x6a,0x44,0x60,0x18,0x56,0x03,0xe8,0x3e,
+    0x1d,0x23,0x06,0x36,0x95,0x47,0x04,0x37,0x0d,0xa8,0x9d,0x2a,0x1e,0xa1,0x41,0x32,0x82,0x4d,0x8d,0x90,
+    0xf0,0x35,0x78,0xc8,0xe5,0x30,0xd5,0x34,0xb3,0x19,0x49,0x4a,0xcd,0xc8,0xa8,0xbb,0x82,0xce,0x58,0x23,
+    0x8f,0x88,0x66,0xe2,0x26,0x4b,0x09,0xfd,0x40,0x0c,0x83,0x1a,0xad,0x63,0x8a,0xa1,0xb7,0xaa,0xfa,0x10,
+    0x6d,0x0d,0x92,0xc1,0xd1,0x50,0xab,0x65,0x28,0x01,0xd2,0x8c,0xfa,0x23,0xe0,0x29,0x84,0x4d,0x62,0x3c,
+    0x02,0x77,0x4d,0xc3,0xd4,0xb4,0xbe,0x0f,0x53,0xc3,0xba,0x86,0xc9,0x48,0xd8,0x8a,0xe0,0x21,0x6a,0x60,
+    0x9d,0xea,0xb0,0xb3,0xae,0x05,0xeb,0x5b,0xaa,0xeb,0xf7,0xb6,0x76,0xdc,0x4e,0x75,0x9d,0x04,0x2c,0x95,
+    0xea,0xb8,0x8f,0x58,0x86,0x4a,0xcc,0x5a,0x1f,0xe2,0x3e,0x20,0x01,0xea,0x51,0x4c,0xab,0xd2,0x4c,0xa8,
+    0xfd,0xfe,0x43,0xac,0x06,0x35,0x82,0xfa,0x7d,0x13,0x0d,0x92,0xa1,0x07,0x22,0xa8,0xc2,0x92,0x0a,0x8d,
+    0x26,0xbc,0x54,0x4e,0x8c,0x84,0x87,0x6a,0xf9,0xfd,0x42,0x8b,0xea,0x09,0x62,0xa1,0xfb,0xfd,0xbf,0xa0,
+    0xde,0x07,0x6d,0x75,0x95,0xfc,0x27,0x49,0xf1,0xf2,0x9b,0xfc,0x30,0x8b,0xca,0xaf,0x8e,0xbc,0xc3,0x19,
+    0x54,0xb6,0xe3,0xa5,0x23,0xe8,0xcf,0x55,0xdf,0x4c,0x34,0xd6,0x44,0x12,0x15,0xf2,0x53,0x85,0x7c,0x1c,
+    0x26,0x7c,0x66,0x16,0xf1,0xfd,0x2c,0x4f,0xee,0xf9,0x93,0x62,0xf2,0x94,0xa7,0x37,0x44,0xf3,0x6c,0x67,
+    0xc0,0x55,0x83,0x6c,0xf8,0x48,0x2b,0x71,0x78,0xe2,0x45,0xe1,0x24,0x81,0xbc,0x74,0xb4,0xfc,0xfe,0xc5,
+    0x25,0x00,0xf0,0xaa,0x70,0xf2,0xec,0xd2,0xab,0x8b,0x13,0xdf,0xb0,0x91,0x78,0xcc,0x97,0x97,0x16,0x10,
+    0xdf,0x39,0xe5,0x67,0x69,0xbf,0x71,0x07,0xc8,0xe0,0xd5,0xf3,0xff,0x04,0x6c,0x41,0x3d,0x77,0x3b,0x20,
+    0xe9,0x7a,0x68,0x54,0x09,0x91,0xaa,0x2e,0x65,0xa4,0xdc,0xd4,0x11,0xbf,0xb6,0xe8,0xc5,0x66,0xf8,0xd4,
+    0x0a,0xf4,0xa0,0xb7,0xb8,0x0b,0xad,0xce,0x4f,0xa7,0xa1,0x7b,0x65,0xaf,0x45,0xe5,0x86,0x0f,0x40,0x71,
+    0x41,0x77,0xe8,0x5e,0x07,0x96,0x4e,0x99,0xfd,0xf2,0x6a,0x63,0x31,0xf7,0xe8,0x4a,0x04,0x66,0x4f,0x0b,
+    0xe4,0xa2,0xe3,0xdf,0x49,0x01,0x78,0x52,0xb1,0x84,0x30,0xcc,0x71,0x98,0x3d,0x5e,0xc8,0x47,0xe1,0xd8,
+    0xa5,0xcd,0x6c,0x03,0x85,0xf8,0x37,0xd5,0x1f,0x54,0x75,0x7f,0x59,0x60,0x7b,0x0f,0x32,0x72,0x21,0x67,
+    0xb9,0xf3,0xe0,0x42,0x52,0x1a,0x7a,0x81,0x4a,0x0a,0xf6,0xd4,0xa5,0x19,0xfc,0x94,0xde,0xc2,0xe9,0xc6,
+    0x51,0x7f,0x57,0xdb,0xd7,0xdf,0xdc,0xba,0x8d,0x9b,0x68,0x58,0x30,0x55,0x88,0x62,0x7d,0x04,0x41,0xd3,
+    0x4b,0x30,0xe0,0xb8,0x76,0xde,0x9b,0x7a,0x7d,0x9e,0xa5,0xea,0x89,0x81,0xbf,0xf3,0x57,0xb6,0x6e,0x33,
+    0xe7,0x93,0x18,0x3b,0x87,0x60,0x56,0xdc,0x84,0xff,0x04,0xdf,0x3e,0x00,0x1e,0x0a,0x10,0x9f,0x9f,0x32,
+    0x3b,0x76,0x31,0x63,0x75,0xc6,0xee,0x6b,0xe6,0xe4,0x2b,0xca,0xc3,0xdc,0x29,0x29,0x8d,0x33,0x02,0x95,
+    0x3d,0x7d,0xfd,0xf1,0xdd,0xef,0x98,0x1d,0x67,0xce,0x24,0xdc,0x37,0xd2,0xfa,0xdd,0x7f,0x21,0x11,0xf2,
+    0xba,0x29,0x9d,0xed,0x33,0x77,0xed,0x22,0x30,0x5f,0x6b,0xc4,0xf4,0xa0,0x7e,0xe7,0xff,0x06,0xdc,0xa0,
+    0x38,0xdb,0xbe,0x86,0xf9,0xdb,0x6a,0x21,0x81,0x13,0xa5,0x89,0x8f,0x92,0x10,0x55,0xbc,0x75,0xf6,0x3c,
+    0xf3,0x97,0xb7,0xf8,0xbc,0x05,0x6b,0x95,0xdb,0x5c,0xa6,0x73,0x4b,0x6c,0x10,0xb8,0x40,0x81,0xf7,0x6e,
+    0x02,0x2a,0x2f,0x3d,0xc9,0xa7,0x0e,0x04,0x8f,0x25,0x15,0x4a,0x9b,0x7b,0xc5,0x8f,0x40,0xf7,0xb9,0xe2,
+    0xea,0x61,0x69,0x2b,0xd1,0x88,0x72,0x8d,0x4a,0xec,0xe5,0x56,0xab,0x74,0x08,0x52,0x10,0x6f,0x9d,0x5a,
+    0x78,0x44,0xb1,0x02,0xc3,0xf0,0x75,0x40,0xf0,0x90,0xaa,0x91,0x6b,0x38,0x44,0xad,0x06,0xd6,0x42,0x27,
+    0x44,0xba,0x8e,0xa5,0x54,0x88,0x37,0x18,0x35,0x62,0x5d,0xdd,0xae,0xa6,0x87,0xe1,0x20,0x68,0xa3,0xd1,
+    0x12,0x08,0x87,0x01,0x30,0x4f,0x3a,0xc5,0xa7,0xeb,0xf5,0x80,0x9b,0x31,0xaa,0xf4,0xad,0xbc,0x8b,0xb7,
+    0x72,0xa5,0xd3,0xe3,0xda,0x5d,0xec,0x4b,0x52,0x1f,0x19,0xa4,0xd4,0x82,0x1c,0x61,0x45,0x0f,0xe2,0x80,
+    0xaf,0xd7,0x30,0xb5,0xe4,0x67,0x8f,0x81,0xe5,0x75,0xa3,0x13,0x6b,0x8c,0x1a,0x7f,0x7e,0x85,0xff,0x80,
+    0x2f,0x21,0x73,0x98,0x8e,0x6a,0x41,0xb8,0x26,0x08,0x56,0x2d,0xac,0xc1,0x45,0x45,0x82,0x58,0xd5,0x31,
+    0x28,0xb6,0xb4,0x50,0x02,0x01,0x62,0x9a,0x70,0x1d,0xa9,0xba,0xd5,0x52,0x0b,0x00,0xd7,0x7e,0xf5,0xeb,
+    0xea,0x6f,
+};
+
+const uint8_t language_pack_zh_CN[] PROGMEM = {
+    0x65,0x55,0x6d,0x4f,0x1b,0x47,0x10,0xde,0x9f,0xb2,0xf9,0x66,0x24,0x6a,0x92,0xd2,0x44,0x69,0xa5,0xaa,
+    0xa2,0x10,0x04,0x12,0x2d,0x69,0x20,0xcd,0x67,0xc7,0x2c,0xe6,0x24,0x73,0x67,0xdd,0x5d,0x92,0xf2,0xcd,
+    0x0e,0xf1,0x0b,0x06,0xbf,0xd0,0x80,0xcd,0x6b,0x83,0x13,0x1b,0x3b,0xb4,0xf6,0xb9,0x40,0xfc,0x8a,0xeb,
+    0x3f,0xe3,0xd9,0xbb,0xfb,0x17,0x9d,0xf3,0xad,0x91,0x50,0x3e,0xf8,0x76,0x67,0x76,0x66,0x76,0xf6,0x99,
+    0x67,0xc6,0x84,0xa7,0xcb,0x90,0x68,0x10,0xab,0xf6,0x9f,0xd9,0xab,0x11,0x33,0xd9,0xe0,0xe1,0x08,0x81,
+    0xe3,0xce,0xa0,0xdb,0x80,0x54,0xdc,0xec,0x94,0x89,0x1d,0x4f,0x41,0xd6,0x20,0xbf,0xfc,0xb6,0xbc,0x4c,
+    0x5e,0xcc,0xcf,0xce,0x13,0x48,0xed,0x43,0x74,0x93,0x40,0xb4,0x31,0xe8,0xe6,0xc8,0x82,0x12,0x08,0x48,
+    0x72,0xc0,0x31,0xc3,0x08,0x22,0x0e,0x3f,0x30,0x20,0x7b,0x6e,0x16,0x50,0x2e,0xba,0x07,0xbc,0x5a,0x74,
+    0xfd,0x7e,0x22,0x90,0x4d,0xdb,0xe1,0x30,0x19,0xf4,0x4f,0xa1,0x7a,0x00,0xed,0x86,0xb8,0x00,0x75,0x10,
+    0xef,0x10,0xb8,0x09,0x43,0x79,0x5b,0xdc,0x6d,0x1e,0x76,0xa1,0xb7,0x3f,0xd4,0xa1,0x05,0x44,0xaf,0xec,
+    0x7c,0x95,0x58,0xf1,0x0b,0x48,0x56,0x08,0xd4,0xb6,0xec,0xd3,0x43,0x82,0xd9,0xf3,0xa3,0x1c,0x81,0xf6,
+    0xa5,0x19,0x2f,0x39,0x12,0xc4,0x9a,0x18,0x2b,0x62,0x7f,0x4a,0x13,0xfc,0xd9,0xe1,0x0f,0x84,0xef,0xc6,
+    0x1c,0x87,0xb9,0xc5,0x85,0x19,0xdc,0xbf,0xe3,0xf5,0x0c,0xbe,0x21,0x3d,0x5c,0xa2,0x15,0x7b,0xb3,0xc2,
+    0x2b,0x05,0xb8,0xc9,0x10,0xfb,0xb0,0xe8,0x06,0x83,0x62,0xee,0xce,0xc1,0x43,0xb3,0xfc,0x27,0x79,0x30,
+    0xfc,0x4e,0xde,0x77,0xbe,0xdf,0x0d,0xf7,0x8f,0x86,0xfb,0xc5,0x5f,0xc9,0xe2,0xec,0xec,0x68,0x71,0xdf,
+    0x32,0x68,0x55,0xbd,0x5e,0x2f,0x85,0x44,0x93,0xe7,0xea,0x8e,0x0e,0x17,0x3b,0xea,0xc0,0x20,0x4e,0xac,
+    0xfe,0x5f,0x3c,0x5d,0xb2,0xe2,0x57,0x4b,0x4b,0xf3,0x33,0x0e,0x12,0x7c,0x27,0xe2,0x1a,0xdc,0xe2,0x71,
+    0x37,0x86,0x83,0x3e,0x85,0xcc,0x5b,0xbe,0x5f,0x27,0x90,0xd9,0x86,0x52,0x0f,0xb2,0x29,0xb3,0x5c,0x27,
+    0x83,0x56,0x97,0x9f,0x74,0x88,0xf9,0xb7,0x01,0x99,0x4f,0x1e,0xbb,0x7b,0x80,0x88,0x3f,0x78,0xfc,0x78,
+    0x72,0x8c,0x58,0xd7,0xe7,0x3c,0xd1,0x24,0x60,0xc4,0xcc,0xb3,0x88,0x63,0x67,0x7f,0x3c,0x10,0x45,0x13,
+    0x81,0xe6,0xa6,0xa8,0x8b,0x25,0x64,0x76,0xcd,0xf4,0x57,0xb2,0x70,0x41,0x2d,0x64,0x0c,0x73,0xaf,0xc2,
+    0xc3,0x65,0x9e,0x2c,0xc1,0x6e,0x92,0x3c,0x63,0xa1,0xa0,0x6f,0x83,0x2a,0xab,0xab,0x41,0x49,0x66,0x54,
+    0xd3,0x7d,0x3a,0xd3,0xa8,0xae,0xd0,0x35,0x49,0xd3,0x15,0x75,0x03,0xb7,0x21,0xc9,0x4f,0x9e,0x2a,0x6f,
+    0x98,0x4a,0x35,0xdf,0x6b,0x46,0x3d,0x2f,0xa4,0x59,0x89,0xae,0x2b,0x2b,0x6c,0x9d,0x6a,0x41,0xc6,0x42,
+    0xe3,0xb8,0x0c,0x8f,0x43,0x4a,0x30,0xa8,0x61,0xb6,0xf5,0x4d,0xcb,0xd8,0x77,0xd8,0x44,0x83,0xec,0x35,
+    0x0b,0x6a,0xd4,0xa3,0xfb,0x02,0x3f,0x32,0x55,0x55,0xd4,0x89,0x37,0x3e,0x55,0x9e,0x90,0xe4,0x55,0x65,
+    0x62,0x85,0xbd,0x7c,0x15,0x98,0xd0,0x55,0x9f,0x9f,0x8d,0x91,0xa5,0x0d,0x8c,0x11,0xa0,0x1a,0x53,0x5f,
+    0x63,0x20,0xcf,0x9a,0xa2,0xe9,0x3f,0x84,0x14,0x55,0x1f,0xa7,0x6c,0x3d,0xa4,0x6f,0xd0,0x55,0x45,0xa5,
+    0xb2,0x22,0xa3,0xa5,0xe0,0xb5,0xf9,0xb9,0x83,0xf7,0x08,0x61,0xee,0xf7,0xa9,0x69,0x3a,0xad,0xc8,0x32,
+    0xf3,0xeb,0x92,0x22,0xd3,0x67,0x4c,0x57,0x25,0xa6,0x0d,0xa1,0x16,0x26,0x0e,0xdd,0x07,0xfd,0x02,0x64,
+    0x9a,0x64,0xc1,0xa7,0xe9,0x54,0x65,0x1a,0xd3,0xc9,0xf4,0xd3,0xe7,0x54,0x5a,0x09,0x32,0xb2,0x24,0x3c,
+    0x83,0xf8,0x7c,0xd9,0xbf,0x41,0xa0,0x79,0xe9,0x16,0x96,0xf0,0x93,0x0b,0xb1,0x73,0x42,0x08,0xb8,0xdd,
+    0x52,0x61,0xdd,0xc8,0xb0,0xea,0xa2,0x30,0x8b,0xcb,0x53,0x62,0xe7,0xb6,0xa2,0xe8,0x2e,0xde,0xfa,0x0c,
+    0x9d,0x73,0x62,0xee,0x7d,0xe1,0x9d,0x2c,0x19,0x31,0xd4,0xe5,0xf3,0xa0,0x95,0x1c,0xb4,0xb6,0x05,0xc7,
+    0xa1,0x79,0x0e,0x99,0xab,0x91,0xd0,0x7b,0x0f,0x5b,0x29,0xe1,0xeb,0x46,0x1a,0x75,0xe4,0x50,0x87,0xaa,
+    0x41,0x2f,0x85,0xe9,0x85,0xa1,0x58,0x16,0x66,0x8e,0x50,0xcf,0x8c,0x84,0xe1,0xc2,0xab,0x25,0x7b,0xbf,
+    0x4f,0xf8,0xf1,0xb5,0x43,0xdc,0xfc,0xb5,0x7d,0xb4,0x47,0xf8,0x9e,0x81,0x24,0x15,0x89,0x98,0xbd,0x5d,
+    0xbb,0xf0,0x45,0xe4,0xfd,0x33,0x96,0x93,0x2c,0x3c,0x99,0x41,0x8c,0xe4,0xc0,0x2b,0x5f,0x80,0xe1,0x4b,
+    0x12,0xfc,0x74,0x73,0xf4,0x42,0xb7,0x89,0x79,0x22,0x0b,0xc9,0x0f,0xe3,0x14,0x52,0x57,0x50,0x8f,0x39,
+    0x1c,0xaf,0x1d,0x41,0x76,0xd7,0x4b,0xec,0xbd,0x43,0xcb,0x30,0xcc,0xa3,0x77,0x2e,0x61,0x27,0x5c,0xaf,
+    0x7b,0xd4,0x32,0x9a,0x68,0x85,0xa4,0xf0,0x92,0xd1,0x24,0x0a,0x1f,0x59,0xfd,0xb8,0xf3,0xfa,0x9b,0x33,
+    0xb4,0x7f,0x29,0xc9,0x3c,0x17,0xc7,0x41,0x65,0xf5,0x8f,0xad,0xc2,0x8e,0x3b,0xb4,0x1c,0x38,0x5d,0xeb,
+    0xa5,0xb9,0xa9,0x6f,0xbe,0x7d,0xf8,0x88,0x7a,0x94,0x90,0x53,0x25,0x5f,0x70,0x4c,0xcc,0x16,0x37,0x80,
+    0x53,0x23,0x3b,0xbc,0x85,0x6d,0xe6,0x06,0x21,0xee,0x82,0xb8,0x20,0x1a,0x56,0x23,0x8a,0x37,0xd9,0xf9,
+    0x4b,0x84,0x0e,0x49,0x83,0x10,0xdc,0x1e,0x5f,0x0f,0x5a,0x29,0x1c,0x6f,0xf7,0xff,0x78,0xf2,0xfd,0x48,
+    0x97,0x68,0x42,0xec,0x10,0x6a,0x6d,0x3b,0x2e,0x1c,0x11,0x73,0x28,0xa2,0xfb,0x05,0x0e,0xb8,0x3b,0xee,
+    0x22,0xf7,0x9b,0xf7,0x78,0x80,0x71,0x60,0xa7,0x8d,0x5d,0x4f,0x5c,0x2d,0x14,0xff,0xb5,0xae,0x4b,0xd8,
+    0xf1,0xc3,0x61,0xc7,0xf3,0x25,0xe8,0xe7,0x31,0x41,0xbb,0xd0,0x9e,0xb4,0xd2,0x4d,0xc8,0xe4,0x2c,0xe3,
+    0xdc,0xec,0xc6,0x90,0x8f,0x3c,0x62,0x08,0x1f,0x27,0xfb,0xea,0xc7,0xdb,0xa7,0xae,0x28,0xd8,0x86,0xb2,
+    0xa2,0xd3,0x75,0x9f,0xee,0x5f,0xa3,0xfa,0x1a,0xa3,0xab,0x52,0x90,0x8d,0xd3,0x80,0xa2,0x0b,0x0f,0x81,
+    0xf6,0x59,0x84,0x7e,0xa5,0xf0,0x20,0x4f,0xad,0x72,0x84,0x3e,0x0f,0xad,0x20,0xa1,0x55,0xaf,0x3f,0x14,
+    0x1a,0xa3,0xc4,0xad,0x1b,0x11,0x73,0x08,0x12,0xa7,0xce,0x74,0xde,0xc9,0x09,0x5a,0xb9,0xb3,0x0a,0x87,
+    0xd6,0xed,0x44,0x1b,0xf4,0x9c,0xda,0x38,0xed,0x8e,0x24,0x31,0xbb,0x27,0xf7,0x28,0x6a,0xb0,0xe2,0x70,
+    0x52,0xb1,0x6a,0x7d,0x3b,0x5f,0x33,0xdf,0xb6,0x21,0x91,0xb7,0x0a,0x15,0x4c,0x1e,0xaf,0x83,0x44,0x9d,
+    0x9f,0xfc,0x83,0x8d,0xe1,0xbd,0x33,0x3c,0x6f,0xff,0x57,0xfe,0x07,
+};
+
+const LanguagePack language_packs[] PROGMEM = {
+    {"da-DA", "Dansk", language_pack_da_DA, 1030, 1928},
+    {"en-GB", "English", language_pack_en_GB, 1028, 1941},
+    {"es-ES", "Español", language_pack_es_ES, 1125, 2236},
+    {"fr-FR", "Français", language_pack_fr_FR, 1187, 2309},
+    {"it-IT", "Italiano", language_pack_it_IT, 1119, 2229},
+    {"ja-JP", "日本語", language_pack_ja_JP, 1322, 2526},
+    {"zh-CN", "中文", language_pack_zh_CN, 1093, 1698},
+};
+const size_t language_packs_count = sizeof(language_packs) / sizeof(LanguagePack);
+
+#define LANGUAGE_DEFAULT "en-GB"
@@ -83,7 +83,11 @@ const char txt_others_title[] PROGMEM = "Others Parameters";
 const char txt_others_haauto[] PROGMEM = "HA Autodiscovery";
 const char txt_others_hatopic[] PROGMEM = "HA Autodiscovery topic";
 const char txt_others_availability_report[] PROGMEM = "HA Availability report";
+const char txt_others_state_history[] PROGMEM = "Replay offline states to history topic";
+const char txt_others_power_save[] PROGMEM = "Power save (WiFi modem sleep, slower polls)";
 const char txt_others_debug[] PROGMEM = "Debug";
+const char txt_others_log_levels[] PROGMEM = "Log levels (tag=error/warn/info/debug/trace)";
+const char txt_others_syslog[] PROGMEM = "Syslog server (host:port, empty for none)";
 
 //Page Status
 const char txt_status_title[] PROGMEM = "Status";
@@ -91,6 +95,9 @@ const char txt_status_hvac[] PROGMEM = "HVAC Status";
 const char txt_retries_hvac[] PROGMEM = "HVAC Connection Retries";
 const char txt_status_mqtt[] PROGMEM = "MQTT Status";
 const char txt_status_wifi[] PROGMEM = "WIFI RSSI";
+const char txt_status_reset[] PROGMEM = "Last reset";
+const char txt_status_cpu_idle[] PROGMEM = "CPU idle";
+const char txt_status_profile[] PROGMEM = "Section latency";
 const char txt_status_connect[] PROGMEM = "CONNECTED";
 const char txt_status_disconnect[] PROGMEM = "DISCONNECTED";
 
@@ -122,6 +129,7 @@ const char txt_unit_modes[] PROGMEM = "Mode support";
 const char txt_unit_password[] PROGMEM = "Web password";
 const char txt_unit_beep[] PROGMEM = "Beep";
 const char txt_unit_led[] PROGMEM = "LED";
+const char txt_unit_language[] PROGMEM = "Language";
 
 //Page Login
 const char txt_login_title[] PROGMEM = "Authentication";
@@ -132,6 +140,7 @@ const char txt_login_fail[] PROGMEM = "Wrong username/password! Try again.";
 //Page Upgrade
 const char txt_upgrade_title[] PROGMEM = "Upgrade";
 const char txt_upgrade_info[] PROGMEM = "Firmware OTA upgrade by bin file upload";
+const char txt_upgrade_sha256[] PROGMEM = "SHA-256 (optional)";
 const char txt_upgrade_start[] PROGMEM = "Upload started";
 
 //Page Upload
@@ -142,6 +151,7 @@ const char txt_upload_flashsize[] PROGMEM = "File flash size is larger than devi
 const char txt_upload_buffer[] PROGMEM = "File upload buffer miscompare";
 const char txt_upload_failed[] PROGMEM = "Upload failed. Enable logging option 3 for more information";
 const char txt_upload_aborted[] PROGMEM = "Upload aborted";
+const char txt_upload_sha256_mismatch[] PROGMEM = "SHA-256 does not match the file, got";
 const char txt_upload_code[] PROGMEM = "Upload error code ";
 const char txt_upload_error[] PROGMEM = "Update error code (see Updater.cpp) ";
 const char txt_upload_sucess[] PROGMEM = "Successful";
@@ -16,107 +16,779 @@
 */
 
 #include "logger.h"
+#include <soc/soc_memory_types.h>
+#include <esp_ota_ops.h>
 
+#define LOG_RING_MAGIC 0x4c4f4731 // "LOG1"
+
+static LogRing logRing __NOINIT_ATTR;
+
+// Longest conversion spec kept, like "%-08.3lf"
+#define LOG_SPEC_MAX 16
+
+// What a conversion takes from the arguments, the reader pulls the same type back.
+enum LogArg : uint8_t
+{
+    ARG_NONE, // "%%"
+    ARG_INT,
+    ARG_LONG,
+    ARG_LONG_LONG,
+    ARG_SIZE,
+    ARG_INTMAX,
+    ARG_PTRDIFF,
+    ARG_DOUBLE,
+    ARG_POINTER,
+    ARG_STRING, // copied with its null
+    ARG_HEX,    // %H: uint16_t count, then the bytes
+    ARG_INVALID
+};
+
+struct LogSpec
+{
+    const char *start; // the '%'
+    size_t len;
+    uint8_t stars;     // '*' width and precision, each an int argument before the value
+    LogArg arg;
+};
+
+// Parses the conversion at p, which points to a '%'. Returns the character after it.
+static const char *parseSpec(const char *p, LogSpec &spec){
+    spec.start = p++;
+    spec.stars = 0;
+    spec.arg = ARG_INVALID;
+    if (*p == '%'){
+        spec.arg = ARG_NONE;
+        spec.len = 2;
+        return p + 1;
+    }
+    while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0')
+        p++;
+    if (*p == '*'){
+        spec.stars++;
+        p++;
+    }
+    while (isdigit((unsigned char)*p))
+        p++;
+    if (*p == '.'){
+        p++;
+        if (*p == '*'){
+            spec.stars++;
+            p++;
+        }
+        while (isdigit((unsigned char)*p))
+            p++;
+    }
+
+    LogArg integer = ARG_INT;
+    bool longDouble = false;
+    bool wide = false;
+    if (*p == 'h'){
+        p += p[1] == 'h' ? 2 : 1;
+    }
+    else if (*p == 'l'){
+        wide = true;
+        integer = p[1] == 'l' ? ARG_LONG_LONG : ARG_LONG;
+        p += p[1] == 'l' ? 2 : 1;
+    }
+    else if (*p == 'z' || *p == 'j' || *p == 't' || *p == 'L'){
+        integer = *p == 'z' ? ARG_SIZE : *p == 'j' ? ARG_INTMAX : *p == 't' ? ARG_PTRDIFF : ARG_INVALID;
+        longDouble = *p == 'L';
+        p++;
+    }
+
+    switch (*p){
+    case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'c':
+        spec.arg = integer;
+        break;
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+        spec.arg = longDouble ? ARG_INVALID : ARG_DOUBLE;
+        break;
+    case 'p':
+        spec.arg = ARG_POINTER;
+        break;
+    case 's':
+        spec.arg = wide ? ARG_INVALID : ARG_STRING;
+        break;
+    case 'H':
+        spec.arg = ARG_HEX;
+        break;
+    }
+    if (*p)
+        p++;
+    spec.len = p - spec.start;
+    return p;
+}
+
+template <typename T>
+static bool pack(uint8_t *out, size_t size, size_t &len, T value){
+    if (len + sizeof(T) > size)
+        return false;
+    memcpy(out + len, &value, sizeof(T));
+    len += sizeof(T);
+    return true;
+}
+
+template <typename T>
+static bool unpack(const uint8_t *args, size_t size, size_t &pos, T &value){
+    if (pos + sizeof(T) > size)
+        return false;
+    memcpy(&value, args + pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+// Writes a line into a fixed buffer, keeping room for the newline, and counts what did not fit like snprintf.
+class LineWriter{
+    public:
+        LineWriter(char *out, size_t size, bool newline) : out(out), size(size), newline(newline){
+            limit = size > 2 ? size - (newline ? 2 : 1) : 0;
+        }
+
+        void write(const char *text, size_t textLen){
+            if (len < limit)
+                memcpy(out + len, text, min(textLen, limit - len));
+            len += textLen;
+        }
+
+        void format(const char *format, ...){
+            va_list args;
+            va_start(args, format);
+            int n = vsnprintf(len < limit ? out + len : nullptr, len < limit ? limit - len + 1 : 0, format, args);
+            va_end(args);
+            if (n > 0)
+                len += n;
+        }
+
+        template <typename T>
+        void conversion(const char *spec, uint8_t stars, const int *starValues, T value){
+            if (stars == 0)
+                format(spec, value);
+            else if (stars == 1)
+                format(spec, starValues[0], value);
+            else
+                format(spec, starValues[0], starValues[1], value);
+        }
+
+        size_t end(){
+            size_t written = min(len, limit);
+            if (newline && written + 1 < size)
+                out[written++] = '\n';
+            if (size > 0)
+                out[written] = '\0';
+            return len + (newline ? 1 : 0);
+        }
+
+    private:
+        char *out;
+        size_t size;
+        size_t limit; // characters before the newline and the null
+        size_t len = 0;
+        bool newline;
+};
+
+
+Logging::Logging() : ring(logRing) {
+  lock = xSemaphoreCreateMutex();
+  for (uint32_t i = 0; i < LOG_QUEUE_SIZE; i++)
+    queue[i].sequence = i;
+
+  // Keep what the previous boot logged if it is the same build and the bookkeeping still adds up,
+  // after a power loss it is random.
+  const uint8_t *build = esp_ota_get_app_description()->app_elf_sha256;
+  bool kept = ring.magic == LOG_RING_MAGIC && memcmp(ring.build, build, sizeof(ring.build)) == 0 &&
+              ring.headSeq - ring.tailSeq <= LOG_RECORDS &&
+              (ring.headSeq == ring.tailSeq || ring.dataEnd - ring.recordStart[ring.tailSeq % LOG_RECORDS] <= LOG_SIZE);
+  if (!kept){
+    ring.magic = LOG_RING_MAGIC;
+    memcpy(ring.build, build, sizeof(ring.build));
+    ring.dataEnd = 0;
+    ring.headSeq = 0;
+    ring.tailSeq = 0;
+  }
+  bootSeq = ring.headSeq;
+}
 
 Logging &Logging::getInstance() {
   static Logging instance ;
   return instance   ;
 }
 
-void Logging:: storeLog(char *log, size_t size){
-    // return;
+void Logging::ringWrite(uint32_t position, const void *data, size_t size){
+    size_t offset = position % LOG_SIZE;
+    size_t first = min(size, (size_t)(LOG_SIZE - offset));
+    memcpy(ring.data + offset, data, first);
+    memcpy(ring.data, (const uint8_t *)data + first, size - first);
+}
 
-    if (size > 512)
-        size = 512;
+void Logging::ringRead(uint32_t position, void *out, size_t size){
+    size_t offset = position % LOG_SIZE;
+    size_t first = min(size, (size_t)(LOG_SIZE - offset));
+    memcpy(out, ring.data + offset, first);
+    memcpy((uint8_t *)out + first, ring.data, size - first);
+}
 
-    // Serial.printf("Total PSRAM: %d\n", ESP.getPsramSize());
-    // Serial.printf("Free PSRAM: %d\n", ESP.getFreePsram());
-    // delay(100);
-    // Copy log to historical buffer
-    // Serial.printf("logbuffsize %d buff0 =  %c size = %d\n", logBuffSize, buff[0], size);
-    // if (logBuffPTR == nullptr){
-    //     logBuffPTR = (char*) ps_malloc(sizeof(char) * LOG_SIZE);
-    // }
-    // Serial.printf("logbuffptr %p\n", logBuffPTR);
-    memcpy(logBuffPTR + logBuffSize , log, sizeof(char) * size );
+void Logging::storeRecord(const LogRecord &record, const uint8_t *args){
+    size_t size = sizeof(LogRecord) + record.len;
 
-    logBuffSize += size;
-    
+    xSemaphoreTake(lock, portMAX_DELAY);
+    // Drop whole records from the tail until the new one fits, readers never see a partial line
+    while (ring.headSeq != ring.tailSeq && (ring.headSeq - ring.tailSeq == LOG_RECORDS || ring.dataEnd + size - ring.recordStart[ring.tailSeq % LOG_RECORDS] > LOG_SIZE))
+        ring.tailSeq++;
 
-    //Rotate log if buffer full
-    if (logBuffSize + 512 >= LOG_SIZE){
-        // Serial.println("rotate buff");
-        memmove(logBuffPTR, &logBuffPTR[512], logBuffSize);
-        // memmove(logBuffPTR, logBuffPTR +512, logBuffSize);
-        logBuffSize -= 512;
+    ring.recordStart[ring.headSeq % LOG_RECORDS] = ring.dataEnd;
+    ringWrite(ring.dataEnd, &record, sizeof(LogRecord));
+    ringWrite(ring.dataEnd + sizeof(LogRecord), args, record.len);
+    ring.dataEnd += size;
+    ring.headSeq++;
+    xSemaphoreGive(lock);
+}
+
+void Logging::begin(){
+    // Low priority: output is written when the loop and web tasks have nothing better to do
+    xTaskCreate(drainLoop, "log", LOG_DRAIN_STACK_SIZE, this, 1, &drainTask);
+}
+
+LogMessage * IRAM_ATTR Logging::reserve(const char *tag, bool wait){
+    for (int attempt = 0;; attempt++){
+        uint32_t pos = __atomic_load_n(&enqueuePos, __ATOMIC_RELAXED);
+        while (true){
+            LogMessage *message = &queue[pos % LOG_QUEUE_SIZE];
+            int32_t state = (int32_t)(__atomic_load_n(&message->sequence, __ATOMIC_ACQUIRE) - pos);
+            if (state == 0){
+                // Free cell, claim it unless another producer was faster
+                if (__atomic_compare_exchange_n(&enqueuePos, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)){
+                    message->record.ms = millis();
+                    message->record.tag = tag;
+                    message->record.format = nullptr;
+                    message->record.newline = true;
+                    message->record.level = LOG_LEVEL_INFO;
+                    return message;
+                }
+            }
+            else if (state < 0){
+                break; // full, the drain task has not freed this cell yet
+            }
+            else{
+                pos = __atomic_load_n(&enqueuePos, __ATOMIC_RELAXED);
+            }
+        }
+        // Tasks give the drain task a moment, interrupts and early boot lose the line
+        if (!wait || drainTask == NULL || xTaskGetCurrentTaskHandle() == drainTask || attempt == 10){
+            __atomic_fetch_add(&dropped, 1, __ATOMIC_RELAXED);
+            return nullptr;
+        }
+        xTaskNotifyGive(drainTask);
+        vTaskDelay(1);
     }
+}
 
-    // Serial.printf("Buff size %d\n", logBuffSize);
-    // Serial.println("---Logbuff----");
-    // for (int i = 0; i < logBuffSize; i++){
-    //     Serial.print((logBuffPTR)[i]);
-    // }
-    // Serial.println("--------------");
+void IRAM_ATTR Logging::publish(LogMessage *message, bool fromISR){
+    // A claimed cell still holds its queue position as sequence, position + 1 marks it ready to drain
+    __atomic_store_n(&message->sequence, message->sequence + 1, __ATOMIC_RELEASE);
+    if (drainTask == NULL)
+        return;
+    if (fromISR){
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveFromISR(drainTask, &woken);
+        if (woken)
+            portYIELD_FROM_ISR();
+    }
+    else{
+        xTaskNotifyGive(drainTask);
+    }
 }
 
+int Logging::packArgs(const char *format, va_list args, uint8_t *out, size_t size){
+    size_t len = 0;
+    for (const char *p = strchr(format, '%'); p != nullptr; p = strchr(p, '%')){
+        LogSpec spec;
+        p = parseSpec(p, spec);
+        if (spec.arg == ARG_INVALID || spec.len >= LOG_SPEC_MAX)
+            return -1;
+        for (uint8_t i = 0; i < spec.stars; i++)
+            if (!pack(out, size, len, va_arg(args, int)))
+                return -1;
 
-void Logging:: f(const char* tag, char *format, ...){
-    va_list args;
-    char buff[512];
-    int size = 0 ;
+        bool packed = true;
+        switch (spec.arg){
+        case ARG_INT:
+            packed = pack(out, size, len, va_arg(args, int));
+            break;
+        case ARG_LONG:
+            packed = pack(out, size, len, va_arg(args, long));
+            break;
+        case ARG_LONG_LONG:
+            packed = pack(out, size, len, va_arg(args, long long));
+            break;
+        case ARG_SIZE:
+            packed = pack(out, size, len, va_arg(args, size_t));
+            break;
+        case ARG_INTMAX:
+            packed = pack(out, size, len, va_arg(args, intmax_t));
+            break;
+        case ARG_PTRDIFF:
+            packed = pack(out, size, len, va_arg(args, ptrdiff_t));
+            break;
+        case ARG_DOUBLE:
+            packed = pack(out, size, len, va_arg(args, double));
+            break;
+        case ARG_POINTER:
+            packed = pack(out, size, len, va_arg(args, void *));
+            break;
+        case ARG_STRING:{
+            // Cut to what is left, the line would be cut when formatted anyway
+            const char *string = va_arg(args, const char *);
+            if (string == nullptr)
+                string = "(null)";
+            if (len >= size)
+                return -1;
+            size_t stringLen = min(strlen(string), size - len - 1);
+            memcpy(out + len, string, stringLen);
+            out[len + stringLen] = '\0';
+            len += stringLen + 1;
+            break;
+        }
+        case ARG_HEX:{
+            const uint8_t *bytes = va_arg(args, const uint8_t *);
+            int count = va_arg(args, int);
+            if (len + sizeof(uint16_t) > size)
+                return -1;
+            uint16_t stored = (uint16_t)min((size_t)max(count, 0), size - len - sizeof(uint16_t));
+            pack(out, size, len, stored);
+            memcpy(out + len, bytes, stored);
+            len += stored;
+            break;
+        }
+        default:
+            break;
+        }
+        if (!packed)
+            return -1;
+    }
+    return len;
+}
 
-    va_start(args, format);
-    size += sprintf(buff, "[%s:%08d]\t",tag, millis()/1000);
-    size += vsnprintf(&buff[size], 512, format, args);
+// The text of a record, without prefix and newline
+static void writeText(const LogRecord &record, const uint8_t *args, LineWriter &line){
+    if (record.format == nullptr){
+        line.write((const char *)args, record.len);
+        return;
+    }
+
+    size_t pos = 0;
+    const char *p = record.format;
+    while (*p){
+        const char *next = strchr(p, '%');
+        if (next == nullptr){
+            line.write(p, strlen(p));
+            break;
+        }
+        line.write(p, next - p);
+        LogSpec spec;
+        p = parseSpec(next, spec);
+        if (spec.arg == ARG_NONE){
+            line.write("%", 1);
+            continue;
+        }
+        if (spec.len >= LOG_SPEC_MAX)
+            break;
+        char conversion[LOG_SPEC_MAX];
+        memcpy(conversion, spec.start, spec.len);
+        conversion[spec.len] = '\0';
 
-    //log to serial (USB CDC)
-    for (int i =0 ;  i < size; i++){
-        Serial.print(buff[i]);
+        // Stops at the first argument missing, lnFromISR records hold only two
+        int stars[2] = {0, 0};
+        bool ok = true;
+        for (uint8_t i = 0; i < spec.stars && ok; i++)
+            ok = unpack(args, record.len, pos, stars[i]);
+        switch (spec.arg){
+        case ARG_INT:{
+            int value;
+            if ((ok = ok && unpack(args, record.len, pos, value)))
+                line.conversion(conversion, spec.stars, stars, value);
+            break;
+        }
+        case ARG_LONG:{
+            long value;
+            if ((ok = ok && unpack(args, record.len, pos, value)))
+                line.conversion(conversion, spec.stars, stars, value);
+            break;
+        }
+        case ARG_LONG_LONG:{
+            long long value;
+            if ((ok = ok && unpack(args, record.len, pos, value)))
+                line.conversion(conversion, spec.stars, stars, value);
+            break;
+        }
+        case ARG_SIZE:{
+            size_t value;
+            if ((ok = ok && unpack(args, record.len, pos, value)))
+                line.conversion(conversion, spec.stars, stars, value);
+            break;
+        }
+        case ARG_INTMAX:{
+            intmax_t value;
+            if ((ok = ok && unpack(args, record.len, pos, value)))
+                line.conversion(conversion, spec.stars, stars, value);
+            break;
+        }
+        case ARG_PTRDIFF:{
+            ptrdiff_t value;
+            if ((ok = ok && unpack(args, record.len, pos, value)))
+                line.conversion(conversion, spec.stars, stars, value);
+            break;
+        }
+        case ARG_DOUBLE:{
+            double value;
+            if ((ok = ok && unpack(args, record.len, pos, value)))
+                line.conversion(conversion, spec.stars, stars, value);
+            break;
+        }
+        case ARG_POINTER:{
+            void *value;
+            if ((ok = ok && unpack(args, record.len, pos, value)))
+                line.conversion(conversion, spec.stars, stars, value);
+            break;
+        }
+        case ARG_STRING:{
+            ok = ok && pos < record.len;
+            if (ok){
+                const char *string = (const char *)args + pos;
+                pos += strnlen(string, record.len - pos) + 1;
+                line.conversion(conversion, spec.stars, stars, string);
+            }
+            break;
+        }
+        case ARG_HEX:{
+            uint16_t count;
+            if ((ok = ok && unpack(args, record.len, pos, count))){
+                count = min((size_t)count, record.len - pos);
+                for (uint16_t i = 0; i < count; i++)
+                    line.format(i > 0 ? ":%02X" : "%02X", args[pos + i]);
+                pos += count;
+            }
+            break;
+        }
+        default:
+            ok = false;
+            break;
+        }
+        if (!ok)
+            break;
     }
+}
+
+size_t Logging::formatRecord(const LogRecord &record, const uint8_t *args, char *out, size_t size){
+    LineWriter line(out, size, record.newline);
+    line.format("[%s:%08lu]\t", record.tag, (unsigned long)(record.ms / 1000));
+    writeText(record, args, line);
+    return line.end();
+}
 
-    this->storeLog(buff, size);
+size_t Logging::formatText(const LogRecord &record, const uint8_t *args, char *out, size_t size){
+    LineWriter line(out, size, false);
+    writeText(record, args, line);
+    return line.end();
 }
 
-void Logging::  f(const char* tag, const char *format, ...){
-    this->f(tag, (char*) format);
+void Logging::vlog(uint8_t level, const char *tag, const char *format, va_list args, bool newline, bool literal){
+    if (!enabled(level, tag))
+        return;
+    if (fromISRContext())
+        return;
+    LogMessage *message = reserve(tag, true);
+    if (message == nullptr)
+        return;
+    message->record.newline = newline;
+    message->record.level = level;
+    int len = -1;
+    // Keep the format and its arguments, a format built at run time may be gone by the time the line is read
+    if (literal && esp_ptr_in_drom(format)){
+        va_list packed;
+        va_copy(packed, args);
+        len = packArgs(format, packed, message->args, sizeof(message->args));
+        va_end(packed);
+    }
+    if (len >= 0){
+        message->record.format = format;
+    }
+    else{
+        len = vsnprintf((char *)message->args, sizeof(message->args), format, args);
+        if (len < 0)
+            len = 0;
+        len = min(len, (int)sizeof(message->args) - 1);
+    }
+    message->record.len = len;
+    publish(message, false);
 }
 
-void Logging:: f(const char* tag,  String string){
-    this->f(tag, string.c_str());
+void Logging::text(const char *tag, const char *text, size_t len, bool newline){
+    if (!enabled(LOG_LEVEL_INFO, tag))
+        return;
+    if (fromISRContext())
+        return;
+    LogMessage *message = reserve(tag, true);
+    if (message == nullptr)
+        return;
+    len = min(len, sizeof(message->args));
+    memcpy(message->args, text, len);
+    message->record.len = len;
+    message->record.newline = newline;
+    publish(message, false);
 }
 
-void Logging::  ln(const char* tag, String string){
-    string += "\n";
-    this->f(tag, string.c_str());
+void Logging::log(uint8_t level, const char* tag, const char *format, ...){
+    va_list args;
+    va_start(args, format);
+    vlog(level, tag, format, args, true, true);
+    va_end(args);
 }
 
-void Logging:: ln(const char* tag, const char *format, ...){
+void Logging::f(const char* tag, char *format, ...){
+    va_list args;
+    va_start(args, format);
+    vlog(LOG_LEVEL_INFO, tag, format, args, false, false);
+    va_end(args);
+}
 
+void Logging::f(const char* tag, const char *format, ...){
     va_list args;
-    char buff[512];
-    int size = 0 ;
+    va_start(args, format);
+    vlog(LOG_LEVEL_INFO, tag, format, args, false, true);
+    va_end(args);
+}
 
+void Logging::f(const char* tag,  String string){
+    text(tag, string.c_str(), string.length(), false);
+}
+
+void Logging::ln(const char* tag, String string){
+    text(tag, string.c_str(), string.length(), true);
+}
+
+void Logging::ln(const char* tag, const char *format, ...){
+    va_list args;
     va_start(args, format);
-    size += sprintf(buff, "[%s:%08d]\t",tag, millis()/1000);
-    size += vsnprintf(&buff[size], 512, format, args);
-    buff[size] = '\n';
-    size++;
+    vlog(LOG_LEVEL_INFO, tag, format, args, true, true);
+    va_end(args);
+}
+
+// The task entry points format with vsnprintf and may wait for the drain task, neither is allowed in an
+// interrupt. A handler calling them by mistake loses the line, counted like a full queue, instead of
+// crashing; lnFromISR is the way to log from there.
+bool IRAM_ATTR Logging::fromISRContext(){
+    if (!xPortInIsrContext())
+        return false;
+    __atomic_fetch_add(&dropped, 1, __ATOMIC_RELAXED);
+    return true;
+}
+
+void IRAM_ATTR Logging::lnFromISR(const char *tag, const char *format, uint32_t arg0, uint32_t arg1){
+    LogMessage *message = reserve(tag, false);
+    if (message == nullptr)
+        return;
+    message->record.format = format;
+    memcpy(message->args, &arg0, sizeof(arg0));
+    memcpy(message->args + sizeof(arg0), &arg1, sizeof(arg1));
+    message->record.len = sizeof(arg0) + sizeof(arg1);
+    publish(message, true);
+}
+
+void Logging::drainLoop(void *parameter){
+    Logging *logging = (Logging *)parameter;
+    while (true){
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        logging->drain();
+    }
+}
+
+void Logging::drain(){
+    uint8_t args[LOG_MESSAGE_MAX];
+    while (true){
+        unsigned lost = __atomic_exchange_n(&dropped, 0, __ATOMIC_RELAXED);
+        if (lost > 0){
+            LogRecord notice;
+            notice.ms = millis();
+            notice.tag = "log";
+            notice.format = "%u lines dropped, queue full";
+            notice.len = sizeof(lost);
+            notice.newline = true;
+            notice.level = LOG_LEVEL_WARN;
+            output(notice, (const uint8_t *)&lost);
+        }
+
+        LogMessage *message = &queue[dequeuePos % LOG_QUEUE_SIZE];
+        if (__atomic_load_n(&message->sequence, __ATOMIC_ACQUIRE) != dequeuePos + 1)
+            return; // empty, or the next line is still being written
+
+        LogRecord record = message->record;
+        memcpy(args, message->args, record.len);
+        // Hand the cell back to the producers, one lap further on
+        __atomic_store_n(&message->sequence, dequeuePos + LOG_QUEUE_SIZE, __ATOMIC_RELEASE);
+        dequeuePos++;
+
+        output(record, args);
+    }
+}
 
-    //log to serial (USB CDC)
-    for (int i =0 ;  i < size; i++){
-        Serial.print(buff[i])  ;     
+void Logging::output(const LogRecord &record, const uint8_t *args){
+    storeRecord(record, args);
+    //log to serial (USB CDC), only formatted while a console is attached
+    if (Serial){
+        char line[LOG_RECORD_MAX];
+        size_t size = min(formatRecord(record, args, line, sizeof(line)), sizeof(line) - 1);
+        Serial.write(line, size);
     }
+}
 
-    this->storeLog(buff, size);
+static const char *const levelNames[] = {"none", "error", "warn", "info", "debug", "trace"};
+
+const char *Logging::levelName(uint8_t level){
+    return level <= LOG_LEVEL_TRACE ? levelNames[level] : "trace";
 }
 
-String Logging::getLogs(){
-    String logs = "";
+uint8_t Logging::levelOf(const char *tag){
+    uint8_t count = __atomic_load_n(&tagLevelCount, __ATOMIC_ACQUIRE);
+    for (uint8_t i = 0; i < count; i++){
+        if (strcmp(tagLevels[i].tag, tag) == 0)
+            return tagLevels[i].level;
+    }
+    return defaultLevel;
+}
 
-    for (int i = 0; i < logBuffSize; i++){
-        logs += (logBuffPTR)[i];
+bool Logging::setLevel(const char *tag, size_t tagLen, uint8_t level){
+    if (tagLen == 1 && tag[0] == '*'){
+        defaultLevel = level;
+    }
+    else{
+        uint8_t i = 0;
+        while (i < tagLevelCount && (strncmp(tagLevels[i].tag, tag, tagLen) != 0 || tagLevels[i].tag[tagLen] != '\0'))
+            i++;
+        if (i == tagLevelCount){
+            if (tagLen == 0 || tagLen >= LOG_TAG_MAX || tagLevelCount == LOG_TAG_LEVELS)
+                return false;
+            // Tags are identifiers, anything else is a typo (and would end up in the Others page as is)
+            for (size_t c = 0; c < tagLen; c++)
+                if (!isalnum((unsigned char)tag[c]) && tag[c] != '_' && tag[c] != '-')
+                    return false;
+            // Name first, the entry is visible to other tasks once counted
+            memcpy(tagLevels[i].tag, tag, tagLen);
+            tagLevels[i].tag[tagLen] = '\0';
+            tagLevels[i].level = level;
+            __atomic_store_n(&tagLevelCount, i + 1, __ATOMIC_RELEASE);
+        }
+        tagLevels[i].level = level;
     }
-    return logs;
+
+    uint8_t most = defaultLevel;
+    for (uint8_t i = 0; i < tagLevelCount; i++)
+        most = max(most, tagLevels[i].level);
+    maxLevel = most;
+    return true;
+}
+
+bool Logging::setLevels(const char *spec){
+    bool ok = true;
+    while (*spec){
+        size_t partLen = strcspn(spec, ",");
+        const char *equals = (const char *)memchr(spec, '=', partLen);
+        if (equals != nullptr){
+            const char *tag = spec;
+            size_t tagLen = equals - spec;
+            const char *name = equals + 1;
+            size_t nameLen = spec + partLen - name;
+            while (tagLen > 0 && *tag == ' '){
+                tag++;
+                tagLen--;
+            }
+            while (tagLen > 0 && tag[tagLen - 1] == ' ')
+                tagLen--;
+            while (nameLen > 0 && *name == ' '){
+                name++;
+                nameLen--;
+            }
+            while (nameLen > 0 && name[nameLen - 1] == ' ')
+                nameLen--;
+
+            uint8_t level = 0;
+            while (level <= LOG_LEVEL_TRACE && (strncasecmp(levelNames[level], name, nameLen) != 0 || levelNames[level][nameLen] != '\0'))
+                level++;
+            ok = level <= LOG_LEVEL_TRACE && setLevel(tag, tagLen, level) && ok;
+        }
+        else if (partLen > 0){
+            ok = false;
+        }
+        spec += partLen;
+        if (*spec == ',')
+            spec++;
+    }
+    return ok;
+}
+
+size_t Logging::levels(char *out, size_t size){
+    if (size == 0)
+        return 0;
+    size_t len = snprintf(out, size, "*=%s", levelName(defaultLevel));
+    for (uint8_t i = 0; i < tagLevelCount && len < size; i++)
+        len += snprintf(out + len, size - len, ",%s=%s", tagLevels[i].tag, levelName(tagLevels[i].level));
+    return min(len, size - 1);
+}
+
+uint32_t Logging::end(){
+    xSemaphoreTake(lock, portMAX_DELAY);
+    uint32_t position = ring.headSeq;
+    xSemaphoreGive(lock);
+    return position;
+}
+
+bool Logging::copyRecord(uint32_t &from, uint32_t to, LogMessage &copy){
+    xSemaphoreTake(lock, portMAX_DELAY);
+    if (from < ring.tailSeq)
+        from = ring.tailSeq;
+    if (from >= to || from >= ring.headSeq){
+        xSemaphoreGive(lock);
+        return false;
+    }
+    uint32_t start = ring.recordStart[from % LOG_RECORDS];
+    ringRead(start, &copy.record, sizeof(LogRecord));
+    copy.record.len = min(copy.record.len, (uint16_t)LOG_MESSAGE_MAX);
+    ringRead(start + sizeof(LogRecord), copy.args, copy.record.len);
+    xSemaphoreGive(lock);
+
+    // Records from before the reset went through whatever crashed, only trust pointers into flash
+    if (from < bootSeq && (!esp_ptr_in_drom(copy.record.tag) || (copy.record.format != nullptr && !esp_ptr_in_drom(copy.record.format)))){
+        copy.record.tag = "?";
+        copy.record.format = nullptr;
+        copy.record.len = 0;
+    }
+    return true;
+}
+
+size_t Logging::read(uint32_t &from, uint32_t to, char *out, size_t size){
+    LogMessage copy;
+    size_t len = 0;
+    while (size - len > 1 && copyRecord(from, to, copy)){
+        // Formatted outside the lock, the drain task keeps storing meanwhile
+        size_t lineLen = formatRecord(copy.record, copy.args, out + len, size - len);
+        if (lineLen >= size - len){
+            if (len > 0)
+                break;
+            lineLen = size - 1;
+        }
+        len += lineLen;
+        from++;
+    }
+    return len;
+}
+
+bool Logging::readRecord(uint32_t &from, uint32_t to, LogRecord &record, char *text, size_t size){
+    LogMessage copy;
+    if (!copyRecord(from, to, copy))
+        return false;
+    record = copy.record;
+    formatText(copy.record, copy.args, text, size);
+    from++;
+    return true;
 }
 
 Logging &Log = Log.getInstance();
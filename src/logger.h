@@ -21,29 +21,195 @@
 
 #include <Arduino.h>
 
-#define LOG_SIZE 50000 
+#define LOG_SIZE 50000
+// Records indexed at once, more than the buffer holds with the usual record sizes.
+#define LOG_RECORDS 2048
+// Longest formatted line, longer ones are cut.
+#define LOG_RECORD_MAX 512
+// Lines waiting for the drain task, a power of two.
+#define LOG_QUEUE_SIZE 16
+// Argument bytes of a line, or its text when it could not be stored as format and arguments.
+#define LOG_MESSAGE_MAX 400
+#define LOG_DRAIN_STACK_SIZE 6144
+
+// Levels, lower is more severe. Lines above a tag's runtime threshold are dropped before anything is
+// copied, the LOGx macros above LOG_COMPILE_LEVEL (a build flag) are not compiled at all.
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+#define LOG_LEVEL_TRACE 5
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL LOG_LEVEL_DEBUG
+#endif
+// Threshold of the tags without their own
+#define LOG_LEVEL_DEFAULT LOG_LEVEL_INFO
+// Tags with their own threshold, and their longest name
+#define LOG_TAG_LEVELS 8
+#define LOG_TAG_MAX 16
+
+// A line as stored: the format stays in flash and only the arguments are copied, the text is
+// produced when the log is read. Strings (%s) and hex dumps (%H, a pointer and an int length)
+// are copied into the arguments, so they need not outlive the call.
+struct LogRecord
+{
+    uint32_t ms;        // millis() when logged
+    const char *tag;
+    const char *format; // literal, nullptr when the arguments are the text itself
+    uint16_t len;       // argument bytes following the record
+    bool newline;
+    uint8_t level;
+};
+
+// A line on its way from the caller to the drain task.
+struct LogMessage
+{
+    uint32_t sequence;  // queue cell state, see Logging::reserve
+    LogRecord record;
+    uint8_t args[LOG_MESSAGE_MAX];
+};
+
+// Log records and their bookkeeping. Kept in memory that survives resets other than power loss, so
+// the lines before a watchdog or panic reset can still be read after it.
+struct LogRing
+{
+    uint32_t magic;
+    uint8_t build[8];   // start of the app ELF SHA-256, records point into the flash of that build
+    uint32_t dataEnd;   // position of the next record
+    uint32_t headSeq;   // sequence number of the next record
+    uint32_t tailSeq;   // oldest record still held
+    uint32_t recordStart[LOG_RECORDS];
+    uint8_t data[LOG_SIZE];
+};
+
+struct LogTagLevel
+{
+    char tag[LOG_TAG_MAX];
+    uint8_t level;
+};
 
 class Logging{
 
     private:
-        Logging() = default;
-        // char logBuff[LOG_SIZE];
-        // char *logBuffPTR = NULL;
-        char logBuffPTR [LOG_SIZE];
-        unsigned int logBuffSize = 0;
+        Logging();
+        // Circular buffer of log records, a LogRecord followed by its arguments. Positions are bytes since
+        // the ring was started, the byte at position p is ring.data[p % LOG_SIZE]. Each record has a sequence
+        // number, ring.recordStart[seq % LOG_RECORDS] is where it starts, records [tailSeq, headSeq) are held.
+        LogRing &ring;
+        uint32_t bootSeq; // first record of this boot, the ones before survived a reset
+        // The drain task stores while the web task reads back
+        SemaphoreHandle_t lock;
+
+        // Bounded lock-free queue (one sequence number per cell): any task or interrupt reserves a
+        // cell, fills it and publishes it, the drain task formats and stores the lines in order.
+        LogMessage queue[LOG_QUEUE_SIZE];
+        uint32_t enqueuePos = 0;
+        uint32_t dequeuePos = 0;
+        uint32_t dropped = 0; // lines lost to a full queue, reported by the drain task
+        TaskHandle_t drainTask = NULL;
+
+        // Runtime thresholds. Entries are only ever added or changed in place, so callers in other tasks
+        // can look them up without a lock. maxLevel is the most verbose of them all, the fast way out.
+        LogTagLevel tagLevels[LOG_TAG_LEVELS];
+        uint8_t tagLevelCount = 0;
+        uint8_t defaultLevel = LOG_LEVEL_DEFAULT;
+        uint8_t maxLevel = LOG_LEVEL_DEFAULT;
+
+        void ringWrite(uint32_t position, const void *data, size_t size);
+        void ringRead(uint32_t position, void *out, size_t size);
+        LogMessage *reserve(const char *tag, bool wait);
+        bool fromISRContext();
+        void publish(LogMessage *message, bool fromISR);
+        void vlog(uint8_t level, const char *tag, const char *format, va_list args, bool newline, bool literal);
+        bool setLevel(const char *tag, size_t tagLen, uint8_t level);
+        void text(const char *tag, const char *text, size_t len, bool newline);
+        static void drainLoop(void *parameter);
+        void drain();
+        void output(const LogRecord &record, const uint8_t *args);
+        bool copyRecord(uint32_t &from, uint32_t to, LogMessage &copy);
     public:
         static Logging &getInstance();
         Logging(const Logging &) = delete; // no copying
         Logging &operator=(const Logging &) = delete;
 
-        void storeLog(char *log, size_t size);
+        // Starts the drain task, lines logged before are held in the queue until then.
+        void begin();
+        // Appends one record, dropping the oldest records to make room. Cost depends only on its size.
+        void storeRecord(const LogRecord &record, const uint8_t *args);
+        // Packs the arguments of format into args as storeRecord expects them. Returns their size, or -1
+        // when format holds a conversion that can only be formatted right away (%n, long double, ...).
+        static int packArgs(const char *format, va_list args, uint8_t *out, size_t size);
+        // Formats a record as the "[tag:seconds]\t" prefixed line it stands for, cut to size - 1 characters
+        // and null terminated. Returns the length of the complete line, like snprintf.
+        static size_t formatRecord(const LogRecord &record, const uint8_t *args, char *out, size_t size);
+        // Same without the prefix and the newline.
+        static size_t formatText(const LogRecord &record, const uint8_t *args, char *out, size_t size);
+        // Is a line of that level from tag kept? The LOGx macros check before evaluating their arguments.
+        bool enabled(uint8_t level, const char *tag){
+            return level <= maxLevel && level <= levelOf(tag);
+        }
+        uint8_t levelOf(const char *tag);
+        // Applies "DKUART=trace,mainApp=warn,*=info", "*" being every tag without its own threshold.
+        // Returns false if a part was not understood, the others still apply.
+        bool setLevels(const char *spec);
+        // Current thresholds in the form setLevels takes.
+        size_t levels(char *out, size_t size);
+        static const char *levelName(uint8_t level);
+
+        void log(uint8_t level, const char* tag, const char *format, ...);
+        // f and ln log at info level
         void f(const char* tag, char *format, ...);
         void f(const char* tag, const char *format, ...);
         void f(const char* tag,  String string);
         void ln(const char* tag, String string);
         void ln(const char* tag, const char *format, ...);
-        String getLogs();
+        // Formats passed to f and ln should be literals: their arguments are stored and the line is
+        // formatted only when read. Besides the printf conversions, %H prints a pointer and an int length
+        // as hex bytes ("02:47:31").
+        // From interrupt handlers: format must be a literal taking up to two integer arguments.
+        // Never blocks, the line is dropped when the queue is full.
+        void IRAM_ATTR lnFromISR(const char *tag, const char *format, uint32_t arg0 = 0, uint32_t arg1 = 0);
+        // Log positions are record sequence numbers, so a reader can resume where it stopped. They carry
+        // on across resets that keep the log.
+        uint32_t end();
+        // Position of the first line logged since this boot.
+        uint32_t bootStart() { return bootSeq; }
+        // Format whole records from sequence number `from` (moved up to the oldest record still held) but
+        // not past `to` into out. Returns the number of bytes written and advances from past the records.
+        // A line longer than size is cut rather than blocking the reader.
+        size_t read(uint32_t &from, uint32_t to, char *out, size_t size);
+        // One record at a time, for readers that need the level, tag and time apart from the text. Returns
+        // false when there is none left before `to`, else advances from past the record it read; from
+        // jumping further than that means older records were dropped before they were read.
+        bool readRecord(uint32_t &from, uint32_t to, LogRecord &record, char *text, size_t size);
 
 };
 
-extern Logging &Log;
\ No newline at end of file
+extern Logging &Log;
+
+#if LOG_COMPILE_LEVEL >= LOG_LEVEL_ERROR
+#define LOGE(tag, ...) do { if (Log.enabled(LOG_LEVEL_ERROR, tag)) Log.log(LOG_LEVEL_ERROR, tag, __VA_ARGS__); } while (0)
+#else
+#define LOGE(tag, ...) do { } while (0)
+#endif
+#if LOG_COMPILE_LEVEL >= LOG_LEVEL_WARN
+#define LOGW(tag, ...) do { if (Log.enabled(LOG_LEVEL_WARN, tag)) Log.log(LOG_LEVEL_WARN, tag, __VA_ARGS__); } while (0)
+#else
+#define LOGW(tag, ...) do { } while (0)
+#endif
+#if LOG_COMPILE_LEVEL >= LOG_LEVEL_INFO
+#define LOGI(tag, ...) do { if (Log.enabled(LOG_LEVEL_INFO, tag)) Log.log(LOG_LEVEL_INFO, tag, __VA_ARGS__); } while (0)
+#else
+#define LOGI(tag, ...) do { } while (0)
+#endif
+#if LOG_COMPILE_LEVEL >= LOG_LEVEL_DEBUG
+#define LOGD(tag, ...) do { if (Log.enabled(LOG_LEVEL_DEBUG, tag)) Log.log(LOG_LEVEL_DEBUG, tag, __VA_ARGS__); } while (0)
+#else
+#define LOGD(tag, ...) do { } while (0)
+#endif
+#if LOG_COMPILE_LEVEL >= LOG_LEVEL_TRACE
+#define LOGT(tag, ...) do { if (Log.enabled(LOG_LEVEL_TRACE, tag)) Log.log(LOG_LEVEL_TRACE, tag, __VA_ARGS__); } while (0)
+#else
+#define LOGT(tag, ...) do { } while (0)
+#endif
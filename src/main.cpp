@@ -18,8 +18,23 @@
 #include "html_init.h"         // code html for initial config
 #include "html_menu.h"         // code html for menu
 #include "html_pages.h"        // code html for pages
+#include "html_templates.h"    // segment tables of the pages above, generated by tools/html_templates.py
 #include <esp_task_wdt.h>      // Watchdog
 #include "logger.h"
+#include "state_encoder.h"
+#include "state_history.h"
+#include "state_snapshot.h"
+#include "event_stream.h"
+#include "ota_writer.h"
+#include "metrics.h"
+#include "profiler.h"
+#include "power_save.h"
+#include "reset_report.h"
+#include "syslog_sink.h"
+#include "scheduler.h"
+#include "session.h"
+#include "language.h"
+#include "benchmark.h"
 #include <ESP_MultiResetDetector.h> //https://github.com/khoih-prog/ESP_MultiResetDetector
 
 #define TAG "mainApp"
@@ -38,36 +53,208 @@ volatile unsigned long BTNPresedTime = 0;
 volatile bool btnPressed = false;
 uint8_t btnAction = noPress;
 
+// PubSubClient with every publish counted for /metrics, the overloads are forwarded untouched.
+class MeteredPubSubClient : public PubSubClient
+{
+public:
+  using PubSubClient::PubSubClient;
+
+  template <typename... Args>
+  boolean publish(Args... args)
+  {
+    boolean ok = PubSubClient::publish(args...);
+    metrics.mqttPublish(ok);
+    return ok;
+  }
+
+  template <typename... Args>
+  boolean publish_P(Args... args)
+  {
+    boolean ok = PubSubClient::publish_P(args...);
+    metrics.mqttPublish(ok);
+    return ok;
+  }
+
+  int endPublish()
+  {
+    int ok = PubSubClient::endPublish();
+    metrics.mqttPublish(ok);
+    return ok;
+  }
+
+  // Debug note about a publish that failed, not counted so the failure shows up once.
+  boolean publishUncounted(const char *topic, const char *payload)
+  {
+    return PubSubClient::publish(topic, payload);
+  }
+};
+
 // wifi, mqtt and heatpump client instances
 WiFiClient espClient;
-PubSubClient mqtt_client(espClient);
+MeteredPubSubClient mqtt_client(espClient);
+unsigned int wifiReconnects;
+bool wifiWasConnected = false;
+bool wifiJoinedOnce = false; // the first association after boot is not a reconnect
 
 // Captive portal variables, only used for config page
 const byte DNS_PORT = 53;
 IPAddress apIP(8, 8, 8, 8);
 IPAddress netMsk(255, 255, 255, 0);
 DNSServer dnsServer;
-WebServer server(80);
+EventWebServer server(80);
 
 boolean captive = false;
 boolean mqtt_config = false;
 boolean wifi_config = false;
 
+// Web interface logins, see is_authenticated()
+SessionTable sessions;
+
+// Sent as is when a page needs a login, or the login page is opened while logged in.
+// Use javascript in the case browser disable redirect.
+const char redirect_to_login_page[] PROGMEM = "<html lang=\"en\" class=\"\"><head><meta charset='utf-8'>"
+                                              "<script>setTimeout(function () {window.location.href= '/login';}, 1000);</script>"
+                                              "</body></html>";
+const char redirect_to_root_page[] PROGMEM = "<html lang=\"en\" class=\"\"><head><meta charset='utf-8'>"
+                                             "<script>setTimeout(function () {window.location.href= '/';}, 1000);</script>"
+                                             "</body></html>";
+
 // HVAC
 DaikinController ac;
 unsigned long lastTempSend;
 unsigned long lastCommandSend;
-unsigned long lastMqttRetry;
-unsigned long lastHpSync;
 unsigned int hpConnectionRetries;
 unsigned int hpConnectionTotalRetries;
 bool firstSync = true;
+bool mqttConnectRequested = false; // set by the status page, handled by the next mqttStep()
+
+// Controller task: owns ac and the UART, everything else sees the unit through controllerSnapshot
+// and sends it ControllerCommands. Its jobs run on their own scheduler, see setupControllerJobs().
+Scheduler controllerScheduler("controller");
+TaskHandle_t controllerTask;
+bool hpSynced = false;    // a sync cycle completed since boot, controller task only
+uint32_t syncCycleUs = 0; // exchanges of the sync cycle in progress
+
+// Jobs, registered by setupJobs() and setupControllerJobs()
+int hvacJob = -1;
+int s21expJob = -1;
+int passthroughJob = -1;
+int mqttConnectJob = -1;
+int mqttJob = -1;
+int otaJob = -1;
+int blinkJob = -1;
+uint8_t blinksLeft = 0; // short press feedback, the LED is off on even counts
 
 // Local state
-StaticJsonDocument<JSON_OBJECT_SIZE(256)> rootInfo;
+HVACState localState;
+char stateJson[STATE_JSON_SIZE];
+
+// Command waiting for the unit to report the requested settings (see hpCommand). Controller task only.
+struct PendingCommand
+{
+  char id[40];
+  HVACSettings settings;
+  unsigned long tReceive; // micros()
+  bool active;
+};
+PendingCommand pendingCommand;
+
+// Bulk query from send/s21exp, tokenised in place and run one command per controller job run.
+// The loop task fills it in while busy is clear, the controller task clears busy when done.
+struct S21expQuery
+{
+  char buffer[S21EXP_MAX_LEN + 1];
+  char *end;
+  char *next; // next command, nullptr when idle
+  bool busy;
+  uint16_t index;
+  uint16_t total;
+  uint16_t failed;
+  unsigned long tStart;
+};
+S21expQuery s21exp;
+
+// Raw frames from serial/send waiting for their turn on the UART
+struct PassthroughFrame
+{
+  uint8_t data[PASSTHROUGH_FRAME_SIZE];
+  uint8_t len;
+  unsigned long queuedAt; // micros()
+};
+QueueHandle_t passthroughFrames;
+
+// Requests for the controller task, posted by the web task (control page) and the loop task
+// (MQTT, button) and applied by controllerCommandRun()
+enum ControllerCommandType : uint8_t
+{
+  CMD_CONNECT,
+  CMD_SETTINGS,
+  CMD_TOGGLE_POWER,
+  CMD_S21_PACKET,  // send/s21, the answer is only logged
+  CMD_S21EXP,      // s21exp was filled in, start running it
+  CMD_PASSTHROUGH  // frames were queued on passthroughFrames
+};
+struct ControllerCommand
+{
+  ControllerCommandType type;
+  float temperature; // Celsius, NAN when unchanged
+  char power[8];     // unit values, empty when unchanged
+  char mode[8];
+  char fan[8];
+  char vane[8];
+  char wideVane[8];
+  bool fromUnit;           // start from what the unit reports instead of the pending settings (control page)
+  int8_t beep;             // Buzzer_preset played before sending, -1 for none
+  char id[40];             // JSON command correlation id, acked on the ack topic, empty for none
+  unsigned long tReceive;  // micros() when the JSON command arrived
+  uint8_t packet[20];      // CMD_S21_PACKET: cmd1, cmd2, payload
+  uint8_t packetLen;
+};
+QueueHandle_t controllerCommands;
+
+// What the controller task has to say on MQTT, published by the loop task (see controllerResultsStep)
+enum ControllerResultTopic : uint8_t
+{
+  RESULT_COMMAND_ACK,
+  RESULT_S21EXP,
+  RESULT_SERIAL_RECV
+};
+struct ControllerResult
+{
+  ControllerResultTopic topic;
+  char payload[CONTROLLER_RESULT_SIZE];
+};
+QueueHandle_t controllerResults;
+uint32_t controllerResultsDropped;
+
+// The web server and the MQTT side only see the controller through this snapshot
+StateSnapshot controllerSnapshot;
+TaskHandle_t webTask;
+int mqttState = MQTT_DISCONNECTED; // PubSubClient state, written by the loop task for the pages
+
+// /api/acstatus body, encoded again only when the snapshot version moves. Web task only.
+struct StatusCache
+{
+  uint32_t version;
+  size_t len; // 0 until the first request
+  char json[STATE_JSON_SIZE];
+  char etag[12]; // FNV-1a of json, quoted
+};
+StatusCache statusCache;
+
+// Live state and log push to the pages (/events), only used from the web task
+EventStream events;
+uint32_t eventStateVersion;
+unsigned long lastEventPing;
+
+// States sampled while MQTT is down, replayed after reconnect
+StateHistory stateHistory;
+unsigned long lastHistoryReplay;
+unsigned int historyReplayed;
 
 // Web OTA
 int uploaderror = 0;
+OtaWriter otaWriter;
 
 // AC Serial
 HardwareSerial *acSerial(&Serial0);
@@ -85,17 +272,47 @@ void handleInitSetup();
 void handleSaveInit();
 void handleReboot();
 void handleNotFound();
+void initWebAssets();
+void startWebServer();
+void eventStreamStep();
+void publishControllerSnapshot();
+void setupJobs();
+void startControllerTask();
+void setupControllerJobs();
+void wifiStep();
+void hvacStep();
+void s21expStep();
+void passthroughStep();
+void commandConfirmStep();
+void mqttStep();
+void controllerResultsStep();
+void mqttConnectStep();
+void profilePublishStep();
+void ledStep();
+void blinkStep();
+void setPowerSave(bool on);
+void renderControlPage(HtmlWriter &response);
+std::function<void(uint8_t field, HtmlWriter &out)> controlPageResolver();
 void mqttConnect();
+void publishResetReport();
 void mqttCallback(char *topic, byte *payload, unsigned int length);
 bool connectWifi();
 bool checkLogin();
 float convertCelsiusToLocalUnit(float temperature, bool isFahrenheit);
 float convertLocalUnitToCelsius(float temperature, bool isFahrenheit);
-HVACSettings change_states(HVACSettings settings);
+ControllerCommand change_states();
+ControllerCommand controllerCommand(ControllerCommandType type);
+bool controllerCommandPost(const ControllerCommand &command);
+void controllerCommandRun(const ControllerCommand &command);
+void hpApplyCommand(const ControllerCommand &command);
+void controllerResultPost(ControllerResultTopic topic, const char *format, ...);
 String getTemperatureScale();
 bool is_authenticated();
-String hpGetMode(HVACSettings hvacSettings);
-void hpStatusChanged(HVACStatus currentStatus);
+const char *hpGetMode(HVACSettings hvacSettings);
+const char *hpGetAction(HVACStatus hpStatus, HVACSettings hpSettings);
+void readHeatPumpStatus(HVACState &state, HVACStatus currentStatus, HVACSettings currentSettings, uint8_t protocol);
+void hpStatusChanged(const ControllerSnapshot &snapshot);
+void replayStateHistory();
 void playBeep(Buzzer_preset buzzer_preset);
 void updateUnitSettings();
 void testMode()
@@ -240,18 +457,17 @@ void wifiFactoryReset()
 
 }
 
-String getHEXformatted2(uint8_t *bytes, size_t len)
+// Same format as the %H log conversion, output is truncated to outSize.
+void formatHEX(const uint8_t *bytes, size_t len, char *out, size_t outSize)
 {
-  String res;
-  char buf[5];
-  for (size_t i = 0; i < len; i++)
+  size_t pos = 0;
+  if (outSize == 0)
+    return;
+  out[0] = '\0';
+  for (size_t i = 0; i < len && pos + 3 < outSize; i++)
   {
-    if (i > 0)
-      res += ':';
-    sprintf(buf, "%02X", bytes[i]);
-    res += buf;
+    pos += snprintf(out + pos, outSize - pos, i > 0 ? ":%02X" : "%02X", bytes[i]);
   }
-  return res;
 }
 
 bool loadWifi()
@@ -353,9 +569,9 @@ void saveMqtt(String mqttFn, String mqttHost, String mqttPort, String mqttUser,
   configFile.close();
 }
 
-void saveUnit(String tempUnit, String supportMode, String updateInterval, String loginPassword, String minTemp, String maxTemp, String tempStep, String beep, String ledEnabled)
+void saveUnit(String tempUnit, String supportMode, String updateInterval, String loginPassword, String minTemp, String maxTemp, String tempStep, String beep, String ledEnabled, String languageCode)
 {
-  StaticJsonDocument<256> doc;
+  StaticJsonDocument<384> doc;
   // if temp unit is empty, we use default celcius
   if (tempUnit.isEmpty())
     tempUnit = "cel";
@@ -389,6 +605,9 @@ void saveUnit(String tempUnit, String supportMode, String updateInterval, String
   if (ledEnabled.isEmpty())
     ledEnabled = "1";
   doc["ledEnabled"] = ledEnabled;
+  if (languageCode.isEmpty())
+    languageCode = language_code;
+  doc["language"] = languageCode;
 
   doc["login_password"] = loginPassword;
   File configFile = SPIFFS.open(unit_conf, "w");
@@ -419,14 +638,18 @@ void saveWifi(String apSsid, String apPwd, String hostName, String otaPwd)
   configFile.close();
 }
 
-void saveOthers(String haa, String haat, String availability_report, String debug)
+void saveOthers(String haa, String haat, String availability_report, String state_history, String power_save, String debug, String logLevels, String syslog)
 {
-  const size_t capacity = JSON_OBJECT_SIZE(4) + 130;
+  const size_t capacity = JSON_OBJECT_SIZE(8) + 336;
   DynamicJsonDocument doc(capacity);
   doc["haa"] = haa;
   doc["haat"] = haat;
   doc["avail_report"] = availability_report;
+  doc["state_history"] = state_history;
+  doc["power_save"] = power_save;
   doc["debug"] = debug;
+  doc["log_levels"] = logLevels;
+  doc["syslog"] = syslog;
   File configFile = SPIFFS.open(others_conf, "w");
   if (!configFile)
   {
@@ -439,7 +662,7 @@ void saveOthers(String haa, String haat, String availability_report, String debu
 
 void saveUnitFeedback(bool beepEnabled, bool ledEnabled){
 
-  saveUnit(useFahrenheit?"fah":"cel",  supportHeatMode?"all":"nht", String(update_int/1000), login_password, String(min_temp), String(max_temp), temp_step, beep?"1":"0", ledEnabled?"1":"0");
+  saveUnit(useFahrenheit?"fah":"cel",  supportHeatMode?"all":"nht", String(update_int/1000), login_password, String(min_temp), String(max_temp), temp_step, beep?"1":"0", ledEnabled?"1":"0", language_code);
 }
 
 // Initialize captive portal page
@@ -449,8 +672,9 @@ void initCaptivePortal()
   server.on("/", handleInitSetup);
   server.on("/save", handleSaveInit);
   server.on("/reboot", handleReboot);
+  initWebAssets();
   server.onNotFound(handleNotFound);
-  server.begin();
+  startWebServer();
   captive = true;
 }
 
@@ -459,6 +683,8 @@ void initMqtt()
   mqtt_client.setServer(mqtt_server.c_str(), atoi(mqtt_port.c_str()));
   mqtt_client.setCallback(mqttCallback);
   mqtt_client.setKeepAlive(120);
+  // Default 256 bytes drops long s21exp queries before they reach the callback.
+  mqtt_client.setBufferSize(MQTT_BUFFER_SIZE);
   mqttConnect();
 }
 
@@ -476,15 +702,15 @@ void initOTA()
   ArduinoOTA.onEnd([]()
                    { Log.ln(TAG, "End"); });
   ArduinoOTA.onProgress([](unsigned int progress, unsigned int total)
-                        { Log.ln(TAG, "Progress: %u%%\r", (progress / (total / 100))); });
+                        { LOGD(TAG, "Progress: %u%%\r", (progress / (total / 100))); });
   ArduinoOTA.onError([](ota_error_t error)
                      {
-                      Log.ln(TAG, "Error: " + String(error));
-                       if (error == OTA_AUTH_ERROR) Log.ln(TAG, "Auth Failed");
-                       else if (error == OTA_BEGIN_ERROR) Log.ln(TAG, "Begin Failed");
-                       else if (error == OTA_CONNECT_ERROR) Log.ln(TAG, "Connect Failed");
-                       else if (error == OTA_RECEIVE_ERROR) Log.ln(TAG, "Receive Failed");
-                       else if (error == OTA_END_ERROR) Log.ln(TAG, "End Failed"); });
+                      LOGE(TAG, "Error: %d", (int)error);
+                       if (error == OTA_AUTH_ERROR) LOGE(TAG, "Auth Failed");
+                       else if (error == OTA_BEGIN_ERROR) LOGE(TAG, "Begin Failed");
+                       else if (error == OTA_CONNECT_ERROR) LOGE(TAG, "Connect Failed");
+                       else if (error == OTA_RECEIVE_ERROR) LOGE(TAG, "Receive Failed");
+                       else if (error == OTA_END_ERROR) LOGE(TAG, "End Failed"); });
   ArduinoOTA.begin();
 }
 
@@ -588,6 +814,9 @@ bool loadUnit()
   String ledEnabledStr = doc["ledEnabled"].as<String>();
   ledEnabled = ledEnabledStr == "1";
 
+  if (doc.containsKey("language"))
+    language_code = doc["language"].as<String>();
+
   return true;
 }
 
@@ -612,7 +841,7 @@ bool loadOthers()
   std::unique_ptr<char[]> buf(new char[size]);
 
   configFile.readBytes(buf.get(), size);
-  const size_t capacity = JSON_OBJECT_SIZE(3) + 200;
+  const size_t capacity = JSON_OBJECT_SIZE(8) + 400;
   DynamicJsonDocument doc(capacity);
   deserializeJson(doc, buf.get());
   // unit
@@ -621,8 +850,13 @@ bool loadOthers()
     useFahrenheit = true;
   others_haa_topic = doc["haat"].as<String>();
   String avail_report = doc["avail_report"].as<String>();
+  String state_history = doc["state_history"].as<String>();
+  String power_save = doc["power_save"].as<String>();
   String haa = doc["haa"].as<String>();
   String debug = doc["debug"].as<String>();
+  Log.setLevels(doc["log_levels"] | "");
+  others_syslog = doc["syslog"] | "";
+  syslogSink.begin(others_syslog.c_str(), hostname.c_str());
 
   if (strcmp(haa.c_str(), "OFF") == 0)
   {
@@ -632,6 +866,14 @@ bool loadOthers()
   {
     others_avail_report = false;
   }
+  if (strcmp(state_history.c_str(), "ON") == 0)
+  {
+    others_state_history = true;
+  }
+  if (strcmp(power_save.c_str(), "ON") == 0)
+  {
+    others_power_save = true;
+  }
   if (strcmp(debug.c_str(), "ON") == 0)
   {
     _debugMode = true;
@@ -646,6 +888,8 @@ void setDefaults()
   ap_pwd = "";
   others_haa = true;
   others_avail_report = true;
+  others_state_history = false;
+  others_power_save = false;
   others_haa_topic = "homeassistant";
 }
 
@@ -695,14 +939,152 @@ boolean initWifi()
 
 // Handler webserver response
 
+// Fields of html_common_header / html_common_footer, also the fallback for page resolvers.
+void commonPageField(uint8_t field, HtmlWriter &out)
+{
+  switch (field)
+  {
+  case HF_UNIT_NAME:
+    out.print(hostname);
+    if (_debugMode)
+      out.print("&nbsp[DEBUG MODE]");
+    break;
+  case HF_VERSION:
+    out.print(dk2mqtt_version);
+    break;
+  case HF_ASSET_VERSION:
+    out.print(WEB_ASSETS_VERSION);
+    break;
+  }
+}
+
+// Static assets from web/ are stored gzipped (tools/web_assets.py). URLs carry ?v=WEB_ASSETS_VERSION,
+// so they can be cached for good, the ETag still lets a reload revalidate with a 304.
+void sendWebAsset(const WebAsset &asset)
+{
+  server.sendHeader("ETag", asset.etag);
+  server.sendHeader("Cache-Control", "public, max-age=31536000, immutable");
+  if (server.header("If-None-Match") == asset.etag)
+  {
+    server.send(304);
+    return;
+  }
+  server.sendHeader("Content-Encoding", "gzip");
+  server.send_P(200, asset.contentType, (PGM_P)asset.data, asset.length);
+}
+
+void initWebAssets()
+{
+  for (size_t i = 0; i < web_assets_count; i++)
+  {
+    const WebAsset &asset = web_assets[i];
+    server.on(asset.path, HTTP_GET, [&asset]()
+              { sendWebAsset(asset); });
+  }
+  // here the list of headers to be recorded, use for authentication, asset revalidation and /events resume
+  const char *headerkeys[] = {"User-Agent", "Cookie", "If-None-Match", "Last-Event-ID"};
+  size_t headerkeyssize = sizeof(headerkeys) / sizeof(char *);
+  // ask server to track these headers
+  server.collectHeaders(headerkeys, headerkeyssize);
+}
+
+// Requests are served here instead of loop(), so a page never waits for MQTT.
+// Handlers read controllerSnapshot and post changes to controllerCommands, the controller is only
+// touched by its own task and the MQTT client by loop().
+void webServerTask(void *parameter)
+{
+  for (;;)
+  {
+    {
+      PROFILE_SCOPE(PROF_HTTP);
+      server.handleClient();
+    }
+    {
+      PROFILE_SCOPE(PROF_EVENTS);
+      eventStreamStep();
+    }
+    {
+      PROFILE_SCOPE(PROF_SYSLOG);
+      syslogSink.step();
+    }
+    // In power save new connections wait a little so the core stays idle, a request in progress does not
+    bool waitLonger = powerSave.enabled() && !server.client().connected();
+    vTaskDelay(waitLonger ? pdMS_TO_TICKS(WEB_POWER_SAVE_POLL_INTERVAL_MS) : 1);
+  }
+}
+
+// Push state changes and new log text to the /events subscribers. The snapshot version only moves
+// when the controller task published something different, so an idle unit costs one load per pass.
+void eventStreamStep()
+{
+  if (events.count() == 0)
+    return;
+
+  uint32_t version = controllerSnapshot.version();
+  if (version != eventStateVersion || events.needsState())
+  {
+    ControllerSnapshot snapshot = controllerSnapshot.read();
+    HVACState state;
+    readHeatPumpStatus(state, snapshot.status, snapshot.settings, snapshot.protocol);
+    events.sendState(state);
+    eventStateVersion = snapshot.version;
+  }
+  events.sendLogs();
+
+  if (millis() - lastEventPing > EVENT_PING_INTERVAL_MS)
+  {
+    events.ping();
+    lastEventPing = millis();
+  }
+}
+
+void startWebServer()
+{
+  server.begin();
+  // Created before anything can post, the controller task only starts once the unit was tried
+  controllerCommands = xQueueCreate(CONTROLLER_COMMAND_QUEUE_SIZE, sizeof(ControllerCommand));
+  controllerResults = xQueueCreate(CONTROLLER_RESULT_QUEUE_SIZE, sizeof(ControllerResult));
+  passthroughFrames = xQueueCreate(PASSTHROUGH_QUEUE_SIZE, sizeof(PassthroughFrame));
+  // Handlers must never see a zeroed snapshot, its setting strings would be null
+  publishControllerSnapshot();
+  // Core 0 next to the WiFi stack and loop(), the controller task keeps core 1 to itself
+  xTaskCreatePinnedToCore(webServerTask, "web", WEB_TASK_STACK_SIZE, NULL, 1, &webTask, 0);
+}
+
+// Start a chunked text/html response, the returned writer's sink sends each chunk.
+HtmlWriter beginHTMLResponse()
+{
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "text/html", "");
+  return HtmlWriter([](const char *data, size_t len)
+                    { server.sendContent(data, len); });
+}
+
+void endHTMLResponse(HtmlWriter &out)
+{
+  out.flush();
+  // Signal the end of the content
+  server.sendContent("");
+}
+
+// Render a page between the common header and footer, used by the streamed handlers and the benchmark.
+void renderWrappedPage(HtmlWriter &out, const HtmlTemplate &page, HTML_RESOLVER_SIGNATURE)
+{
+  renderTemplate(out, html_common_header_template, commonPageField);
+  renderTemplate(out, page, resolver);
+  renderTemplate(out, html_common_footer_template, commonPageField);
+}
+
+// Pages still built with String::replace: only the header and footer are streamed around them.
 void sendWrappedHTML(String content)
 {
-  String headerContent = FPSTR(html_common_header);
-  String footerContent = FPSTR(html_common_footer);
-  String toSend = headerContent + content + footerContent;
-  toSend.replace(F("_UNIT_NAME_"), _debugMode ? hostname + "&nbsp[DEBUG MODE]" : hostname);
-  toSend.replace(F("_VERSION_"), dk2mqtt_version);
-  server.send(200, F("text/html"), toSend);
+  content.replace(F("_UNIT_NAME_"), hostname);
+  content.replace(F("_VERSION_"), dk2mqtt_version);
+  HtmlWriter out = beginHTMLResponse();
+  renderTemplate(out, html_common_header_template, commonPageField);
+  out.print(content);
+  renderTemplate(out, html_common_footer_template, commonPageField);
+  endHTMLResponse(out);
 }
 
 void handleNotFound()
@@ -733,7 +1115,7 @@ void handleSaveInit()
     saveMqtt(server.arg("fn"), server.arg("mh"), server.arg("ml"), server.arg("mu"), server.arg("mp"), server.arg("mt"));
   }
   String initSavePage = FPSTR(html_init_save);
-  initSavePage.replace("_TXT_INIT_REBOOT_MESS_", FPSTR(txt_init_reboot_mes));
+  initSavePage.replace("_TXT_INIT_REBOOT_MESS_", language.text(TXT_INIT_REBOOT_MES));
   sendWrappedHTML(initSavePage);
   delay(500);
   ESP.restart();
@@ -745,7 +1127,7 @@ void handleReboot()
     return;
 
   String initRebootPage = FPSTR(html_init_reboot);
-  initRebootPage.replace("_TXT_INIT_REBOOT_", FPSTR(txt_init_reboot));
+  initRebootPage.replace("_TXT_INIT_REBOOT_", language.text(TXT_INIT_REBOOT));
   sendWrappedHTML(initRebootPage);
   delay(500);
   ESP.restart();
@@ -760,7 +1142,7 @@ void handleRoot()
   {
     String rebootPage = FPSTR(html_page_reboot);
     String countDown = FPSTR(count_down_script);
-    rebootPage.replace("_TXT_M_REBOOT_", FPSTR(txt_m_reboot));
+    rebootPage.replace("_TXT_M_REBOOT_", language.text(TXT_M_REBOOT));
     sendWrappedHTML(rebootPage + countDown);
     delay(500);
 #ifdef ESP32
@@ -774,14 +1156,14 @@ void handleRoot()
     String menuRootPage = FPSTR(html_menu_root);
     menuRootPage.replace("_SHOW_LOGOUT_", (String)(login_password.length() > 0));
     // not show control button if hp not connected or in debug mode.
-    menuRootPage.replace("_SHOW_CONTROL_", (String)(ac.isConnected() && !_debugMode));
-    menuRootPage.replace("_TXT_CONTROL_", FPSTR(txt_control));
-    menuRootPage.replace("_TXT_SETUP_", FPSTR(txt_setup));
-    menuRootPage.replace("_TXT_STATUS_", FPSTR(txt_status));
-    menuRootPage.replace("_TXT_LOGGING", FPSTR(txt_logging));
-    menuRootPage.replace("_TXT_FW_UPGRADE_", FPSTR(txt_firmware_upgrade));
-    menuRootPage.replace("_TXT_REBOOT_", FPSTR(txt_reboot));
-    menuRootPage.replace("_TXT_LOGOUT_", FPSTR(txt_logout));
+    menuRootPage.replace("_SHOW_CONTROL_", (String)(controllerSnapshot.read().connected && !_debugMode));
+    menuRootPage.replace("_TXT_CONTROL_", language.text(TXT_CONTROL));
+    menuRootPage.replace("_TXT_SETUP_", language.text(TXT_SETUP));
+    menuRootPage.replace("_TXT_STATUS_", language.text(TXT_STATUS));
+    menuRootPage.replace("_TXT_LOGGING_", language.text(TXT_LOGGING));
+    menuRootPage.replace("_TXT_FW_UPGRADE_", language.text(TXT_FIRMWARE_UPGRADE));
+    menuRootPage.replace("_TXT_REBOOT_", language.text(TXT_REBOOT));
+    menuRootPage.replace("_TXT_LOGOUT_", language.text(TXT_LOGOUT));
     sendWrappedHTML(menuRootPage);
   }
 }
@@ -789,21 +1171,21 @@ void handleRoot()
 void handleInitSetup()
 {
   String initSetupPage = FPSTR(html_init_setup);
-  initSetupPage.replace("_TXT_INIT_TITLE_", FPSTR(txt_init_title));
-  initSetupPage.replace("_TXT_INIT_HOST_", FPSTR(txt_wifi_hostname));
-  initSetupPage.replace("_TXT_INIT_SSID_", FPSTR(txt_wifi_SSID));
-  initSetupPage.replace("_TXT_INIT_PSK_", FPSTR(txt_wifi_psk));
-  initSetupPage.replace("_TXT_INIT_OTA_", FPSTR(txt_wifi_otap));
-  initSetupPage.replace("_TXT_SAVE_", FPSTR(txt_save));
-  initSetupPage.replace("_TXT_REBOOT_", FPSTR(txt_reboot));
-
-  initSetupPage.replace("_TXT_MQTT_TITLE_", FPSTR(txt_mqtt_title));
-  initSetupPage.replace("_TXT_MQTT_FN_", FPSTR(txt_mqtt_fn));
-  initSetupPage.replace("_TXT_MQTT_HOST_", FPSTR(txt_mqtt_host));
-  initSetupPage.replace("_TXT_MQTT_PORT_", FPSTR(txt_mqtt_port));
-  initSetupPage.replace("_TXT_MQTT_USER_", FPSTR(txt_mqtt_user));
-  initSetupPage.replace("_TXT_MQTT_PASSWORD_", FPSTR(txt_mqtt_password));
-  initSetupPage.replace("_TXT_MQTT_TOPIC_", FPSTR(txt_mqtt_topic));
+  initSetupPage.replace("_TXT_INIT_TITLE_", language.text(TXT_INIT_TITLE));
+  initSetupPage.replace("_TXT_INIT_HOST_", language.text(TXT_WIFI_HOSTNAME));
+  initSetupPage.replace("_TXT_INIT_SSID_", language.text(TXT_WIFI_SSID));
+  initSetupPage.replace("_TXT_INIT_PSK_", language.text(TXT_WIFI_PSK));
+  initSetupPage.replace("_TXT_INIT_OTA_", language.text(TXT_WIFI_OTAP));
+  initSetupPage.replace("_TXT_SAVE_", language.text(TXT_SAVE));
+  initSetupPage.replace("_TXT_REBOOT_", language.text(TXT_REBOOT));
+
+  initSetupPage.replace("_TXT_MQTT_TITLE_", language.text(TXT_MQTT_TITLE));
+  initSetupPage.replace("_TXT_MQTT_FN_", language.text(TXT_MQTT_FN));
+  initSetupPage.replace("_TXT_MQTT_HOST_", language.text(TXT_MQTT_HOST));
+  initSetupPage.replace("_TXT_MQTT_PORT_", language.text(TXT_MQTT_PORT));
+  initSetupPage.replace("_TXT_MQTT_USER_", language.text(TXT_MQTT_USER));
+  initSetupPage.replace("_TXT_MQTT_PASSWORD_", language.text(TXT_MQTT_PASSWORD));
+  initSetupPage.replace("_TXT_MQTT_TOPIC_", language.text(TXT_MQTT_TOPIC));
   initSetupPage.replace(F("_MQTT_FN_"), hostname);
   initSetupPage.replace(F("_MQTT_HOST_"), "");
   initSetupPage.replace(F("_MQTT_PORT_"), "");
@@ -824,7 +1206,7 @@ void handleSetup()
     String pageReset = FPSTR(html_page_reset);
     String ssid = hostnamePrefix;
     ssid += getId();
-    pageReset.replace("_TXT_M_RESET_", FPSTR(txt_m_reset));
+    pageReset.replace("_TXT_M_RESET_", language.text(TXT_M_RESET));
     pageReset.replace("_SSID_", ssid);
     sendWrappedHTML(pageReset);
     SPIFFS.format();
@@ -838,13 +1220,13 @@ void handleSetup()
   else
   {
     String menuSetupPage = FPSTR(html_menu_setup);
-    menuSetupPage.replace("_TXT_MQTT_", FPSTR(txt_MQTT));
-    menuSetupPage.replace("_TXT_WIFI_", FPSTR(txt_WIFI));
-    menuSetupPage.replace("_TXT_UNIT_", FPSTR(txt_unit));
-    menuSetupPage.replace("_TXT_OTHERS_", FPSTR(txt_others));
-    menuSetupPage.replace("_TXT_RESET_", FPSTR(txt_reset));
-    menuSetupPage.replace("_TXT_BACK_", FPSTR(txt_back));
-    menuSetupPage.replace("_TXT_RESETCONFIRM_", FPSTR(txt_reset_confirm));
+    menuSetupPage.replace("_TXT_MQTT_", language.text(TXT_MQTT));
+    menuSetupPage.replace("_TXT_WIFI_", language.text(TXT_WIFI));
+    menuSetupPage.replace("_TXT_UNIT_", language.text(TXT_UNIT));
+    menuSetupPage.replace("_TXT_OTHERS_", language.text(TXT_OTHERS));
+    menuSetupPage.replace("_TXT_RESET_", language.text(TXT_RESET));
+    menuSetupPage.replace("_TXT_BACK_", language.text(TXT_BACK));
+    menuSetupPage.replace("_TXT_RESETCONFIRM_", language.text(TXT_RESET_CONFIRM));
     sendWrappedHTML(menuSetupPage);
   }
 }
@@ -853,7 +1235,7 @@ void rebootAndSendPage()
 {
   String saveRebootPage = FPSTR(html_page_save_reboot);
   String countDown = FPSTR(count_down_script);
-  saveRebootPage.replace("_TXT_M_SAVE_", FPSTR(txt_m_save));
+  saveRebootPage.replace("_TXT_M_SAVE_", language.text(TXT_M_SAVE));
   sendWrappedHTML(saveRebootPage + countDown);
   delay(500);
   ESP.restart();
@@ -866,21 +1248,32 @@ void handleOthers()
 
   if (server.method() == HTTP_POST)
   {
-    saveOthers(server.arg("HAA"), server.arg("haat"), server.arg("AVAIL_REPORT"), server.arg("Debug"));
+    String syslog = server.arg("SYSLOG");
+    syslog.trim();
+    if (!SyslogSink::validServer(syslog.c_str()))
+    {
+      LOGW(TAG, "Syslog server not saved, expected host or host:port");
+      syslog = others_syslog;
+    }
+    saveOthers(server.arg("HAA"), server.arg("haat"), server.arg("AVAIL_REPORT"), server.arg("STATE_HISTORY"), server.arg("POWER_SAVE"), server.arg("Debug"), server.arg("LOG_LEVELS"), syslog);
     rebootAndSendPage();
   }
   else
   {
     String othersPage = FPSTR(html_page_others);
-    othersPage.replace("_TXT_SAVE_", FPSTR(txt_save));
-    othersPage.replace("_TXT_BACK_", FPSTR(txt_back));
-    othersPage.replace("_TXT_F_ON_", FPSTR(txt_f_on));
-    othersPage.replace("_TXT_F_OFF_", FPSTR(txt_f_off));
-    othersPage.replace("_TXT_OTHERS_TITLE_", FPSTR(txt_others_title));
-    othersPage.replace("_TXT_OTHERS_HAAUTO_", FPSTR(txt_others_haauto));
-    othersPage.replace("_TXT_OTHERS_HATOPIC_", FPSTR(txt_others_hatopic));
-    othersPage.replace("_TXT_OTHERS_AVAILABILITY_REPORT_", FPSTR(txt_others_availability_report));
-    othersPage.replace("_TXT_OTHERS_DEBUG_", FPSTR(txt_others_debug));
+    othersPage.replace("_TXT_SAVE_", language.text(TXT_SAVE));
+    othersPage.replace("_TXT_BACK_", language.text(TXT_BACK));
+    othersPage.replace("_TXT_F_ON_", language.text(TXT_F_ON));
+    othersPage.replace("_TXT_F_OFF_", language.text(TXT_F_OFF));
+    othersPage.replace("_TXT_OTHERS_TITLE_", language.text(TXT_OTHERS_TITLE));
+    othersPage.replace("_TXT_OTHERS_HAAUTO_", language.text(TXT_OTHERS_HAAUTO));
+    othersPage.replace("_TXT_OTHERS_HATOPIC_", language.text(TXT_OTHERS_HATOPIC));
+    othersPage.replace("_TXT_OTHERS_AVAILABILITY_REPORT_", language.text(TXT_OTHERS_AVAILABILITY_REPORT));
+    othersPage.replace("_TXT_OTHERS_STATE_HISTORY_", language.text(TXT_OTHERS_STATE_HISTORY));
+    othersPage.replace("_TXT_OTHERS_POWER_SAVE_", language.text(TXT_OTHERS_POWER_SAVE));
+    othersPage.replace("_TXT_OTHERS_DEBUG_", language.text(TXT_OTHERS_DEBUG));
+    othersPage.replace("_TXT_OTHERS_LOG_LEVELS_", language.text(TXT_OTHERS_LOG_LEVELS));
+    othersPage.replace("_TXT_OTHERS_SYSLOG_", language.text(TXT_OTHERS_SYSLOG));
 
     othersPage.replace("_HAA_TOPIC_", others_haa_topic);
     if (others_haa)
@@ -901,6 +1294,24 @@ void handleOthers()
       othersPage.replace("_HA_AVAIL_REPORT_OFF_", "selected");
     }
 
+    if (others_state_history)
+    {
+      othersPage.replace("_STATE_HISTORY_ON_", "selected");
+    }
+    else
+    {
+      othersPage.replace("_STATE_HISTORY_OFF_", "selected");
+    }
+
+    if (others_power_save)
+    {
+      othersPage.replace("_POWER_SAVE_ON_", "selected");
+    }
+    else
+    {
+      othersPage.replace("_POWER_SAVE_OFF_", "selected");
+    }
+
     if (_debugMode)
     {
       othersPage.replace("_DEBUG_ON_", "selected");
@@ -909,6 +1320,12 @@ void handleOthers()
     {
       othersPage.replace("_DEBUG_OFF_", "selected");
     }
+    char logLevels[LOG_TAG_LEVELS * (LOG_TAG_MAX + 8) + 16];
+    Log.levels(logLevels, sizeof(logLevels));
+    othersPage.replace("_LOG_LEVELS_", logLevels);
+    String str_syslog = others_syslog;
+    str_syslog.replace("'", F("&apos;"));
+    othersPage.replace("_SYSLOG_", str_syslog);
     sendWrappedHTML(othersPage);
   }
 }
@@ -926,15 +1343,15 @@ void handleMqtt()
   else
   {
     String mqttPage = FPSTR(html_page_mqtt);
-    mqttPage.replace("_TXT_SAVE_", FPSTR(txt_save));
-    mqttPage.replace("_TXT_BACK_", FPSTR(txt_back));
-    mqttPage.replace("_TXT_MQTT_TITLE_", FPSTR(txt_mqtt_title));
-    mqttPage.replace("_TXT_MQTT_FN_", FPSTR(txt_mqtt_fn));
-    mqttPage.replace("_TXT_MQTT_HOST_", FPSTR(txt_mqtt_host));
-    mqttPage.replace("_TXT_MQTT_PORT_", FPSTR(txt_mqtt_port));
-    mqttPage.replace("_TXT_MQTT_USER_", FPSTR(txt_mqtt_user));
-    mqttPage.replace("_TXT_MQTT_PASSWORD_", FPSTR(txt_mqtt_password));
-    mqttPage.replace("_TXT_MQTT_TOPIC_", FPSTR(txt_mqtt_topic));
+    mqttPage.replace("_TXT_SAVE_", language.text(TXT_SAVE));
+    mqttPage.replace("_TXT_BACK_", language.text(TXT_BACK));
+    mqttPage.replace("_TXT_MQTT_TITLE_", language.text(TXT_MQTT_TITLE));
+    mqttPage.replace("_TXT_MQTT_FN_", language.text(TXT_MQTT_FN));
+    mqttPage.replace("_TXT_MQTT_HOST_", language.text(TXT_MQTT_HOST));
+    mqttPage.replace("_TXT_MQTT_PORT_", language.text(TXT_MQTT_PORT));
+    mqttPage.replace("_TXT_MQTT_USER_", language.text(TXT_MQTT_USER));
+    mqttPage.replace("_TXT_MQTT_PASSWORD_", language.text(TXT_MQTT_PASSWORD));
+    mqttPage.replace("_TXT_MQTT_TOPIC_", language.text(TXT_MQTT_TOPIC));
     mqttPage.replace(F("_MQTT_FN_"), mqtt_fn);
     mqttPage.replace(F("_MQTT_HOST_"), mqtt_server);
     mqttPage.replace(F("_MQTT_PORT_"), String(mqtt_port));
@@ -945,6 +1362,51 @@ void handleMqtt()
   }
 }
 
+static void selectedIf(HtmlWriter &out, bool selected)
+{
+  if (selected)
+    out.print("selected");
+}
+
+// Fields of html_page_unit, its texts are written by renderTemplate.
+void unitPageField(uint8_t field, HtmlWriter &out)
+{
+  switch (field)
+  {
+  case HF_LANGUAGE_OPTIONS:
+    for (size_t i = 0; i < language_packs_count; i++)
+    {
+      const LanguagePack &pack = language_packs[i];
+      out.print("<option value='");
+      out.print(pack.code);
+      out.print("' ");
+      selectedIf(out, strcmp(pack.code, language.code()) == 0);
+      out.print(">");
+      out.print(pack.name);
+      out.print("</option>");
+    }
+    break;
+  case HF_MIN_TEMP: out.print(convertCelsiusToLocalUnit(min_temp, useFahrenheit)); break;
+  case HF_MAX_TEMP: out.print(convertCelsiusToLocalUnit(max_temp, useFahrenheit)); break;
+  case HF_TEMP_STEP: out.print(temp_step); break;
+  case HF_TU_FAH: selectedIf(out, useFahrenheit); break;
+  case HF_TU_CEL: selectedIf(out, !useFahrenheit); break;
+  case HF_MD_ALL: selectedIf(out, supportHeatMode); break;
+  case HF_MD_NONHEAT: selectedIf(out, !supportHeatMode); break;
+  case HF_LOGIN_PASSWORD: out.print(login_password); break;
+  case HF_BEEP_ON: selectedIf(out, beep); break;
+  case HF_BEEP_OFF: selectedIf(out, !beep); break;
+  case HF_LED_ON: selectedIf(out, ledEnabled); break;
+  case HF_LED_OFF: selectedIf(out, !ledEnabled); break;
+  case HF_UPDATE_5S: selectedIf(out, update_int == 5000); break;
+  case HF_UPDATE_15S: selectedIf(out, update_int == 15000); break;
+  case HF_UPDATE_30S: selectedIf(out, update_int == 30000); break;
+  case HF_UPDATE_45S: selectedIf(out, update_int == 45000); break;
+  case HF_UPDATE_60S: selectedIf(out, update_int == 60000); break;
+  default: commonPageField(field, out); break;
+  }
+}
+
 void handleUnit()
 {
   if (!checkLogin())
@@ -952,85 +1414,14 @@ void handleUnit()
 
   if (server.method() == HTTP_POST)
   {
-    saveUnit(server.arg("tu"), server.arg("md"), server.arg("update_int"), server.arg("lpw"), (String)convertLocalUnitToCelsius(server.arg("min_temp").toInt(), useFahrenheit), (String)convertLocalUnitToCelsius(server.arg("max_temp").toInt(), useFahrenheit), server.arg("temp_step"), server.arg("beep"), server.arg("led"));
+    saveUnit(server.arg("tu"), server.arg("md"), server.arg("update_int"), server.arg("lpw"), (String)convertLocalUnitToCelsius(server.arg("min_temp").toInt(), useFahrenheit), (String)convertLocalUnitToCelsius(server.arg("max_temp").toInt(), useFahrenheit), server.arg("temp_step"), server.arg("beep"), server.arg("led"), server.arg("language"));
     rebootAndSendPage();
   }
   else
   {
-    String unitPage = FPSTR(html_page_unit);
-    unitPage.replace("_TXT_SAVE_", FPSTR(txt_save));
-    unitPage.replace("_TXT_BACK_", FPSTR(txt_back));
-    unitPage.replace("_TXT_UNIT_TITLE_", FPSTR(txt_unit_title));
-    unitPage.replace("_TXT_UNIT_TEMP_", FPSTR(txt_unit_temp));
-    unitPage.replace("_TXT_UNIT_MINTEMP_", FPSTR(txt_unit_mintemp));
-    unitPage.replace("_TXT_UNIT_MAXTEMP_", FPSTR(txt_unit_maxtemp));
-    unitPage.replace("_TXT_UNIT_STEPTEMP_", FPSTR(txt_unit_steptemp));
-    unitPage.replace("_TXT_UNIT_MODES_", FPSTR(txt_unit_modes));
-    unitPage.replace("_TXT_UNIT_UPDATE_INTERVAL_", FPSTR(txt_unit_update_interval));
-    unitPage.replace("_TXT_UNIT_PASSWORD_", FPSTR(txt_unit_password));
-    unitPage.replace("_TXT_UNIT_BEEP_", FPSTR(txt_unit_beep));
-    unitPage.replace("_TXT_UNIT_LED_", FPSTR(txt_unit_led));
-    unitPage.replace("_TXT_F_CELSIUS_", FPSTR(txt_f_celsius));
-    unitPage.replace("_TXT_F_FH_", FPSTR(txt_f_fh));
-    unitPage.replace("_TXT_F_ALLMODES_", FPSTR(txt_f_allmodes));
-    unitPage.replace("_TXT_F_NOHEAT_", FPSTR(txt_f_noheat));
-    unitPage.replace("_TXT_F_5_S", FPSTR(txt_f_5s));
-    unitPage.replace("_TXT_F_15_S", FPSTR(txt_f_15s));
-    unitPage.replace("_TXT_F_30_S", FPSTR(txt_f_30s));
-    unitPage.replace("_TXT_F_45_S", FPSTR(txt_f_45s));
-    unitPage.replace("_TXT_F_60_S", FPSTR(txt_f_60s));
-    unitPage.replace("_TXT_F_BEEP_ON_", FPSTR(txt_f_beep_on));
-    unitPage.replace("_TXT_F_BEEP_OFF_", FPSTR(txt_f_beep_off));
-    unitPage.replace("_TXT_F_LED_ON_", FPSTR(txt_f_led_on));
-    unitPage.replace("_TXT_F_LED_OFF_", FPSTR(txt_f_led_off));
-    unitPage.replace(F("_MIN_TEMP_"), String(convertCelsiusToLocalUnit(min_temp, useFahrenheit)));
-    unitPage.replace(F("_MAX_TEMP_"), String(convertCelsiusToLocalUnit(max_temp, useFahrenheit)));
-    unitPage.replace(F("_TEMP_STEP_"), String(temp_step));
-    // temp
-    if (useFahrenheit)
-      unitPage.replace(F("_TU_FAH_"), F("selected"));
-    else
-      unitPage.replace(F("_TU_CEL_"), F("selected"));
-    // mode
-    if (supportHeatMode)
-      unitPage.replace(F("_MD_ALL_"), F("selected"));
-    else
-      unitPage.replace(F("_MD_NONHEAT_"), F("selected"));
-    unitPage.replace(F("_LOGIN_PASSWORD_"), login_password);
-
-    // beep
-    if (beep)
-      unitPage.replace(F("_BEEP_ON_"), F("selected"));
-    else
-      unitPage.replace(F("_BEEP_OFF_"), F("selected"));
-
-    // led
-    if (ledEnabled)
-      unitPage.replace(F("_LED_ON_"), F("selected"));
-    else
-      unitPage.replace(F("_LED_OFF_"), F("selected"));
-
-
-    switch (update_int)
-    {
-    case (5000):
-      unitPage.replace(F("_UPDATE_5S_"), F("selected"));
-      break;
-    case (15000):
-      unitPage.replace(F("_UPDATE_15S_"), F("selected"));
-      break;
-    case (30000):
-      unitPage.replace(F("_UPDATE_30S_"), F("selected"));
-      break;
-    case (45000):
-      unitPage.replace(F("_UPDATE_45S_"), F("selected"));
-      break;
-    case (60000):
-      unitPage.replace(F("_UPDATE_60S_"), F("selected"));
-      break;
-    }
-
-    sendWrappedHTML(unitPage);
+    HtmlWriter out = beginHTMLResponse();
+    renderWrappedPage(out, html_page_unit_template, unitPageField);
+    endHTMLResponse(out);
   }
 }
 
@@ -1058,13 +1449,13 @@ void handleWifi()
     str_ap_ssid.replace("'", F("&apos;"));
     str_ap_pwd.replace("'", F("&apos;"));
     str_ota_pwd.replace("'", F("&apos;"));
-    wifiPage.replace("_TXT_SAVE_", FPSTR(txt_save));
-    wifiPage.replace("_TXT_BACK_", FPSTR(txt_back));
-    wifiPage.replace("_TXT_WIFI_TITLE_", FPSTR(txt_wifi_title));
-    wifiPage.replace("_TXT_WIFI_HOST_", FPSTR(txt_wifi_hostname));
-    wifiPage.replace("_TXT_WIFI_SSID_", FPSTR(txt_wifi_SSID));
-    wifiPage.replace("_TXT_WIFI_PSK_", FPSTR(txt_wifi_psk));
-    wifiPage.replace("_TXT_WIFI_OTAP_", FPSTR(txt_wifi_otap));
+    wifiPage.replace("_TXT_SAVE_", language.text(TXT_SAVE));
+    wifiPage.replace("_TXT_BACK_", language.text(TXT_BACK));
+    wifiPage.replace("_TXT_WIFI_TITLE_", language.text(TXT_WIFI_TITLE));
+    wifiPage.replace("_TXT_WIFI_HOST_", language.text(TXT_WIFI_HOSTNAME));
+    wifiPage.replace("_TXT_WIFI_SSID_", language.text(TXT_WIFI_SSID));
+    wifiPage.replace("_TXT_WIFI_PSK_", language.text(TXT_WIFI_PSK));
+    wifiPage.replace("_TXT_WIFI_OTAP_", language.text(TXT_WIFI_OTAP));
     wifiPage.replace(F("_SSID_"), str_ap_ssid);
     wifiPage.replace(F("_PSK_"), str_ap_pwd);
     wifiPage.replace(F("_OTA_PWD_"), str_ota_pwd);
@@ -1072,35 +1463,52 @@ void handleWifi()
   }
 }
 
+// One row per profiled section, in microseconds since boot
+static String profileTable()
+{
+  String table = F("<table style='width:100%;text-align:right'><tr><th></th><th>n</th><th>p50</th><th>p99</th><th>max</th></tr>");
+  char row[160];
+  for (uint8_t i = 0; i < PROF_COUNT; i++)
+  {
+    ProfileStats stats = profiler.stats((ProfileSection)i);
+    snprintf(row, sizeof(row), "<tr><td style='text-align:left'>%s</td><td>%u</td><td>%.0f</td><td>%.0f</td><td>%.0f</td></tr>",
+             Profiler::name(i), stats.count, stats.p50Us, stats.p99Us, stats.maxUs);
+    table += row;
+  }
+  table += F("</table>");
+  return table;
+}
+
 void handleStatus()
 {
   if (!checkLogin())
     return;
 
   String statusPage = FPSTR(html_page_status);
-  statusPage.replace("_TXT_BACK_", FPSTR(txt_back));
-  statusPage.replace("_TXT_STATUS_TITLE_", FPSTR(txt_status_title));
-  statusPage.replace("_TXT_STATUS_HVAC_", FPSTR(txt_status_hvac));
-  statusPage.replace("_TXT_STATUS_MQTT_", FPSTR(txt_status_mqtt));
-  statusPage.replace("_TXT_STATUS_WIFI_", FPSTR(txt_status_wifi));
-  statusPage.replace("_TXT_RETRIES_HVAC_", FPSTR(txt_retries_hvac));
+  statusPage.replace("_TXT_BACK_", language.text(TXT_BACK));
+  statusPage.replace("_TXT_STATUS_TITLE_", language.text(TXT_STATUS_TITLE));
+  statusPage.replace("_TXT_STATUS_HVAC_", language.text(TXT_STATUS_HVAC));
+  statusPage.replace("_TXT_STATUS_MQTT_", language.text(TXT_STATUS_MQTT));
+  statusPage.replace("_TXT_STATUS_WIFI_", language.text(TXT_STATUS_WIFI));
+  statusPage.replace("_TXT_RETRIES_HVAC_", language.text(TXT_RETRIES_HVAC));
 
   if (server.hasArg("mrconn"))
-    mqttConnect();
+    mqttConnectRequested = true;
 
   String connected = F("<span style='color:#47c266'><b>");
-  connected += FPSTR(txt_status_connect);
+  connected += language.text(TXT_STATUS_CONNECT);
   connected += F("</b><span>");
 
   String disconnected = F("<span style='color:#d43535'><b>");
-  disconnected += FPSTR(txt_status_disconnect);
+  disconnected += language.text(TXT_STATUS_DISCONNECT);
   disconnected += F("</b></span>");
 
-  if (ac.isConnected())
+  ControllerSnapshot snapshot = controllerSnapshot.read();
+  if (snapshot.connected)
   {
 
     statusPage.replace(F("_HVAC_STATUS_"), connected);
-    statusPage.replace(F("_HVAC_PROTOCOL_"), (ac.daikinUART->currentProtocol() == PROTOCOL_S21) ? "[S21]" : "[X50]");
+    statusPage.replace(F("_HVAC_PROTOCOL_"), (snapshot.protocol == PROTOCOL_S21) ? "[S21]" : "[X50]");
   }
   else
   {
@@ -1108,13 +1516,25 @@ void handleStatus()
     statusPage.replace(F("_HVAC_PROTOCOL_"), "");
   }
 
-  if (mqtt_client.connected())
+  int brokerState = mqttState;
+  if (brokerState == MQTT_CONNECTED)
     statusPage.replace(F("_MQTT_STATUS_"), connected);
   else
     statusPage.replace(F("_MQTT_STATUS_"), disconnected);
-  statusPage.replace(F("_HVAC_RETRIES_"), String(hpConnectionTotalRetries));
-  statusPage.replace(F("_MQTT_REASON_"), String(mqtt_client.state()));
+  statusPage.replace(F("_HVAC_RETRIES_"), String(snapshot.hpConnectionTotalRetries));
+  statusPage.replace(F("_MQTT_REASON_"), String(brokerState));
   statusPage.replace(F("_WIFI_STATUS_"), String(WiFi.RSSI()));
+  statusPage.replace(F("_TXT_STATUS_RESET_"), language.text(TXT_STATUS_RESET));
+  char resetDescription[256];
+  resetReport.describe(resetDescription, sizeof(resetDescription));
+  statusPage.replace(F("_RESET_REASON_"), resetDescription);
+  statusPage.replace("_TXT_STATUS_CPU_IDLE_", language.text(TXT_STATUS_CPU_IDLE));
+  char cpuIdle[64];
+  snprintf(cpuIdle, sizeof(cpuIdle), "%.0f%% / %.0f%%%s", powerSave.idlePercent(0), powerSave.idlePercent(1),
+           powerSave.enabled() ? " (modem sleep)" : "");
+  statusPage.replace(F("_CPU_IDLE_"), cpuIdle);
+  statusPage.replace("_TXT_STATUS_PROFILE_", language.text(TXT_STATUS_PROFILE));
+  statusPage.replace(F("_PROFILE_"), profileTable());
   sendWrappedHTML(statusPage);
 }
 
@@ -1124,148 +1544,77 @@ void handleControl()
     return;
 
   // not connected to hp, redirect to status page
-  if (!ac.isConnected())
+  if (!controllerSnapshot.read().connected)
   {
     server.sendHeader("Location", "/status");
     server.sendHeader("Cache-Control", "no-cache");
     server.send(302);
     return;
   }
-  HVACSettings settings = ac.getSettings();
-
-  // memcpy(&settings, ac.getSettings(), sizeof(settings));
-  settings = change_states(settings);
-  String controlPage = FPSTR(html_page_control);
-  String headerContent = FPSTR(html_common_header);
-  String footerContent = FPSTR(html_common_footer);
-  // write_log("Enter HVAC control");
-  headerContent.replace("_UNIT_NAME_", hostname);
-  footerContent.replace("_VERSION_", dk2mqtt_version);
-  controlPage.replace("_TXT_BACK_", FPSTR(txt_back));
-  controlPage.replace("_UNIT_NAME_", hostname);
-  controlPage.replace("_RATE_", "60");
-  controlPage.replace("_ROOMTEMP_", String(convertCelsiusToLocalUnit(ac.getRoomTemperature(), useFahrenheit)));
-  controlPage.replace("_USE_FAHRENHEIT_", (String)useFahrenheit);
-  controlPage.replace("_TEMP_SCALE_", getTemperatureScale());
-  controlPage.replace("_HEAT_MODE_SUPPORT_", (String)supportHeatMode);
-  controlPage.replace("_X50_PROTOCOL_", (String)(ac.daikinUART->currentProtocol() == PROTOCOL_X50));
-  controlPage.replace(F("_MIN_TEMP_"), String(convertCelsiusToLocalUnit(min_temp, useFahrenheit)));
-  controlPage.replace(F("_MAX_TEMP_"), String(convertCelsiusToLocalUnit(max_temp, useFahrenheit)));
-  controlPage.replace(F("_TEMP_STEP_"), String(temp_step));
-  controlPage.replace("_TXT_CTRL_CTEMP_", FPSTR(txt_ctrl_ctemp));
-  controlPage.replace("_TXT_CTRL_TEMP_", FPSTR(txt_ctrl_temp));
-  controlPage.replace("_TXT_CTRL_TITLE_", FPSTR(txt_ctrl_title));
-  controlPage.replace("_TXT_CTRL_POWER_", FPSTR(txt_ctrl_power));
-  controlPage.replace("_TXT_CTRL_MODE_", FPSTR(txt_ctrl_mode));
-  controlPage.replace("_TXT_CTRL_FAN_", FPSTR(txt_ctrl_fan));
-  controlPage.replace("_TXT_CTRL_VANE_", FPSTR(txt_ctrl_vane));
-  controlPage.replace("_TXT_CTRL_WVANE_", FPSTR(txt_ctrl_wvane));
-  controlPage.replace("_TXT_F_ON_", FPSTR(txt_f_on));
-  controlPage.replace("_TXT_F_OFF_", FPSTR(txt_f_off));
-  controlPage.replace("_TXT_F_AUTO_", FPSTR(txt_f_auto));
-  controlPage.replace("_TXT_F_QUIET_", FPSTR(txt_f_quiet));
-  controlPage.replace("_TXT_F_HEAT_", FPSTR(txt_f_heat));
-  controlPage.replace("_TXT_F_DRY_", FPSTR(txt_f_dry));
-  controlPage.replace("_TXT_F_COOL_", FPSTR(txt_f_cool));
-  controlPage.replace("_TXT_F_FAN_", FPSTR(txt_f_fan));
-  controlPage.replace("_TXT_F_QUIET_", FPSTR(txt_f_quiet));
-  controlPage.replace("_TXT_F_SPEED_", FPSTR(txt_f_speed));
-  controlPage.replace("_TXT_F_SWING_", FPSTR(txt_f_swing));
-  controlPage.replace("_TXT_F_HOLD_", FPSTR(txt_f_hold));
-
-  if (strcmp(settings.power, "ON") == 0)
-  {
-    controlPage.replace("_POWER_ON_", "selected");
-  }
-  else if (strcmp(settings.power, "OFF") == 0)
-  {
-    controlPage.replace("_POWER_OFF_", "selected");
-  }
-
-  if (strcmp(settings.mode, "HEAT") == 0)
-  {
-    controlPage.replace("_MODE_H_", "selected");
-  }
-  else if (strcmp(settings.mode, "DRY") == 0)
-  {
-    controlPage.replace("_MODE_D_", "selected");
-  }
-  else if (strcmp(settings.mode, "COOL") == 0)
-  {
-    controlPage.replace("_MODE_C_", "selected");
-  }
-  else if (strcmp(settings.mode, "FAN") == 0)
-  {
-    controlPage.replace("_MODE_F_", "selected");
-  }
-  else if (strcmp(settings.mode, "AUTO") == 0)
-  {
-    controlPage.replace("_MODE_A_", "selected");
-  }
-
-  if (strcmp(settings.fan, "AUTO") == 0)
-  {
-    controlPage.replace("_FAN_A_", "selected");
-  }
-  else if (strcmp(settings.fan, "QUIET") == 0)
-  {
-    controlPage.replace("_FAN_Q_", "selected");
-  }
-  else if (strcmp(settings.fan, "1") == 0)
-  {
-    controlPage.replace("_FAN_1_", "selected");
-  }
-  else if (strcmp(settings.fan, "2") == 0)
-  {
-    controlPage.replace("_FAN_2_", "selected");
-  }
-  else if (strcmp(settings.fan, "3") == 0)
-  {
-    controlPage.replace("_FAN_3_", "selected");
-  }
-  else if (strcmp(settings.fan, "4") == 0)
-  {
-    controlPage.replace("_FAN_4_", "selected");
-  }
-  else if (strcmp(settings.fan, "5") == 0)
-  {
-    controlPage.replace("_FAN_5_", "selected");
-  }
-
-  controlPage.replace("_VANE_V_", settings.verticalVane);
-  if (strcmp(settings.verticalVane, "HOLD") == 0)
-  {
-    controlPage.replace("_VANE_H_", "selected");
-  }
-  else if (strcmp(settings.verticalVane, "SWING") == 0)
-  {
-    controlPage.replace("_VANE_S_", "selected");
-  }
-
-  controlPage.replace("_WIDEVANE_V_", settings.horizontalVane);
-  if (strcmp(settings.horizontalVane, "HOLD") == 0)
-  {
-    controlPage.replace("_WVANE_H_", "selected");
-  }
-  else if (strcmp(settings.horizontalVane, "SWING") == 0)
-  {
-    controlPage.replace("_WVANE_S_", "selected");
-  }
+  HtmlWriter out = beginHTMLResponse();
+  renderControlPage(out);
+  endHTMLResponse(out);
+}
 
-  controlPage.replace("_TEMP_", String(convertCelsiusToLocalUnit(ac.getTemperature(), useFahrenheit)));
+void renderControlPage(HtmlWriter &response)
+{
+  renderWrappedPage(response, html_page_control_template, controlPageResolver());
+}
 
-  // We need to send the page content in chunks to overcome
-  // a limitation on the maximum size we can send at one
-  // time (approx 6k).
-  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
-  server.send(200, "text/html", headerContent);
-  server.sendContent(controlPage);
-  server.sendContent(footerContent);
-  // Signal the end of the content
-  server.sendContent("");
+static const char *requestedOr(const char *requested, const char *current)
+{
+  return requested[0] ? requested : current;
+}
 
-  // free(&settings);
-  // delay(100);
+// Values are read once here, the returned resolver is then called for each placeholder.
+std::function<void(uint8_t field, HtmlWriter &out)> controlPageResolver()
+{
+  ControllerCommand requested = change_states();
+  ControllerSnapshot snapshot = controllerSnapshot.read();
+  float roomTemperature = convertCelsiusToLocalUnit(snapshot.status.roomTemperature, useFahrenheit);
+  float temperature = convertCelsiusToLocalUnit(snapshot.settings.temperature, useFahrenheit);
+
+  return [=](uint8_t field, HtmlWriter &out)
+  {
+    // Show what was just posted, the snapshot catches up once the controller task has applied it
+    HVACSettings settings = snapshot.settings;
+    settings.power = requestedOr(requested.power, settings.power);
+    settings.mode = requestedOr(requested.mode, settings.mode);
+    settings.fan = requestedOr(requested.fan, settings.fan);
+    settings.verticalVane = requestedOr(requested.vane, settings.verticalVane);
+    settings.horizontalVane = requestedOr(requested.wideVane, settings.horizontalVane);
+
+    switch (field)
+    {
+    case HF_ROOMTEMP: out.print(roomTemperature); break;
+    case HF_TEMP: out.print(temperature); break;
+    case HF_TEMP_SCALE: out.print(useFahrenheit ? "F" : "C"); break;
+    case HF_HEAT_MODE_SUPPORT: out.print((int)supportHeatMode); break;
+    case HF_X50_PROTOCOL: out.print((int)(snapshot.protocol == PROTOCOL_X50)); break;
+    case HF_MIN_TEMP: out.print(convertCelsiusToLocalUnit(min_temp, useFahrenheit)); break;
+    case HF_MAX_TEMP: out.print(convertCelsiusToLocalUnit(max_temp, useFahrenheit)); break;
+    case HF_TEMP_STEP: out.print(temp_step); break;
+    case HF_POWER_ON: selectedIf(out, strcmp(settings.power, "ON") == 0); break;
+    case HF_POWER_OFF: selectedIf(out, strcmp(settings.power, "OFF") == 0); break;
+    case HF_MODE_H: selectedIf(out, strcmp(settings.mode, "HEAT") == 0); break;
+    case HF_MODE_D: selectedIf(out, strcmp(settings.mode, "DRY") == 0); break;
+    case HF_MODE_C: selectedIf(out, strcmp(settings.mode, "COOL") == 0); break;
+    case HF_MODE_F: selectedIf(out, strcmp(settings.mode, "FAN") == 0); break;
+    case HF_MODE_A: selectedIf(out, strcmp(settings.mode, "AUTO") == 0); break;
+    case HF_FAN_A: selectedIf(out, strcmp(settings.fan, "AUTO") == 0); break;
+    case HF_FAN_Q: selectedIf(out, strcmp(settings.fan, "QUIET") == 0); break;
+    case HF_FAN_1: selectedIf(out, strcmp(settings.fan, "1") == 0); break;
+    case HF_FAN_2: selectedIf(out, strcmp(settings.fan, "2") == 0); break;
+    case HF_FAN_3: selectedIf(out, strcmp(settings.fan, "3") == 0); break;
+    case HF_FAN_4: selectedIf(out, strcmp(settings.fan, "4") == 0); break;
+    case HF_FAN_5: selectedIf(out, strcmp(settings.fan, "5") == 0); break;
+    case HF_VANE_H: selectedIf(out, strcmp(settings.verticalVane, "HOLD") == 0); break;
+    case HF_VANE_S: selectedIf(out, strcmp(settings.verticalVane, "SWING") == 0); break;
+    case HF_WVANE_H: selectedIf(out, strcmp(settings.horizontalVane, "HOLD") == 0); break;
+    case HF_WVANE_S: selectedIf(out, strcmp(settings.horizontalVane, "SWING") == 0); break;
+    default: commonPageField(field, out); break;
+    }
+  };
 }
 
 // login page, also called for logout
@@ -1274,28 +1623,31 @@ void handleLogin()
   bool loginSuccess = false;
   String msg;
   String loginPage = FPSTR(html_page_login);
-  loginPage.replace("_TXT_LOGIN_TITLE_", FPSTR(txt_login_title));
-  loginPage.replace("_TXT_LOGIN_PASSWORD_", FPSTR(txt_login_password));
-  loginPage.replace("_TXT_LOGIN_", FPSTR(txt_login));
+  loginPage.replace("_TXT_LOGIN_TITLE_", language.text(TXT_LOGIN_TITLE));
+  loginPage.replace("_TXT_LOGIN_PASSWORD_", language.text(TXT_LOGIN_PASSWORD));
+  loginPage.replace("_TXT_LOGIN_", language.text(TXT_LOGIN));
 
   if (server.hasArg("USERNAME") || server.hasArg("PASSWORD") || server.hasArg("LOGOUT"))
   {
     if (server.hasArg("LOGOUT"))
     {
       // logout
+      sessions.revoke(server.header("Cookie").c_str());
       server.sendHeader("Cache-Control", "no-cache");
-      server.sendHeader("Set-Cookie", "M2MSESSIONID=0");
+      server.sendHeader("Set-Cookie", SESSION_COOKIE_NAME "=; Path=/; Max-Age=0");
       loginSuccess = false;
     }
     if (server.hasArg("USERNAME") && server.hasArg("PASSWORD"))
     {
       if (server.arg("USERNAME") == "admin" && server.arg("PASSWORD") == login_password)
       {
+        char cookie[96];
+        sessions.create(cookie, sizeof(cookie));
         server.sendHeader("Cache-Control", "no-cache");
-        server.sendHeader("Set-Cookie", "M2MSESSIONID=1");
+        server.sendHeader("Set-Cookie", cookie);
         loginSuccess = true;
         msg = F("<span style='color:#47c266;font-weight:bold;'>");
-        msg += FPSTR(txt_login_sucess);
+        msg += language.text(TXT_LOGIN_SUCESS);
         msg += F("<span>");
         loginPage += F("<script>");
         loginPage += F("setTimeout(function () {");
@@ -1307,7 +1659,7 @@ void handleLogin()
       else
       {
         msg = F("<span style='color:#d43535;font-weight:bold;'>");
-        msg += FPSTR(txt_login_fail);
+        msg += language.text(TXT_LOGIN_FAIL);
         msg += F("</span>");
         // Log in Failed;
       }
@@ -1319,15 +1671,7 @@ void handleLogin()
     {
       server.sendHeader("Location", "/");
       server.sendHeader("Cache-Control", "no-cache");
-      // use javascript in the case browser disable redirect
-      String redirectPage = F("<html lang=\"en\" class=\"\"><head><meta charset='utf-8'>");
-      redirectPage += F("<script>");
-      redirectPage += F("setTimeout(function () {");
-      redirectPage += F("window.location.href= '/';");
-      redirectPage += F("}, 1000);");
-      redirectPage += F("</script>");
-      redirectPage += F("</body></html>");
-      server.send(302, F("text/html"), redirectPage);
+      server.send_P(302, "text/html", redirect_to_root_page);
       return;
     }
   }
@@ -1343,11 +1687,12 @@ void handleUpgrade()
 
   uploaderror = 0;
   String upgradePage = FPSTR(html_page_upgrade);
-  upgradePage.replace("_TXT_B_UPGRADE_", FPSTR(txt_upgrade));
-  upgradePage.replace("_TXT_BACK_", FPSTR(txt_back));
-  upgradePage.replace("_TXT_UPGRADE_TITLE_", FPSTR(txt_upgrade_title));
-  upgradePage.replace("_TXT_UPGRADE_INFO_", FPSTR(txt_upgrade_info));
-  upgradePage.replace("_TXT_UPGRADE_START_", FPSTR(txt_upgrade_start));
+  upgradePage.replace("_TXT_B_UPGRADE_", language.text(TXT_UPGRADE));
+  upgradePage.replace("_TXT_BACK_", language.text(TXT_BACK));
+  upgradePage.replace("_TXT_UPGRADE_TITLE_", language.text(TXT_UPGRADE_TITLE));
+  upgradePage.replace("_TXT_UPGRADE_INFO_", language.text(TXT_UPGRADE_INFO));
+  upgradePage.replace("_TXT_UPGRADE_START_", language.text(TXT_UPGRADE_START));
+  upgradePage.replace("_TXT_UPGRADE_SHA256_", language.text(TXT_UPGRADE_SHA256));
 
   sendWrappedHTML(upgradePage);
 }
@@ -1363,56 +1708,69 @@ void handleUploadDone()
     content += F("<span style='color:#d43535'>failed</span></b><br/><br/>");
     if (uploaderror == 1)
     {
-      content += FPSTR(txt_upload_nofile);
+      content += language.text(TXT_UPLOAD_NOFILE);
     }
     else if (uploaderror == 2)
     {
-      content += FPSTR(txt_upload_filetoolarge);
+      content += language.text(TXT_UPLOAD_FILETOOLARGE);
     }
     else if (uploaderror == 3)
     {
-      content += FPSTR(txt_upload_fileheader);
+      content += language.text(TXT_UPLOAD_FILEHEADER);
     }
     else if (uploaderror == 4)
     {
-      content += FPSTR(txt_upload_flashsize);
+      content += language.text(TXT_UPLOAD_FLASHSIZE);
     }
     else if (uploaderror == 5)
     {
-      content += FPSTR(txt_upload_buffer);
+      content += language.text(TXT_UPLOAD_BUFFER);
     }
     else if (uploaderror == 6)
     {
-      content += FPSTR(txt_upload_failed);
+      content += language.text(TXT_UPLOAD_FAILED);
     }
     else if (uploaderror == 7)
     {
-      content += FPSTR(txt_upload_aborted);
+      content += language.text(TXT_UPLOAD_ABORTED);
+    }
+    else if (uploaderror == 8)
+    {
+      content += language.text(TXT_UPLOAD_SHA256_MISMATCH);
+      content += F("<br/>");
+      content += otaWriter.sha256();
     }
     else
     {
-      content += FPSTR(txt_upload_error);
+      content += language.text(TXT_UPLOAD_ERROR);
       content += String(uploaderror);
     }
     if (Update.hasError())
     {
-      content += FPSTR(txt_upload_code);
+      content += language.text(TXT_UPLOAD_CODE);
       content += String(Update.getError());
     }
   }
   else
   {
     content += F("<span style='color:#47c266; font-weight: bold;'>");
-    content += FPSTR(txt_upload_sucess);
+    content += language.text(TXT_UPLOAD_SUCESS);
     content += F("</span><br/><br/>");
-    content += FPSTR(txt_upload_refresh);
+    const OtaStats &stats = otaWriter.stats();
+    content += F("SHA-256 ");
+    content += otaWriter.sha256();
+    content += F("<br/>");
+    content += String(stats.bytes / 1024) + F(" KB, ") + String(stats.elapsedUs / 1000) + F(" ms, ");
+    content += String(stats.elapsedUs ? (uint32_t)((uint64_t)stats.bytes * 1000 / stats.elapsedUs) : 0) + F(" KB/s");
+    content += F("<br/><br/>");
+    content += language.text(TXT_UPLOAD_REFRESH);
     content += F("<span id='count'>10s</span>...");
     content += FPSTR(count_down_script);
     restartflag = true;
   }
   content += F("</div><br/>");
   uploadDonePage.replace("_UPLOAD_MSG_", content);
-  uploadDonePage.replace("_TXT_BACK_", FPSTR(txt_back));
+  uploadDonePage.replace("_TXT_BACK_", language.text(TXT_BACK));
   sendWrappedHTML(uploadDonePage);
   if (restartflag)
   {
@@ -1437,7 +1795,7 @@ void handleUploadLoop()
 
   if (uploaderror)
   {
-    Update.end();
+    otaWriter.abort();
     return;
   }
   HTTPUpload &upload = server.upload();
@@ -1449,16 +1807,10 @@ void handleUploadLoop()
       uploaderror = 1;
       return;
     }
-    // save cpu by disconnect/stop retry mqtt server
-    if (mqtt_client.state() == MQTT_CONNECTED)
-    {
-      mqtt_client.disconnect();
-      lastMqttRetry = millis();
-    }
-
+    // MQTT and the unit keep running, flashing happens on the OTA writer task
     // Serial.printl(log);
     uint32_t maxSketchSpace = (ESP.getFreeSketchSpace() - 0x1000) & 0xFFFFF000;
-    if (!Update.begin(maxSketchSpace))
+    if (!otaWriter.begin(maxSketchSpace))
     { // start with max available size
       // Log.ln(TAG, "Upload: Error, not enough storage");
       uploaderror = 2;
@@ -1498,7 +1850,7 @@ void handleUploadLoop()
       }
     }
     // Log.ln(TAG, "Update Write");
-    if (!uploaderror && (Update.write(upload.buf, upload.currentSize) != upload.currentSize))
+    if (!uploaderror && !otaWriter.write(upload.buf, upload.currentSize))
     {
       // Update.printError(Serial);
       uploaderror = 5;
@@ -1508,14 +1860,11 @@ void handleUploadLoop()
   else if (!uploaderror && (upload.status == UPLOAD_FILE_END))
   {
     // Log.ln(TAG, "Update END");
-    if (Update.end(true))
-    { // true to set the size to the current progress
-      // Serial.printl(log)
-    }
-    else
+    // Optional digest, passed in the query string (/upload?sha256=...) as form fields are not parsed yet
+    if (!otaWriter.end(server.arg("sha256").c_str()))
     {
       // Update.printError(Serial);
-      uploaderror = 6;
+      uploaderror = otaWriter.shaMismatch() ? 8 : 6;
       return;
     }
   }
@@ -1523,7 +1872,7 @@ void handleUploadLoop()
   {
     // Log.ln(TAG, "Upload: Upload: Update was aborted");
     uploaderror = 7;
-    Update.end();
+    otaWriter.abort();
   }
 
   esp_task_wdt_reset();
@@ -1536,8 +1885,8 @@ void handleLogging()
     return;
 
   String othersPage = FPSTR(html_page_logging);
-  othersPage.replace("_TXT_LOGGING_TITLE_", FPSTR(txt_logging_title));
-  othersPage.replace("_TXT_BACK_", FPSTR(txt_back));
+  othersPage.replace("_TXT_LOGGING_TITLE_", language.text(TXT_LOGGING_TITLE));
+  othersPage.replace("_TXT_BACK_", language.text(TXT_BACK));
 
   sendWrappedHTML(othersPage);
 }
@@ -1549,8 +1898,95 @@ void handleAPILogs()
 
   if (server.method() == HTTP_GET)
   {
-    server.send(200, F("text/html"), Log.getLogs());
+    // ?since=<position> returns only what was logged after that position, the page passes back X-Log-Next.
+    uint32_t end = Log.end();
+    uint32_t from = server.hasArg("since") ? strtoul(server.arg("since").c_str(), NULL, 10) : 0;
+    if (from > end)
+    {
+      // Position from before a reboot, start over
+      server.sendHeader("X-Log-Reset", "1");
+      from = 0;
+    }
+    char chunk[LOG_CHUNK_SIZE];
+    size_t len = Log.read(from, end, chunk, sizeof(chunk));
+    server.sendHeader("X-Log-Next", String(end));
+    server.sendHeader("Cache-Control", "no-cache");
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(200, "text/plain", "");
+    // Lines rotated out while a slow client is reading are skipped, never sent twice.
+    // What rotates out is only known while streaming, so the total is counted here and logged afterwards.
+    uint32_t sent = 0;
+    while (len > 0 && server.client().connected())
+    {
+      server.sendContent(chunk, len);
+      sent += len;
+      len = Log.read(from, end, chunk, sizeof(chunk));
+    }
+    server.sendContent("");
+    metrics.logServed(sent);
+    LOGD(TAG, "Served %u log bytes up to %u", (unsigned)sent, (unsigned)end);
+  }
+}
+
+// Server-Sent Events: state changes, and with ?log=<position> log text from that position on.
+void handleEvents()
+{
+  if (!checkLogin())
+    return;
+
+  bool wantsLog = server.hasArg("log");
+  uint32_t logFrom = wantsLog ? strtoul(server.arg("log").c_str(), NULL, 10) : 0;
+  // Automatic reconnect by the browser, continue after the last log event it got
+  if (wantsLog && server.hasHeader("Last-Event-ID"))
+    logFrom = strtoul(server.header("Last-Event-ID").c_str(), NULL, 10);
+  // Position from before a reboot, start at the current end like a fresh subscriber
+  if (logFrom > Log.end())
+    logFrom = Log.end();
+  bool wantsState = !wantsLog || server.hasArg("state");
+  if (!events.add(server.client(), wantsState, wantsLog, logFrom))
+  {
+    server.send(503, "text/plain", "Too many subscribers");
+    return;
   }
+  // The subscriber keeps its own reference to the socket, WebServer forgets it and moves on to the next request
+  server.release();
+}
+
+// Prometheus text exposition, the counters from metrics.h plus gauges read here.
+void handleMetrics()
+{
+  if (!checkLogin())
+    return;
+
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "text/plain; version=0.0.4", "");
+  HtmlWriter out([](const char *data, size_t len)
+                 { server.sendContent(data, len); });
+  metrics.write(out);
+
+  ControllerSnapshot snapshot = controllerSnapshot.read();
+  Metrics::writeGauge(out, "dk2mqtt_heap_free_bytes", "Free internal heap", heap_caps_get_free_size(MALLOC_CAP_INTERNAL));
+  Metrics::writeGauge(out, "dk2mqtt_heap_min_free_bytes", "Lowest free heap since boot", esp_get_minimum_free_heap_size());
+  Metrics::writeGauge(out, "dk2mqtt_heap_largest_free_block_bytes", "Largest allocatable internal block", heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+  Metrics::writeGauge(out, "dk2mqtt_psram_free_bytes", "Free PSRAM, 0 without PSRAM", ESP.getFreePsram());
+  Metrics::writeGauge(out, "dk2mqtt_psram_largest_free_block_bytes", "Largest allocatable PSRAM block", heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM));
+  Metrics::writeGauge(out, "dk2mqtt_wifi_rssi_dbm", "Signal strength of the connected access point", WiFi.RSSI());
+  Metrics::writeGauge(out, "dk2mqtt_uptime_seconds", "Time since boot", millis() / 1000.0);
+  Metrics::writeGauge(out, "dk2mqtt_hvac_connected", "1 while the unit answers", snapshot.connected ? 1 : 0);
+  Metrics::writeGauge(out, "dk2mqtt_mqtt_connected", "1 while connected to the broker", mqttState == MQTT_CONNECTED ? 1 : 0);
+  Metrics::writeCounter(out, "dk2mqtt_wifi_reconnects_total", "Times the station rejoined the access point after losing it", wifiReconnects);
+  Metrics::writeCounter(out, "dk2mqtt_hvac_reconnects_total", "Attempts to reconnect to the unit", snapshot.hpConnectionTotalRetries);
+  if (syslogSink.enabled())
+  {
+    Metrics::writeCounter(out, "dk2mqtt_syslog_sent_total", "Log records sent to the syslog server", syslogSink.sent());
+    Metrics::writeCounter(out, "dk2mqtt_syslog_dropped_total", "Log records never sent to the syslog server", syslogSink.dropped());
+    Metrics::writeCounter(out, "dk2mqtt_syslog_failed_total", "Syslog datagrams the network stack refused", syslogSink.failed());
+  }
+  Metrics::writeCounter(out, "dk2mqtt_controller_results_dropped_total", "Controller answers lost to a full result queue", controllerResultsDropped);
+  Scheduler::writeAll(out);
+  profiler.write(out);
+  powerSave.write(out);
+  endHTMLResponse(out);
 }
 
 void handleAPIACStatus()
@@ -1560,10 +1996,29 @@ void handleAPIACStatus()
 
   if (server.method() == HTTP_GET)
   {
-    hpStatusChanged(ac.getStatus());
-    String jsonOutput;
-    serializeJson(rootInfo, jsonOutput);
-    server.send(200, F("application/json"), jsonOutput);
+    if (statusCache.len == 0 || statusCache.version != controllerSnapshot.version())
+    {
+      ControllerSnapshot snapshot = controllerSnapshot.read();
+      HVACState state;
+      readHeatPumpStatus(state, snapshot.status, snapshot.settings, snapshot.protocol);
+      statusCache.len = StateEncoder::encodeState(state, statusCache.json, sizeof(statusCache.json));
+      statusCache.version = snapshot.version;
+      // Tag the content rather than the version: MQTT state changes move the version without
+      // touching this document, and the version starts over after a reboot.
+      uint32_t hash = 2166136261u;
+      for (size_t i = 0; i < statusCache.len; i++)
+        hash = (hash ^ (uint8_t)statusCache.json[i]) * 16777619u;
+      snprintf(statusCache.etag, sizeof(statusCache.etag), "\"%08x\"", hash);
+    }
+
+    server.sendHeader("ETag", statusCache.etag);
+    server.sendHeader("Cache-Control", "no-cache");
+    if (server.header("If-None-Match") == statusCache.etag)
+    {
+      server.send(304);
+      return;
+    }
+    server.send_P(200, "application/json", statusCache.json, statusCache.len);
   }
 }
 
@@ -1574,183 +2029,172 @@ void write_log(String log)
   logFile.close();
 }
 
-HVACSettings change_states(HVACSettings settings)
+// Control page form fields, posted to the controller task. Returns what was requested so the page can show it.
+ControllerCommand change_states()
 {
+  ControllerCommand command = controllerCommand(CMD_SETTINGS);
 
   if (server.hasArg("CONNECT"))
   {
-    ac.connect(acSerial);
+    command.type = CMD_CONNECT;
+    controllerCommandPost(command);
+    return command;
   }
-  else
-  {
 
-    bool update = false;
-    if (server.hasArg("POWER"))
-    {
-      // String arg = server.arg("POWER");
-      // const char* argC = arg.c_str();
-      // Serial.printf("Arg = %s\n", argC);
-      settings.power = strdup(server.arg("POWER").c_str());
-      update = true;
-    }
-    if (server.hasArg("MODE"))
-    {
-      // settings.mode = server.arg("MODE").c_str();
-      settings.mode = strdup(server.arg("MODE").c_str());
-      update = true;
-    }
-    if (server.hasArg("TEMP"))
-    {
-      settings.temperature = convertLocalUnitToCelsius(server.arg("TEMP").toFloat(), useFahrenheit);
-      update = true;
-    }
-    if (server.hasArg("FAN"))
-    {
-      settings.fan = strdup(server.arg("FAN").c_str());
-      update = true;
-    }
-    if (server.hasArg("VANE"))
-    {
-      settings.verticalVane = strdup(server.arg("VANE").c_str());
-      update = true;
-    }
-    if (server.hasArg("WIDEVANE"))
-    {
-      settings.horizontalVane = strdup(server.arg("WIDEVANE").c_str());
-      update = true;
-    }
-    if (update)
-    {
-      // Serial.printf("Set new basic %s %s %.2f %s %s %s \n", settings.power, settings.mode, settings.temperature, settings.fan, settings.verticalVane, settings.horizontalVane);
-      digitalWrite(LED_ACT, HIGH);
-      playBeep(SET);
-      ac.setBasic(&settings);
-      ac.update(true);
-      lastCommandSend = millis();
-      digitalWrite(LED_ACT, LOW);
-    }
+  bool update = false;
+  if (server.hasArg("POWER"))
+  {
+    strlcpy(command.power, server.arg("POWER").c_str(), sizeof(command.power));
+    update = true;
+  }
+  if (server.hasArg("MODE"))
+  {
+    strlcpy(command.mode, server.arg("MODE").c_str(), sizeof(command.mode));
+    update = true;
+  }
+  if (server.hasArg("TEMP"))
+  {
+    command.temperature = convertLocalUnitToCelsius(server.arg("TEMP").toFloat(), useFahrenheit);
+    update = true;
+  }
+  if (server.hasArg("FAN"))
+  {
+    strlcpy(command.fan, server.arg("FAN").c_str(), sizeof(command.fan));
+    update = true;
+  }
+  if (server.hasArg("VANE"))
+  {
+    strlcpy(command.vane, server.arg("VANE").c_str(), sizeof(command.vane));
+    update = true;
+  }
+  if (server.hasArg("WIDEVANE"))
+  {
+    strlcpy(command.wideVane, server.arg("WIDEVANE").c_str(), sizeof(command.wideVane));
+    update = true;
+  }
+  if (update)
+  {
+    command.fromUnit = true;
+    command.beep = SET;
+    controllerCommandPost(command);
   }
-  return settings;
+  return command;
 }
 
-void readHeatPumpSettings()
+void readHeatPumpSettings(HVACState &state, HVACSettings currentSettings)
 {
-  HVACSettings currentSettings = ac.getSettings();
+  state.temperature = convertCelsiusToLocalUnit(currentSettings.temperature, useFahrenheit);
+  strlcpy(state.fan, currentSettings.fan, sizeof(state.fan));
+  strlcpy(state.vane, currentSettings.verticalVane, sizeof(state.vane));
+  strlcpy(state.wideVane, currentSettings.horizontalVane, sizeof(state.wideVane));
+  state.mode = hpGetMode(currentSettings);
+}
 
-  rootInfo.clear();
-  rootInfo["temperature"] = convertCelsiusToLocalUnit(currentSettings.temperature, useFahrenheit);
-  rootInfo["fan"] = currentSettings.fan;
-  rootInfo["vane"] = currentSettings.verticalVane;
-  rootInfo["wideVane"] = currentSettings.horizontalVane;
-  rootInfo["mode"] = hpGetMode(currentSettings);
+// Also used by the web task on a snapshot, so it must not touch the controller itself.
+void readHeatPumpStatus(HVACState &state, HVACStatus currentStatus, HVACSettings currentSettings, uint8_t protocol)
+{
+  readHeatPumpSettings(state, currentSettings);
+  state.outsideTemperature = convertCelsiusToLocalUnit(currentStatus.outsideTemperature, useFahrenheit);
+  state.coilTemperature = convertCelsiusToLocalUnit(currentStatus.coilTemperature, useFahrenheit);
+  state.roomTemperature = convertCelsiusToLocalUnit(currentStatus.roomTemperature, useFahrenheit);
+  state.fanRPM = currentStatus.fanRPM;
+  state.action = hpGetAction(currentStatus, currentSettings);
+  state.compressorFrequency = currentStatus.compressorFrequency;
+  strlcpy(state.errorCode, currentStatus.errorCode, sizeof(state.errorCode));
+  state.hasEnergyMeter = protocol == PROTOCOL_S21 && currentStatus.energyMeter != 0.0;
+  state.energyMeter = (int)(currentStatus.energyMeter * 100 + 0.5) / 100.0;
 }
 
 void hpSettingsChanged()
 {
   // send room temp, operating info and all information
-  readHeatPumpSettings();
+  ControllerSnapshot snapshot = controllerSnapshot.read();
+  readHeatPumpSettings(localState, snapshot.settings);
 
-  String mqttOutput;
-  serializeJson(rootInfo, mqttOutput);
+  StateEncoder::encodeSettings(localState, stateJson, sizeof(stateJson));
 
-  if (!mqtt_client.publish(ha_settings_topic.c_str(), mqttOutput.c_str(), true))
+  if (!mqtt_client.publish(ha_settings_topic.c_str(), stateJson, true))
   {
     if (_debugMode)
-      mqtt_client.publish(ha_debug_topic.c_str(), (char *)("Failed to publish hp settings"));
+      mqtt_client.publishUncounted(ha_debug_topic.c_str(), (char *)("Failed to publish hp settings"));
   }
 
-  hpStatusChanged(ac.getStatus());
+  hpStatusChanged(snapshot);
 }
 
-String hpGetMode(HVACSettings hvacSettings)
+const char *hpGetMode(HVACSettings hvacSettings)
 {
   // Map the heat pump state to one of HA's HVAC_MODE_* values.
   // https://github.com/home-assistant/core/blob/master/homeassistant/components/climate/const.py#L3-L23
 
-  String hppower = String(hvacSettings.power);
-  if (hppower.equalsIgnoreCase("off"))
+  if (strcasecmp(hvacSettings.power, "off") == 0)
   {
     return "off";
   }
 
-  String hpmode = String(hvacSettings.mode);
-  hpmode.toLowerCase();
-
-  if (hpmode == "fan")
+  if (strcasecmp(hvacSettings.mode, "fan") == 0)
     return "fan_only";
-  else if (hpmode == "auto")
+  else if (strcasecmp(hvacSettings.mode, "auto") == 0)
     return "heat_cool";
+  else if (strcasecmp(hvacSettings.mode, "cool") == 0)
+    return "cool";
+  else if (strcasecmp(hvacSettings.mode, "heat") == 0)
+    return "heat";
+  else if (strcasecmp(hvacSettings.mode, "dry") == 0)
+    return "dry";
   else
-    return hpmode; // cool, heat, dry
+    return "off"; // disabled or unknown mode, HA has no matching value
 }
 
-String hpGetAction(HVACStatus hpStatus, HVACSettings hpSettings)
+const char *hpGetAction(HVACStatus hpStatus, HVACSettings hpSettings)
 {
   // Map heat pump state to one of HA's CURRENT_HVAC_* values.
   // https://github.com/home-assistant/core/blob/master/homeassistant/components/climate/const.py#L80-L86
 
-  String hppower = String(hpSettings.power);
-  if (hppower.equalsIgnoreCase("off"))
+  if (strcasecmp(hpSettings.power, "off") == 0)
   {
     return "off";
   }
 
-  String hpmode = String(hpSettings.mode);
-  hpmode.toLowerCase();
-
-  if (hpmode == "fan")
+  if (strcasecmp(hpSettings.mode, "fan") == 0)
     return "fan";
   else if (!hpStatus.operating)
     return "idle";
-  else if (hpmode == "auto")
-    return "idle";
-  else if (hpmode == "cool")
+  else if (strcasecmp(hpSettings.mode, "cool") == 0)
     return "cooling";
-  else if (hpmode == "heat")
+  else if (strcasecmp(hpSettings.mode, "heat") == 0)
     return "heating";
-  else if (hpmode == "dry")
+  else if (strcasecmp(hpSettings.mode, "dry") == 0)
     return "drying";
   else
-    return hpmode; // unknown
+    return "idle"; // auto or unknown
 }
 
-void hpStatusChanged(HVACStatus currentStatus)
+void hpStatusChanged(const ControllerSnapshot &snapshot)
 {
   if ((millis() > (lastTempSend + update_int)) && (millis() > (lastCommandSend + POLL_DELAY_AFTER_SET_MS)))
   { // only send the temperature every update_int interval and not just sent command to A/C.
 
     // send room temp, operating info and all information
-    HVACSettings currentSettings = ac.getSettings();
-
-    if (currentStatus.roomTemperature == 0)
+    if (snapshot.status.roomTemperature == 0)
       return;
 
-    rootInfo.clear();
-
-    rootInfo["outsideTemperature"] = convertCelsiusToLocalUnit(currentStatus.outsideTemperature, useFahrenheit);
-    rootInfo["internalCoilTemperature"] = convertCelsiusToLocalUnit(currentStatus.coilTemperature, useFahrenheit);
-    rootInfo["temperature"] = convertCelsiusToLocalUnit(currentSettings.temperature, useFahrenheit);
-    rootInfo["fan"] = currentSettings.fan;
-    rootInfo["fanRPM"] = currentStatus.fanRPM;
-    rootInfo["roomTemperature"] = convertCelsiusToLocalUnit(currentStatus.roomTemperature, useFahrenheit);
-    rootInfo["vane"] = currentSettings.verticalVane;
-    rootInfo["wideVane"] = currentSettings.horizontalVane;
-    rootInfo["mode"] = hpGetMode(currentSettings);
-    rootInfo["action"] = hpGetAction(currentStatus, currentSettings);
-    rootInfo["compressorFrequency"] = currentStatus.compressorFrequency;
-    rootInfo["errorCode"] = currentStatus.errorCode;
-
-    if (ac.daikinUART->currentProtocol() == PROTOCOL_S21 && currentStatus.energyMeter != 0.0){
-      // rootInfo["energyMeter"] = currentStatus.energyMeter;
-      rootInfo["energyMeter"] = (int)(currentStatus.energyMeter * 100 + 0.5) / 100.0;
+    readHeatPumpStatus(localState, snapshot.status, snapshot.settings, snapshot.protocol);
+
+    // Broker down, or older samples still queued for the state topic: buffer it so HA gets them in order.
+    if (!mqtt_client.connected() || (!others_state_history && !stateHistory.empty()))
+    {
+      stateHistory.push(localState, millis());
+      lastTempSend = millis();
+      return;
     }
-    String mqttOutput;
-    serializeJson(rootInfo, mqttOutput);
 
-    if (!mqtt_client.publish_P(ha_state_topic.c_str(), mqttOutput.c_str(), false))
+    StateEncoder::encodeState(localState, stateJson, sizeof(stateJson));
+
+    if (!mqtt_client.publish_P(ha_state_topic.c_str(), stateJson, false))
     {
       if (_debugMode)
-        mqtt_client.publish(ha_debug_topic.c_str(), (char *)("Failed to publish hp status change"));
+        mqtt_client.publishUncounted(ha_debug_topic.c_str(), (char *)("Failed to publish hp status change"));
     }
 
     //Update unit setting (Beep & LED to MQTT as well)
@@ -1782,7 +2226,7 @@ void hpPacketDebug(byte *packet, unsigned int length, const char *packetDirectio
     serializeJson(root, mqttOutput);
     if (!mqtt_client.publish(ha_debug_topic.c_str(), mqttOutput.c_str()))
     {
-      mqtt_client.publish(ha_debug_topic.c_str(), (char *)("Failed to publish to heatpump/debug topic"));
+      mqtt_client.publishUncounted(ha_debug_topic.c_str(), (char *)("Failed to publish to heatpump/debug topic"));
     }
   }
 }
@@ -1797,28 +2241,701 @@ void updateUnitSettings(){
     if (!mqtt_client.publish_P(ha_unit_settings_topic.c_str(), mqttOutput.c_str(), false))
     {
       if (_debugMode)
-        mqtt_client.publish(ha_debug_topic.c_str(), (char *)("Failed to publish hp status change"));
+        mqtt_client.publishUncounted(ha_debug_topic.c_str(), (char *)("Failed to publish hp status change"));
     }
 }
 
+// Publish the samples buffered while offline, oldest first and one per STATE_HISTORY_REPLAY_INTERVAL_MS
+// so a long outage does not flood the broker (or trip the watchdog) right after reconnect.
+void replayStateHistory()
+{
+  const StateSample *sample = stateHistory.front();
+  if (sample == nullptr || millis() - lastHistoryReplay < STATE_HISTORY_REPLAY_INTERVAL_MS)
+    return;
+  lastHistoryReplay = millis();
+
+  char sampleJson[STATE_JSON_SIZE];
+  StateEncoder::encodeSample(sample->state, millis() - sample->takenAt, sampleJson, sizeof(sampleJson));
+  const String &topic = others_state_history ? ha_state_history_topic : ha_state_topic;
+  if (!mqtt_client.publish(topic.c_str(), sampleJson, false))
+    return; // keep the sample, retry on next pass
+
+  stateHistory.pop();
+  historyReplayed++;
+  if (stateHistory.empty())
+  {
+    uint32_t dropped = stateHistory.takeDropped();
+    Log.ln(TAG, "Replayed %u offline state samples, %u dropped (buffer full)", historyReplayed, (unsigned)dropped);
+    if (dropped > 0 && _debugMode)
+    {
+      char message[64];
+      snprintf(message, sizeof(message), "Offline state buffer full, %u samples dropped", (unsigned)dropped);
+      mqtt_client.publish(ha_debug_topic.c_str(), message);
+    }
+    historyReplayed = 0;
+  }
+}
+
 // Used to send a dummy packet in state topic to validate action in HA interface
 void hpSendLocalState()
 {
 
   // Send dummy MQTT state packet before unit update
-  String mqttOutput;
-  serializeJson(rootInfo, mqttOutput);
-  Log.ln(TAG, "Update State: %s\n", mqttOutput.c_str());
-  if (!mqtt_client.publish_P(ha_state_topic.c_str(), mqttOutput.c_str(), false))
+  StateEncoder::encodeState(localState, stateJson, sizeof(stateJson));
+  LOGD(TAG, "Update State: %s\n", stateJson);
+  if (!mqtt_client.publish_P(ha_state_topic.c_str(), stateJson, false))
   {
     if (_debugMode)
-      mqtt_client.publish(ha_debug_topic.c_str(), (char *)("Failed to publish dummy hp status change"));
+      mqtt_client.publishUncounted(ha_debug_topic.c_str(), (char *)("Failed to publish dummy hp status change"));
   }
 
   // Restart counter for waiting enought time for the unit to update before sending a state packet
   lastTempSend = millis();
 }
 
+// Queue a message for the loop task to publish (see controllerResultsStep). Never waits, a full
+// queue drops it and counts the loss, so the controller keeps its timing while the broker is slow.
+void controllerResultPost(ControllerResultTopic topic, const char *format, ...)
+{
+  ControllerResult result;
+  result.topic = topic;
+  va_list args;
+  va_start(args, format);
+  vsnprintf(result.payload, sizeof(result.payload), format, args);
+  va_end(args);
+  if (xQueueSend(controllerResults, &result, 0) != pdTRUE)
+    __atomic_fetch_add(&controllerResultsDropped, 1, __ATOMIC_RELAXED);
+}
+
+// Copy and tokenise a bulk query ("F1 F2,RH ...") in place, s21expStep() then runs it one command per job run.
+void s21expStart(const char *message, unsigned int length)
+{
+  if (__atomic_load_n(&s21exp.busy, __ATOMIC_ACQUIRE))
+  {
+    controllerResultPost(RESULT_S21EXP, "{\"error\":\"busy\",\"index\":%u,\"total\":%u}", s21exp.index, s21exp.total);
+    return;
+  }
+  if (length > S21EXP_MAX_LEN)
+  {
+    controllerResultPost(RESULT_S21EXP, "{\"error\":\"too long\",\"max\":%u}", S21EXP_MAX_LEN);
+    return;
+  }
+
+  memcpy(s21exp.buffer, message, length);
+  s21exp.buffer[length] = '\0';
+  s21exp.end = s21exp.buffer + length;
+  s21exp.index = 0;
+  s21exp.total = 0;
+  s21exp.failed = 0;
+
+  // Separators become terminators, so every command is a C string inside the buffer.
+  bool inToken = false;
+  for (char *c = s21exp.buffer; c < s21exp.end; c++)
+  {
+    if (*c == ' ' || *c == ',' || *c == '\n' || *c == '\r' || *c == '\t')
+    {
+      *c = '\0';
+      inToken = false;
+    }
+    else if (!inToken)
+    {
+      inToken = true;
+      s21exp.total++;
+    }
+  }
+
+  s21exp.next = s21exp.buffer;
+  while (s21exp.next < s21exp.end && *s21exp.next == '\0')
+    s21exp.next++;
+  if (s21exp.next >= s21exp.end)
+  {
+    s21exp.next = nullptr;
+    controllerResultPost(RESULT_S21EXP, "{\"done\":true,\"total\":0,\"failed\":0,\"ms\":0}");
+    return;
+  }
+  s21exp.tStart = millis();
+  // Hands the buffer over to the controller task until it clears busy
+  __atomic_store_n(&s21exp.busy, true, __ATOMIC_RELEASE);
+  if (!controllerCommandPost(controllerCommand(CMD_S21EXP)))
+  {
+    __atomic_store_n(&s21exp.busy, false, __ATOMIC_RELEASE);
+    controllerResultPost(RESULT_S21EXP, "{\"error\":\"queue full\"}");
+    return;
+  }
+  Log.ln(TAG, "S21exp: %u commands queued", s21exp.total);
+}
+
+// The (at most two) command bytes as the inside of a JSON string. They come straight from the MQTT
+// payload, so quotes, backslashes and control bytes are escaped.
+static void jsonCommandName(const char *command, char *out, size_t size)
+{
+  size_t len = 0;
+  out[0] = '\0';
+  for (int i = 0; i < 2 && command[i]; i++)
+  {
+    uint8_t c = command[i];
+    if (c < 0x20 || c >= 0x7f || c == '"' || c == '\\')
+      len += snprintf(out + len, size - len, "\\u%04x", c);
+    else
+      len += snprintf(out + len, size - len, "%c", c);
+  }
+}
+
+// Run the next queued s21exp command and publish its result. Controller task, re-arms itself until done.
+void s21expStep()
+{
+  if (!__atomic_load_n(&s21exp.busy, __ATOMIC_ACQUIRE))
+    return;
+  if (!ac.isConnected())
+  {
+    controllerScheduler.at(s21expJob, HP_RETRY_INTERVAL_MS);
+    return;
+  }
+
+  char *command = s21exp.next;
+  size_t commandLen = strlen(command);
+  s21exp.next += commandLen;
+  while (s21exp.next < s21exp.end && *s21exp.next == '\0')
+    s21exp.next++;
+  s21exp.index++;
+
+  char name[16]; // two \u00XX escapes
+  jsonCommandName(command, name, sizeof(name));
+  bool resOK = commandLen >= 2 && ac.daikinUART->sendCommandS21(command[0], command[1]);
+  if (resOK)
+  {
+    // Response is [STX, CMD1, CMD2, <DATA>, CRC, ETX], only publish the data.
+    const ACResponse &response = ac.daikinUART->getResponse();
+    size_t dataLen = response.dataSize >= 5 ? response.dataSize - 5 : 0;
+    char hex[S21EXP_RESPONSE_SIZE - 64];
+    formatHEX(response.data + 3, dataLen, hex, sizeof(hex));
+    controllerResultPost(RESULT_S21EXP, "{\"index\":%u,\"total\":%u,\"cmd\":\"%s\",\"res\":\"%s\"}", s21exp.index, s21exp.total, name, hex);
+  }
+  else
+  {
+    s21exp.failed++;
+    controllerResultPost(RESULT_S21EXP, "{\"index\":%u,\"total\":%u,\"cmd\":\"%s\",\"res\":null}", s21exp.index, s21exp.total, name);
+  }
+
+  if (s21exp.next < s21exp.end)
+  {
+    controllerScheduler.at(s21expJob, 0);
+    return;
+  }
+  s21exp.next = nullptr;
+  unsigned long elapsed = millis() - s21exp.tStart;
+  controllerResultPost(RESULT_S21EXP, "{\"done\":true,\"total\":%u,\"failed\":%u,\"ms\":%lu}", s21exp.total, s21exp.failed, elapsed);
+  Log.ln(TAG, "S21exp: %u commands done, %u failed in %lu ms", s21exp.total, s21exp.failed, elapsed);
+  __atomic_store_n(&s21exp.busy, false, __ATOMIC_RELEASE);
+}
+
+// Split a serial/send payload into protocol frames and queue them, all or nothing so a
+// multi frame request is never half sent.
+void passthroughEnqueue(const byte *payload, unsigned int length)
+{
+  ControllerSnapshot snapshot = controllerSnapshot.read();
+  if (!snapshot.connected)
+  {
+    controllerResultPost(RESULT_SERIAL_RECV, "{\"error\":\"not connected\"}");
+    return;
+  }
+
+  // The loop task is the only producer, the room found here is still there below
+  uint8_t spaces = uxQueueSpacesAvailable(passthroughFrames);
+  uint8_t lengths[PASSTHROUGH_QUEUE_SIZE];
+  uint8_t frames = 0;
+  unsigned int offset = 0;
+  while (offset < length)
+  {
+    uint8_t frameLen = DaikinUART::requestFrameLength(snapshot.protocol, payload + offset, min(length - offset, 255u));
+    if (frameLen == 0 || frameLen > PASSTHROUGH_FRAME_SIZE)
+    {
+      controllerResultPost(RESULT_SERIAL_RECV, "{\"error\":\"bad frame\",\"offset\":%u}", offset);
+      return;
+    }
+    if (frames >= spaces)
+    {
+      controllerResultPost(RESULT_SERIAL_RECV, "{\"error\":\"queue full\",\"queued\":%u}", PASSTHROUGH_QUEUE_SIZE - spaces);
+      return;
+    }
+    lengths[frames++] = frameLen;
+    offset += frameLen;
+  }
+
+  PassthroughFrame frame;
+  frame.queuedAt = micros();
+  offset = 0;
+  for (uint8_t i = 0; i < frames; i++)
+  {
+    memcpy(frame.data, payload + offset, lengths[i]);
+    frame.len = lengths[i];
+    offset += lengths[i];
+    xQueueSend(passthroughFrames, &frame, 0);
+  }
+  controllerCommandPost(controllerCommand(CMD_PASSTHROUGH));
+}
+
+// Send the next queued frame. Controller task, between polls so it never interleaves with a sync exchange.
+void passthroughStep()
+{
+  if (!ac.isConnected())
+  {
+    if (uxQueueMessagesWaiting(passthroughFrames) > 0)
+      controllerScheduler.at(passthroughJob, HP_RETRY_INTERVAL_MS);
+    return;
+  }
+  PassthroughFrame frame;
+  if (xQueueReceive(passthroughFrames, &frame, 0) != pdTRUE)
+    return;
+
+  static uint8_t response[PASSTHROUGH_RESPONSE_SIZE]; // controller task only, kept off its stack
+  bool truncated;
+  unsigned long tTx = micros();
+  uint8_t responseLen = ac.daikinUART->exchangeRaw(frame.data, frame.len, response, sizeof(response), truncated);
+  unsigned long tRx = ac.daikinUART->getLastRxMicros();
+  unsigned int pending = uxQueueMessagesWaiting(passthroughFrames);
+
+  // {"tx":"..","rx":"..","t":ms,"queuedUs":..,"latencyUs":..,"pending":..}, hex takes 3 chars per byte.
+  // "truncated":true when the response was longer than what is kept of it.
+  char txHex[PASSTHROUGH_FRAME_SIZE * 3];
+  static char rxHex[PASSTHROUGH_RESPONSE_SIZE * 3];
+  formatHEX(frame.data, frame.len, txHex, sizeof(txHex));
+  formatHEX(response, responseLen, rxHex, sizeof(rxHex));
+  if (truncated)
+    LOGW(TAG, "Passthrough response longer than %u bytes, truncated", (unsigned)sizeof(response));
+  controllerResultPost(RESULT_SERIAL_RECV, "{\"tx\":\"%s\",\"rx\":\"%s\",\"t\":%lu,\"queuedUs\":%lu,\"latencyUs\":%lu,\"pending\":%u%s}",
+                       txHex, rxHex, millis(), tTx - frame.queuedAt, tRx - tTx, pending, truncated ? ",\"truncated\":true" : "");
+  if (pending > 0)
+    controllerScheduler.at(passthroughJob, 0);
+}
+
+// A command with nothing set, beep off
+ControllerCommand controllerCommand(ControllerCommandType type)
+{
+  ControllerCommand command;
+  memset(&command, 0, sizeof(command));
+  command.type = type;
+  command.temperature = NAN;
+  command.beep = -1;
+  return command;
+}
+
+bool controllerCommandPost(const ControllerCommand &command)
+{
+  if (xQueueSend(controllerCommands, &command, 0) != pdTRUE)
+  {
+    LOGW(TAG, "Controller command dropped, queue full");
+    return false;
+  }
+  return true;
+}
+
+// Apply a posted command. Controller task, between two exchanges of a sync cycle.
+void controllerCommandRun(const ControllerCommand &command)
+{
+  PROFILE_SCOPE(PROF_COMMAND);
+  switch (command.type)
+  {
+  case CMD_CONNECT:
+    ac.connect(acSerial);
+    controllerScheduler.at(hvacJob, 0);
+    break;
+  case CMD_SETTINGS:
+    hpApplyCommand(command);
+    break;
+  case CMD_TOGGLE_POWER:
+    digitalWrite(LED_ACT, HIGH);
+    ac.togglePower();
+    ac.update();
+    digitalWrite(LED_ACT, LOW);
+    break;
+  case CMD_S21_PACKET:
+  {
+    Log.ln(TAG, "Send custom packet");
+    if (command.beep >= 0)
+      playBeep((Buzzer_preset)command.beep);
+    uint8_t payload[sizeof(command.packet)];
+    memcpy(payload, command.packet, command.packetLen);
+    if (command.packetLen == 2)
+      ac.daikinUART->sendCommandS21(payload[0], payload[1]);
+    else if (command.packetLen > 2)
+      ac.daikinUART->sendCommandS21(payload[0], payload[1], &payload[2], command.packetLen - 2);
+    Log.ln(TAG, "Get response from  custom packet ");
+    Log.ln(TAG, "%c", ac.daikinUART->getResponse().cmd1);
+    Log.ln(TAG, "%c", ac.daikinUART->getResponse().cmd2);
+    Log.ln(TAG, "%H", ac.daikinUART->getResponse().data, (int)ac.daikinUART->getResponse().dataSize);
+    break;
+  }
+  case CMD_S21EXP:
+    controllerScheduler.at(s21expJob, 0);
+    break;
+  case CMD_PASSTHROUGH:
+    controllerScheduler.at(passthroughJob, 0);
+    break;
+  }
+}
+
+#ifdef DK2MQTT_BENCHMARK
+// Resend what the unit reports the way a JSON command is sent, and wait for its ack. Returns the
+// post to ack time in µs, 0 for a nack or no ack within timeoutMs. Before loop() runs only, the
+// results are taken off the queue here and the others dropped.
+unsigned long benchmarkCommandRoundTrip(const char *id, uint32_t timeoutMs)
+{
+  static ControllerResult result;
+  char ack[64];
+  snprintf(ack, sizeof(ack), "{\"id\":\"%s\",\"result\":\"ack\"", id);
+  ControllerCommand command = controllerCommand(CMD_SETTINGS);
+  command.fromUnit = true;
+  strlcpy(command.id, id, sizeof(command.id));
+  command.tReceive = micros();
+  if (!controllerCommandPost(command))
+    return 0;
+
+  unsigned long tStart = millis();
+  while (millis() - tStart < timeoutMs)
+  {
+    if (xQueueReceive(controllerResults, &result, pdMS_TO_TICKS(10)) != pdTRUE)
+      continue;
+    if (strncmp(result.payload, ack, strlen(ack)) != 0)
+      continue;
+    const char *total = strstr(result.payload, "\"totalUs\":");
+    return total != nullptr ? strtoul(total + 10, NULL, 10) : 0;
+  }
+  return 0;
+}
+#endif
+
+void publishControllerSnapshot()
+{
+  ControllerSnapshot snapshot = {};
+  snapshot.settings = ac.getSettings();
+  snapshot.status = ac.getStatus();
+  snapshot.connected = ac.isConnected();
+  snapshot.synced = hpSynced;
+  snapshot.protocol = ac.daikinUART->currentProtocol();
+  snapshot.hpConnectionTotalRetries = hpConnectionTotalRetries;
+  controllerSnapshot.publish(snapshot);
+}
+
+// Set HA mode (off, heat_cool, heat, cool, dry, fan_only) on the state and the command.
+// Returns false for an unknown mode, nothing is changed in that case.
+bool hpApplyMode(const char *mode, HVACState &state, ControllerCommand &command)
+{
+  String modeUpper = mode;
+  modeUpper.toUpperCase();
+  if (modeUpper == "OFF")
+  {
+    state.mode = "off";
+    state.action = "off";
+    strlcpy(command.power, "OFF", sizeof(command.power));
+    return true;
+  }
+
+  if (modeUpper == "HEAT_COOL")
+  {
+    state.mode = "heat_cool";
+    state.action = "idle";
+    modeUpper = "AUTO";
+  }
+  else if (modeUpper == "HEAT")
+  {
+    state.mode = "heat";
+    state.action = "heating";
+  }
+  else if (modeUpper == "COOL")
+  {
+    state.mode = "cool";
+    state.action = "cooling";
+  }
+  else if (modeUpper == "DRY")
+  {
+    state.mode = "dry";
+    state.action = "drying";
+  }
+  else if (modeUpper == "FAN_ONLY")
+  {
+    state.mode = "fan_only";
+    state.action = "fan";
+    modeUpper = "FAN";
+  }
+  else
+  {
+    return false;
+  }
+  strlcpy(command.power, "ON", sizeof(command.power));
+  strlcpy(command.mode, modeUpper.c_str(), sizeof(command.mode));
+  return true;
+}
+
+// Set target temperature in local unit, out of range values fall back to 23°C like the remote does.
+void hpApplyTemperature(float temperature, HVACState &state, ControllerCommand &command)
+{
+  float temperature_c = convertLocalUnitToCelsius(temperature, useFahrenheit);
+
+  if (temperature_c < min_temp || temperature_c > max_temp)
+  {
+    temperature_c = 23;
+    state.temperature = convertCelsiusToLocalUnit(temperature_c, useFahrenheit);
+  }
+  else
+  {
+    state.temperature = temperature;
+  }
+  command.temperature = temperature_c;
+}
+
+// tTx/tRx are the wire timing of the exchange that carried the command, 0 when it never got that far.
+void hpPublishCommandResult(const char *id, const char *result, const char *error, unsigned long tReceive,
+                            unsigned long tTx = 0, unsigned long tRx = 0)
+{
+  // Timings are in µs up to the wire ack, the confirmation comes from a later sync so it is in ms.
+  StaticJsonDocument<JSON_OBJECT_SIZE(8) + 64> doc;
+  doc["id"] = id;
+  doc["result"] = result;
+  if (error != nullptr)
+  {
+    doc["error"] = error;
+  }
+  if (strcmp(result, "ack") == 0 || strcmp(result, "nack") == 0)
+  {
+    if (tTx)
+    {
+      doc["receiveToWireUs"] = tTx - tReceive;
+      doc["wireToAckUs"] = tRx - tTx;
+    }
+    doc["totalUs"] = micros() - tReceive;
+  }
+  else
+  {
+    doc["confirmMs"] = (micros() - tReceive) / 1000;
+  }
+
+  // Sized for the id as it came, which is longer than the queued ones for an "id too long" nack
+  size_t size = measureJson(doc) + 1;
+  if (size > CONTROLLER_RESULT_SIZE)
+  {
+    LOGW(TAG, "Command %s result is %u bytes, dropped", result, (unsigned)size);
+    return;
+  }
+  std::unique_ptr<char[]> mqttOutput(new char[size]);
+  serializeJson(doc, mqttOutput.get(), size);
+  controllerResultPost(RESULT_COMMAND_ACK, "%s", mqttOutput.get());
+}
+
+// JSON command with correlation id, e.g. {"id":"42","mode":"cool","temperature":22,"fan":"AUTO"}.
+// Every field is checked on a copy of the local state first, a nack leaves both the state and the unit
+// untouched. Then posted to the controller task, which publishes ack/nack with the wire result on the
+// ack topic, then confirmed/unconfirmed once a sync reads the settings back (see hpApplyCommand).
+void hpCommand(char *message)
+{
+  unsigned long tReceive = micros();
+  StaticJsonDocument<JSON_OBJECT_SIZE(8) + 128> doc;
+  DeserializationError err = deserializeJson(doc, message);
+  const char *id = doc["id"] | "";
+
+  if (err || id[0] == '\0')
+  {
+    hpPublishCommandResult(id, "nack", "invalid payload", tReceive);
+    return;
+  }
+  // The results that follow the ack carry the queued copy of the id, a cut one would match no command
+  if (strlen(id) >= sizeof(ControllerCommand::id))
+  {
+    hpPublishCommandResult(id, "nack", "id too long", tReceive);
+    return;
+  }
+  ControllerSnapshot snapshot = controllerSnapshot.read();
+  if (!snapshot.connected)
+  {
+    hpPublishCommandResult(id, "nack", "not connected", tReceive);
+    return;
+  }
+
+  ControllerCommand command = controllerCommand(CMD_SETTINGS);
+  HVACState state = localState;
+  bool hasSetting = false;
+  if (doc.containsKey("power"))
+  {
+    const char *power = doc["power"] | "";
+    if (strcasecmp(power, "ON") != 0 && strcasecmp(power, "OFF") != 0)
+    {
+      hpPublishCommandResult(id, "nack", "invalid power", tReceive);
+      return;
+    }
+    strlcpy(command.power, strcasecmp(power, "ON") == 0 ? "ON" : "OFF", sizeof(command.power));
+    hasSetting = true;
+  }
+  if (doc.containsKey("mode"))
+  {
+    if (!hpApplyMode(doc["mode"] | "", state, command))
+    {
+      hpPublishCommandResult(id, "nack", "invalid mode", tReceive);
+      return;
+    }
+    hasSetting = true;
+  }
+  if (doc.containsKey("temperature"))
+  {
+    if (!doc["temperature"].is<float>())
+    {
+      hpPublishCommandResult(id, "nack", "invalid temperature", tReceive);
+      return;
+    }
+    hpApplyTemperature(doc["temperature"].as<float>(), state, command);
+    hasSetting = true;
+  }
+  if (doc.containsKey("fan"))
+  {
+    const char *fan = doc["fan"] | "";
+    if (!DaikinController::isFanSpeed(snapshot.protocol, fan))
+    {
+      hpPublishCommandResult(id, "nack", "invalid fan", tReceive);
+      return;
+    }
+    strlcpy(state.fan, fan, sizeof(state.fan));
+    strlcpy(command.fan, fan, sizeof(command.fan));
+    hasSetting = true;
+  }
+  if (doc.containsKey("vane"))
+  {
+    const char *vane = doc["vane"] | "";
+    if (!DaikinController::isVerticalVaneSetting(snapshot.protocol, vane))
+    {
+      hpPublishCommandResult(id, "nack", "invalid vane", tReceive);
+      return;
+    }
+    strlcpy(state.vane, vane, sizeof(state.vane));
+    strlcpy(command.vane, vane, sizeof(command.vane));
+    hasSetting = true;
+  }
+  if (doc.containsKey("wideVane"))
+  {
+    if (snapshot.protocol != PROTOCOL_S21)
+    {
+      hpPublishCommandResult(id, "nack", "wideVane not supported", tReceive);
+      return;
+    }
+    const char *wideVane = doc["wideVane"] | "";
+    if (!DaikinController::isHorizontalVaneSetting(snapshot.protocol, wideVane))
+    {
+      hpPublishCommandResult(id, "nack", "invalid wideVane", tReceive);
+      return;
+    }
+    strlcpy(state.wideVane, wideVane, sizeof(state.wideVane));
+    strlcpy(command.wideVane, wideVane, sizeof(command.wideVane));
+    hasSetting = true;
+  }
+  if (!hasSetting)
+  {
+    hpPublishCommandResult(id, "nack", "no setting", tReceive);
+    return;
+  }
+
+  command.beep = SET;
+  strlcpy(command.id, id, sizeof(command.id));
+  command.tReceive = tReceive;
+  if (!controllerCommandPost(command))
+  {
+    hpPublishCommandResult(id, "nack", "busy", tReceive);
+    return;
+  }
+  localState = state;
+  hpSendLocalState();
+}
+
+// Send a CMD_SETTINGS command to the unit. Controller task. A command with an id is acked and then
+// waits in pendingCommand for a sync to confirm it.
+void hpApplyCommand(const ControllerCommand &command)
+{
+  if (command.fromUnit)
+  {
+    // Start from what the unit reports, the setters map the posted values onto the protocol tables
+    HVACSettings settings = ac.getSettings();
+    ac.setBasic(&settings);
+  }
+  if (command.power[0])
+    ac.setPowerSetting(command.power);
+  if (command.mode[0])
+    ac.setModeSetting(command.mode);
+  if (!isnan(command.temperature))
+    ac.setTemperature(command.temperature);
+  if (command.fan[0])
+    ac.setFanSpeed(command.fan);
+  if (command.vane[0])
+    ac.setVerticalVaneSetting(command.vane);
+  if (command.wideVane[0])
+    ac.setHorizontalVaneSetting(command.wideVane);
+
+  ac.daikinUART->markTiming();
+  digitalWrite(LED_ACT, HIGH);
+  if (command.beep >= 0)
+    playBeep((Buzzer_preset)command.beep);
+  HVACSettings requested = ac.getPendingSettings();
+  bool ok = ac.update(command.fromUnit);
+  lastCommandSend = millis();
+  digitalWrite(LED_ACT, LOW);
+  if (command.id[0] == '\0')
+    return;
+
+  unsigned long tTx = ac.daikinUART->getFirstTxMicros();
+  unsigned long tRx = ac.daikinUART->getLastRxMicros();
+  if (!ok)
+  {
+    hpPublishCommandResult(command.id, "nack", "no ack from unit", command.tReceive, tTx, tRx);
+    return;
+  }
+  hpPublishCommandResult(command.id, "ack", nullptr, command.tReceive, tTx, tRx);
+
+  // A newer command replaces the one waiting for confirmation.
+  if (pendingCommand.active)
+  {
+    hpPublishCommandResult(pendingCommand.id, "superseded", nullptr, pendingCommand.tReceive);
+  }
+  strlcpy(pendingCommand.id, command.id, sizeof(pendingCommand.id));
+  pendingCommand.settings = requested;
+  pendingCommand.tReceive = command.tReceive;
+  pendingCommand.active = true;
+}
+
+// Confirm the pending command once a sync (synced = true) reads back the requested settings, or time it out.
+void hpCheckCommandConfirmed(bool synced)
+{
+  if (!pendingCommand.active)
+    return;
+
+  if (!synced)
+  {
+    if (micros() - pendingCommand.tReceive > COMMAND_CONFIRM_TIMEOUT_MS * 1000UL)
+    {
+      hpPublishCommandResult(pendingCommand.id, "unconfirmed", nullptr, pendingCommand.tReceive);
+      pendingCommand.active = false;
+    }
+    return;
+  }
+
+  HVACSettings current = ac.getSettings();
+  const HVACSettings &wanted = pendingCommand.settings;
+  bool confirmed = strcmp(current.power, wanted.power) == 0;
+  // The unit keeps its mode/fan/temperature when switched off, only compare them when it should be running.
+  if (confirmed && strcmp(wanted.power, "ON") == 0)
+  {
+    confirmed = strcmp(current.mode, wanted.mode) == 0 &&
+                strcmp(current.fan, wanted.fan) == 0 &&
+                strcmp(current.verticalVane, wanted.verticalVane) == 0 &&
+                fabs(current.temperature - wanted.temperature) < 0.5;
+    if (ac.daikinUART->currentProtocol() == PROTOCOL_S21)
+    {
+      confirmed = confirmed && strcmp(current.horizontalVane, wanted.horizontalVane) == 0;
+    }
+  }
+
+  if (confirmed)
+  {
+    hpPublishCommandResult(pendingCommand.id, "confirmed", nullptr, pendingCommand.tReceive);
+    pendingCommand.active = false;
+  }
+}
+
 void mqttCallback(char *topic, byte *payload, unsigned int length)
 {
 
@@ -1832,123 +2949,69 @@ void mqttCallback(char *topic, byte *payload, unsigned int length)
   }
   message[length] = '\0';
 
+  // Settings go to the controller task as a command, the unit is never touched from here
+  ControllerCommand command = controllerCommand(CMD_SETTINGS);
+  uint8_t protocol = controllerSnapshot.read().protocol;
+
   // HA topics
   // Receive power topic
   if (strcmp(topic, ha_power_set_topic.c_str()) == 0)
   {
     String modeUpper = message;
     modeUpper.toUpperCase();
-    if (modeUpper == "OFF")
-    {
-      ac.setPowerSetting("OFF");
-      playBeep(OFF);
-      ac.update();
-    }
-    else if (modeUpper == "ON")
+    if (modeUpper == "OFF" || modeUpper == "ON")
     {
-      ac.setPowerSetting("ON");
-      playBeep(ON);
-      ac.update();
+      strlcpy(command.power, modeUpper.c_str(), sizeof(command.power));
+      command.beep = modeUpper == "OFF" ? OFF : ON;
+      controllerCommandPost(command);
     }
   }
   else if (strcmp(topic, ha_mode_set_topic.c_str()) == 0)
   {
-    String modeUpper = message;
-    modeUpper.toUpperCase();
-    if (modeUpper == "OFF")
-    {
-      rootInfo["mode"] = "off";
-      rootInfo["action"] = "off";
-      hpSendLocalState();
-      playBeep(OFF);
-      ac.setPowerSetting("OFF");
-    }
-    else
+    if (!hpApplyMode(message, localState, command))
     {
-      playBeep(ON);
-      if (modeUpper == "HEAT_COOL")
-      {
-        rootInfo["mode"] = "heat_cool";
-        rootInfo["action"] = "idle";
-        modeUpper = "AUTO";
-      }
-      else if (modeUpper == "HEAT")
-      {
-        rootInfo["mode"] = "heat";
-        rootInfo["action"] = "heating";
-      }
-      else if (modeUpper == "COOL")
-      {
-        rootInfo["mode"] = "cool";
-        rootInfo["action"] = "cooling";
-      }
-      else if (modeUpper == "DRY")
-      {
-        rootInfo["mode"] = "dry";
-        rootInfo["action"] = "drying";
-      }
-      else if (modeUpper == "FAN_ONLY")
-      {
-        rootInfo["mode"] = "fan_only";
-        rootInfo["action"] = "fan";
-        modeUpper = "FAN";
-      }
-      else
-      {
-        return;
-      }
-      hpSendLocalState();
-      ac.setPowerSetting("ON");
-      ac.setModeSetting(modeUpper.c_str());
+      return;
     }
-    ac.update();
+    command.beep = strcasecmp(message, "OFF") == 0 ? OFF : ON;
+    hpSendLocalState();
+    controllerCommandPost(command);
   }
   else if (strcmp(topic, ha_temp_set_topic.c_str()) == 0)
   {
-
-
-    float temperature = strtof(message, NULL);
-    float temperature_c = convertLocalUnitToCelsius(temperature, useFahrenheit);
-
-    if (temperature_c < min_temp || temperature_c > max_temp)
-    {
-      temperature_c = 23;
-      rootInfo["temperature"] = convertCelsiusToLocalUnit(temperature_c, useFahrenheit);
-    }
-    else
-    {
-      rootInfo["temperature"] = temperature;
-    }
-    playBeep(SET);
+    hpApplyTemperature(strtof(message, NULL), localState, command);
+    command.beep = SET;
     hpSendLocalState();
-    ac.setTemperature(temperature_c);
-    ac.update();
+    controllerCommandPost(command);
+  }
+  else if (strcmp(topic, ha_command_topic.c_str()) == 0)
+  {
+    hpCommand(message);
   }
   else if (strcmp(topic, ha_fan_set_topic.c_str()) == 0)
   {
-    rootInfo["fan"] = (String)message;
-    playBeep(SET);
+    strlcpy(localState.fan, message, sizeof(localState.fan));
+    strlcpy(command.fan, message, sizeof(command.fan));
+    command.beep = SET;
     hpSendLocalState();
-    ac.setFanSpeed(message);
-    ac.update();
+    controllerCommandPost(command);
   }
   else if (strcmp(topic, ha_vane_set_topic.c_str()) == 0)
   {
     // LOGD_f(TAG, "Set vertical vane %s\n",message);
-    rootInfo["vane"] = (String)message;
-    playBeep(SET);
+    strlcpy(localState.vane, message, sizeof(localState.vane));
+    strlcpy(command.vane, message, sizeof(command.vane));
+    command.beep = SET;
     hpSendLocalState();
-    ac.setVerticalVaneSetting(message);
-    ac.update();
+    controllerCommandPost(command);
   }
-  else if (strcmp(topic, ha_wideVane_set_topic.c_str()) == 0 && (ac.daikinUART->currentProtocol() == PROTOCOL_S21))
+  else if (strcmp(topic, ha_wideVane_set_topic.c_str()) == 0 && (protocol == PROTOCOL_S21))
   {
     // LOGD_f(TAG, "Wide Vane = %s\n", message);
-    rootInfo["wideVane"] = (String)message;
-    playBeep(SET);
+    strlcpy(localState.wideVane, message, sizeof(localState.wideVane));
+    strlcpy(command.wideVane, message, sizeof(command.wideVane));
+    command.beep = SET;
     hpSendLocalState();
-    ac.setHorizontalVaneSetting(message);
-    ac.update();
+    controllerCommandPost(command);
   }
   // else if (strcmp(topic, ha_remote_temp_set_topic.c_str()) == 0) {
   //   float temperature = strtof(message, NULL);
@@ -1968,7 +3031,14 @@ void mqttCallback(char *topic, byte *payload, unsigned int length)
       mqtt_client.publish(ha_debug_topic.c_str(), (char *)("Debug mode disabled"));
     }
   }
-  else if (strcmp(topic, ha_custom_packet_s21.c_str()) == 0 && (ac.daikinUART->currentProtocol() == PROTOCOL_S21))
+  else if (strcmp(topic, ha_log_level_set_topic.c_str()) == 0)
+  { // "DKUART=trace" or a list like the Others page takes, until the next reboot
+    char logLevels[LOG_TAG_LEVELS * (LOG_TAG_MAX + 8) + 16];
+    bool ok = Log.setLevels(message);
+    Log.levels(logLevels, sizeof(logLevels));
+    mqtt_client.publish(ha_debug_topic.c_str(), (String(ok ? "Log levels: " : "Log levels, some not understood: ") + logLevels).c_str());
+  }
+  else if (strcmp(topic, ha_custom_packet_s21.c_str()) == 0 && (protocol == PROTOCOL_S21))
   { // send custom packet for advance user
     String custom = message;
 
@@ -1976,90 +3046,28 @@ void mqttCallback(char *topic, byte *payload, unsigned int length)
     char buffer[(custom.length() + 1)]; // +1 for the NULL at the end
     custom.toCharArray(buffer, (custom.length() + 1));
 
-    byte bytes[20]; // max custom packet bytes is 20
-    int byteCount = 0;
+    command.type = CMD_S21_PACKET;
+    command.beep = SET;
     char *nextByte;
 
     // loop over the byte string, breaking it up by spaces (or at the end of the line - \n)
     nextByte = strtok(buffer, " ");
-    while (nextByte != NULL && byteCount < 20)
+    while (nextByte != NULL && command.packetLen < sizeof(command.packet)) // max custom packet bytes is 20
     {
-      bytes[byteCount] = strtol(nextByte, NULL, 16); // convert from hex string
+      command.packet[command.packetLen] = strtol(nextByte, NULL, 16); // convert from hex string
       nextByte = strtok(NULL, "   ");
-      byteCount++;
+      command.packetLen++;
     }
-
-    Log.ln(TAG, "Send custom packet");
-    playBeep(SET);
-    bool res = false;
-    if (byteCount == 2)
-    {
-      res = ac.daikinUART->sendCommandS21(bytes[0], bytes[1]);
-    }
-    else if (byteCount > 2)
-    {
-      res = ac.daikinUART->sendCommandS21(bytes[0], bytes[1], &bytes[2], byteCount - 2);
-    }
-    Log.ln(TAG, "Get response from  custom packet ");
-    Log.ln(TAG, String(ac.daikinUART->getResponse().cmd1));
-    Log.ln(TAG, String(ac.daikinUART->getResponse().cmd2));
-    Log.ln(TAG, String(getHEXformatted2(ac.daikinUART->getResponse().data, ac.daikinUART->getResponse().dataSize)));
+    controllerCommandPost(command);
   }
   else if (strcmp(topic, ha_custom_query_experimental.c_str()) == 0)
   {
-    String command[256];
-    uint8_t commandCount = 0;
-    char *nextByte;
-    nextByte = strtok(message, " ,");
-
-    while (nextByte != NULL && commandCount < 256)
-    {
-      command[commandCount] = nextByte;
-      nextByte = strtok(NULL, " ,");
-      commandCount++;
-    }
-    String commandRes;
-
-    for (int i = 0; i < commandCount; i++)
-    {
-      bool resOK = ac.daikinUART->sendCommandS21(command[i][0], command[i][1]);
-      if (resOK)
-      {
-        uint8_t dataTruncated[256];
-        memcpy(dataTruncated, ac.daikinUART->getResponse().data + 3, ac.daikinUART->getResponse().dataSize - 5);
-        commandRes += "CMD: " + command[i] + " Res: " + getHEXformatted2(dataTruncated, ac.daikinUART->getResponse().dataSize - 5) + "\n";
-      }
-      else
-      {
-        commandRes += "CMD: " + command[i] + " Res: N/A\n";
-      }
-    }
-    Log.ln(TAG, commandRes);
+    s21expStart(message, length);
   }
 
   else if (strcmp(topic, ha_serial_send_topic.c_str()) == 0)
   {
-    if (_debugMode && ac.isConnected())
-    {
-      Log.ln(TAG, "Serial SEND >> " + getHEXformatted2(payload, length));
-      acSerial->write(payload, length);
-
-      // if (acSerial->available() > 0){
-      uint8_t buff[255];
-      // String data = acSerial->readStringUntil(0x03);
-      uint8_t len = acSerial->readBytesUntil(0x03, buff, 255);
-
-      if (len)
-      {
-        buff[len] = 0x03;
-        len++;
-      }
-
-
-      Log.ln(TAG, "Serial RECV << " + getHEXformatted2(buff, len));
-      mqtt_client.publish(ha_serial_recv_topic.c_str(), buff, len);
-      // }
-    }
+    passthroughEnqueue(payload, length);
   }else if (strcmp(topic, ha_switch_unit_led_set_topic.c_str()) == 0){
     ledEnabled = strcmp(message,"ON") == 0;
     updateUnitSettings();
@@ -2086,7 +3094,8 @@ void addMQTTDeviceInfo(DynamicJsonDocument *JsonDocument)
   haConfigDevice["ids"] = mqtt_fn;
   haConfigDevice["name"] = mqtt_fn;
   haConfigDevice["sw"] = "Daikin2MQTT " + String(dk2mqtt_version);
-  haConfigDevice["mdl"] = ac.getModelName().isEmpty() ? "HVAC Daikin" : ac.getModelName();
+  String model = controllerSnapshot.read().status.modelName;
+  haConfigDevice["mdl"] = model.isEmpty() ? "HVAC Daikin" : model;
   haConfigDevice["mf"] = "Daikin";
   haConfigDevice["hw"] = hardware_version;
   haConfigDevice["cu"] = "http://" + WiFi.localIP().toString();
@@ -2132,6 +3141,7 @@ void publishMQTTSensorConfig(const char *name, const char *id, const char *icon,
 
 void haConfig()
 {
+  uint8_t protocol = controllerSnapshot.read().protocol;
 
   // send HA config packet
   // setup HA payload device
@@ -2189,7 +3199,7 @@ void haConfig()
   haClimateConfig["temperature_unit"] = useFahrenheit ? "F" : "C";
 
   JsonArray haConfigFan_modes = haClimateConfig.createNestedArray("fan_modes");
-  if (ac.daikinUART->currentProtocol() == PROTOCOL_S21)
+  if (protocol == PROTOCOL_S21)
   {
     haConfigFan_modes.add("AUTO");
     haConfigFan_modes.add("QUIET");
@@ -2198,7 +3208,7 @@ void haConfig()
     haConfigFan_modes.add("3");
     haConfigFan_modes.add("4");
     haConfigFan_modes.add("5");
-  }else if (ac.daikinUART->currentProtocol() == PROTOCOL_X50)
+  }else if (protocol == PROTOCOL_X50)
   {
     haConfigFan_modes.add("AUTO");
     haConfigFan_modes.add("1");
@@ -2212,7 +3222,7 @@ void haConfig()
   haClimateConfig["fan_mode_stat_t"] = ha_state_topic;
   haClimateConfig["fan_mode_stat_tpl"] = F("{{ value_json.fan if (value_json is defined and value_json.fan is defined and value_json.fan|length) else 'SWING' }}"); // Set default value for fix "Could not parse data for HA"
 
-  if (ac.daikinUART->currentProtocol() == PROTOCOL_S21)
+  if (protocol == PROTOCOL_S21)
   {
     JsonArray haConfigSwing_modes = haClimateConfig.createNestedArray("swing_modes");
     haConfigSwing_modes.add("HOLD");
@@ -2220,7 +3230,7 @@ void haConfig()
     haClimateConfig["swing_mode_cmd_t"] = ha_vane_set_topic;
     haClimateConfig["swing_mode_stat_t"] = ha_state_topic;
     haClimateConfig["swing_mode_stat_tpl"] = F("{{ value_json.vane if (value_json is defined and value_json.vane is defined and value_json.vane|length) else 'SWING' }}"); // Set default value for fix "Could not parse data for HA"
-  }else if (ac.daikinUART->currentProtocol() == PROTOCOL_X50)
+  }else if (protocol == PROTOCOL_X50)
   {
     JsonArray haConfigSwing_modes = haClimateConfig.createNestedArray("swing_modes");
     haConfigSwing_modes.add("SWING");
@@ -2267,13 +3277,13 @@ void haConfig()
   publishMQTTSensorConfig("Compressor Frequency", "_comp_freq", HA_sine_wave_icon, "Hz", NULL, ha_state_topic, comp_freq_tpl_str, ha_sensor_comp_freq_config_topic);
   publishMQTTSensorConfig("Error Code", "_error_code", HA_alert, NULL, NULL, ha_state_topic, error_code_tpl_str, ha_sensor_error_code_config_topic, "diagnostic");
 
-  if (ac.daikinUART->currentProtocol() == PROTOCOL_S21){
+  if (protocol == PROTOCOL_S21){
     publishMQTTSensorConfig("Energy Meter", "_energy_meter", HA_counter, "kWh", "energy", ha_state_topic, energy_meter_tpl_str, ha_sensor_energy_meter_config_topic);
   }
 
 
   // Vane vertical config 
-  if (ac.daikinUART->currentProtocol() == PROTOCOL_S21)
+  if (protocol == PROTOCOL_S21)
   {
     const size_t capacityVaneVerticalConfig = JSON_ARRAY_SIZE(8) + JSON_OBJECT_SIZE(7) + JSON_OBJECT_SIZE(8) + 2048;
     DynamicJsonDocument haVaneVerticalConfig(capacityVaneVerticalConfig);
@@ -2304,7 +3314,7 @@ void haConfig()
   }
 
   // Vane horizontal config
-  if (ac.daikinUART->currentProtocol() == PROTOCOL_S21)
+  if (protocol == PROTOCOL_S21)
   {
     const size_t capacityVaneHorizontalConfig = JSON_ARRAY_SIZE(7) + JSON_OBJECT_SIZE(7) + JSON_OBJECT_SIZE(8) + 2048;
     DynamicJsonDocument haVaneHorizontalConfig(capacityVaneHorizontalConfig);
@@ -2370,6 +3380,22 @@ void haConfig()
   mqtt_client.endPublish();
 }
 
+void publishResetReport()
+{
+  // Retained, so the reason of the last reset and what hung before the last crash are there after the fact
+  char *json = (char *)malloc(RESET_JSON_SIZE);
+  if (json == nullptr)
+    return;
+  size_t len = resetReport.writeJson(json, RESET_JSON_SIZE);
+  if (len > 0)
+  {
+    mqtt_client.beginPublish(ha_reset_topic.c_str(), len, true);
+    mqtt_client.write((const uint8_t *)json, len);
+    mqtt_client.endPublish();
+  }
+  free(json);
+}
+
 void mqttConnect()
 {
   // Loop until we're reconnected
@@ -2384,7 +3410,6 @@ void mqttConnect()
     {
       if (attempts == 5)
       {
-        lastMqttRetry = millis();
         return;
       }
       else
@@ -2401,7 +3426,9 @@ void mqttConnect()
     // We are connected
     else
     {
+      metrics.mqttConnected();
       mqtt_client.subscribe(ha_debug_set_topic.c_str());
+      mqtt_client.subscribe(ha_log_level_set_topic.c_str());
       mqtt_client.subscribe(ha_power_set_topic.c_str());
       mqtt_client.subscribe(ha_mode_set_topic.c_str());
       mqtt_client.subscribe(ha_fan_set_topic.c_str());
@@ -2414,7 +3441,9 @@ void mqttConnect()
       mqtt_client.subscribe(ha_serial_send_topic.c_str());
       mqtt_client.subscribe(ha_switch_unit_led_set_topic.c_str());
       mqtt_client.subscribe(ha_switch_unit_beep_set_topic.c_str());
+      mqtt_client.subscribe(ha_command_topic.c_str());
       mqtt_client.publish(ha_availability_topic.c_str(), !_debugMode ? mqtt_payload_available : mqtt_payload_unavailable, true); // publish status as available
+      publishResetReport();
       if (others_haa)
       {
         haConfig();
@@ -2457,10 +3486,10 @@ bool connectWifi()
   }
   if (WiFi.status() != WL_CONNECTED)
   {
-    Log.ln(TAG, "Failed to connect to wifi");
+    LOGE(TAG, "Failed to connect to wifi");
     return false;
   }
-  Log.ln(TAG, "Connected to " + ap_ssid);
+  Log.ln(TAG, "Connected to %s", ap_ssid.c_str());
   Log.ln(TAG, "Ready");
   while (WiFi.localIP().toString() == "0.0.0.0" || WiFi.localIP().toString() == "")
   {
@@ -2469,10 +3498,10 @@ bool connectWifi()
   }
   if (WiFi.localIP().toString() == "0.0.0.0" || WiFi.localIP().toString() == "")
   {
-    Log.ln(TAG, "Failed to get IP Address");
+    LOGE(TAG, "Failed to get IP Address");
     return false;
   }
-  Log.ln(TAG, "IP address: " + WiFi.localIP().toString());
+  Log.ln(TAG, "IP address: %s", WiFi.localIP().toString().c_str());
   // ticker.detach(); // Stop blinking the LED because now we are connected:)
   // keep LED off (For Wemos D1-Mini)
   digitalWrite(LED_ACT, LOW);
@@ -2534,38 +3563,20 @@ String getId()
   return lastMac;
 }
 
-// Check if header is present and correct
+// Check the session cookie against the live login sessions
 bool is_authenticated()
 {
-  if (server.hasHeader("Cookie"))
-  {
-    // Found cookie;
-    String cookie = server.header("Cookie");
-    if (cookie.indexOf("M2MSESSIONID=1") != -1)
-    {
-      // Authentication Successful
-      return true;
-    }
-  }
-  // Authentication Failed
-  return false;
+  // Empty when the request has no cookie
+  return sessions.validate(server.header("Cookie").c_str());
 }
 
 bool checkLogin()
 {
-  if (!is_authenticated() && login_password.length() > 0)
+  if (login_password.length() > 0 && !is_authenticated())
   {
     server.sendHeader("Location", "/login");
     server.sendHeader("Cache-Control", "no-cache");
-    // use javascript in the case browser disable redirect
-    String redirectPage = F("<html lang=\"en\" class=\"\"><head><meta charset='utf-8'>");
-    redirectPage += F("<script>");
-    redirectPage += F("setTimeout(function () {");
-    redirectPage += F("window.location.href= '/login';");
-    redirectPage += F("}, 1000);");
-    redirectPage += F("</script>");
-    redirectPage += F("</body></html>");
-    server.send(302, F("text/html"), redirectPage);
+    server.send_P(302, "text/html", redirect_to_login_page);
     return false;
   }
   return true;
@@ -2590,6 +3601,7 @@ void safeMode()
 
 void handleButton()
 {
+  PROFILE_SCOPE(PROF_BUTTON);
   if (millis() > 10000)
   {
     switch (btnAction)
@@ -2597,22 +3609,15 @@ void handleButton()
 
     case (shortPress):
       Log.ln(TAG, "Handle Short press");
-      if (ac.isConnected())
+      if (controllerSnapshot.read().connected)
       {
-        digitalWrite(LED_ACT, HIGH);
-        ac.togglePower();
-        ac.update();
-        digitalWrite(LED_ACT, LOW);
+        controllerCommandPost(controllerCommand(CMD_TOGGLE_POWER));
       }
       else
       {
-        for (int i = 0; i < 4; i++)
-        {
-          digitalWrite(LED_ACT, HIGH);
-          delay(200);
-          digitalWrite(LED_ACT, LOW);
-          delay(200);
-        }
+        // Nothing to toggle, flash the activity LED four times
+        blinksLeft = 8;
+        scheduler.at(blinkJob, 0);
       }
       btnAction = noPress;
       break;
@@ -2645,13 +3650,13 @@ void IRAM_ATTR InterruptBTN()
 
   if (btnPressed)
   {
-    Log.ln(TAG, "Pressed");
+    Log.lnFromISR(TAG, "Pressed");
     BTNPresedTime = millis();
     return;
   }
   else
   {
-    Log.ln(TAG, "Released");
+    Log.lnFromISR(TAG, "Released");
     unsigned long pressedTime = millis() - BTNPresedTime;
     // digitalWrite(LED_ACT,0);
     if (pressedTime > 50 && pressedTime < 500)
@@ -2673,6 +3678,18 @@ void IRAM_ATTR InterruptBTN()
   }
 }
 
+// The MQTT and OTA polls at their power save intervals or back. Before setupJobs() there are no jobs
+// yet, it picks the intervals itself.
+void setPowerSave(bool on)
+{
+  if (on)
+    powerSave.enable();
+  else
+    powerSave.disable();
+  scheduler.every(mqttJob, on ? MQTT_POWER_SAVE_POLL_INTERVAL_MS : MQTT_POLL_INTERVAL_MS);
+  scheduler.every(otaJob, on ? OTA_POWER_SAVE_POLL_INTERVAL_MS : OTA_POLL_INTERVAL_MS);
+}
+
 void onFirstSyncSuccess()
 {
   // if (ac.daikinUART->currentProtocol() == PROTOCOL_X50){
@@ -2687,6 +3704,9 @@ void onFirstSyncSuccess()
 void setup()
 {
   Serial.begin(115200); // USB CDC (Built-in)
+  Log.begin();
+  resetReport.begin();
+  powerSave.begin();
   pinMode(LED_ACT, OUTPUT);
   pinMode(LED_PWR, OUTPUT);
   pinMode(LED_PWR, OUTPUT);
@@ -2710,11 +3730,14 @@ void setup()
 
 
   Log.ln(TAG, "----Starting Daikin2MQTT----");
-  Log.ln(TAG, "FW Version:\t" + String(dk2mqtt_version));
-  Log.ln(TAG, "HW Version:\t" + String(hardware_version));
-  Log.ln(TAG, "ESP Chip Model:\t" + String(ESP.getChipModel()));
-  Log.ln(TAG, "ESP PSRam Size:\t" + String(ESP.getPsramSize() / 1000) + " Kb");
-  Log.ln(TAG, "MAC Address:\t" + WiFi.macAddress());
+  Log.ln(TAG, "FW Version:\t%s", dk2mqtt_version);
+  Log.ln(TAG, "HW Version:\t%s", hardware_version);
+  Log.ln(TAG, "ESP Chip Model:\t%s", ESP.getChipModel());
+  Log.ln(TAG, "ESP PSRam Size:\t%u Kb", (unsigned)(ESP.getPsramSize() / 1000));
+  Log.ln(TAG, "MAC Address:\t%s", WiFi.macAddress().c_str());
+  char resetDescription[256];
+  resetReport.describe(resetDescription, sizeof(resetDescription));
+  Log.ln(TAG, "Reset:\t%s", resetDescription);
 
   if (esp_reset_reason() == ESP_RST_TASK_WDT)
   {
@@ -2729,12 +3752,12 @@ void setup()
   }
   else
   {
-    Log.ln(TAG, "SPIFFS Mount Failed. Formatting...");
+    LOGW(TAG, "SPIFFS Mount Failed. Formatting...");
     if(SPIFFS.format()){
       Log.ln(TAG, "Formatting Completed");
       SPIFFS.begin();
     }else{
-      Log.ln(TAG, "Format Failed. The system may not work properly!");
+      LOGE(TAG, "Format Failed. The system may not work properly!");
     }
   }
 
@@ -2747,6 +3770,8 @@ void setup()
   wifi_config_exists = loadWifi();
   loadOthers();
   loadUnit();
+  // Before anything renders a page, the captive portal included
+  language.select(language_code.c_str());
 
   if (initWifi())
   {
@@ -2766,6 +3791,8 @@ void setup()
     server.on("/logging", handleLogging);
     server.on("/api/logs", handleAPILogs);
     server.on("/api/acstatus", handleAPIACStatus);
+    server.on("/events", HTTP_GET, handleEvents);
+    server.on("/metrics", HTTP_GET, handleMetrics);
     server.on("/init", handleInitSetup); // for testing
     server.onNotFound(handleNotFound);
 
@@ -2778,18 +3805,12 @@ void setup()
     if (login_password.length() > 0)
     {
       server.on("/login", handleLogin);
-      // here the list of headers to be recorded, use for authentication
-      const char *headerkeys[] = {"User-Agent", "Cookie"};
-      size_t headerkeyssize = sizeof(headerkeys) / sizeof(char *);
-      // ask server to track these headers
-      server.collectHeaders(headerkeys, headerkeyssize);
     }
+    initWebAssets();
     server.on("/upgrade", handleUpgrade);
     server.on("/upload", HTTP_POST, handleUploadDone, handleUploadLoop);
 
-    server.begin();
-    lastMqttRetry = 0;
-    lastHpSync = 0;
+    startWebServer();
     hpConnectionRetries = 0;
     hpConnectionTotalRetries = 0;
     if (loadMqtt())
@@ -2806,15 +3827,22 @@ void setup()
       ha_settings_topic = mqtt_topic + "/" + mqtt_fn + "/settings";
       ha_unit_settings_topic = mqtt_topic + "/" + mqtt_fn + "/unitSettings";
       ha_state_topic = mqtt_topic + "/" + mqtt_fn + "/state";
+      ha_state_history_topic = mqtt_topic + "/" + mqtt_fn + "/state/history";
       ha_debug_topic = mqtt_topic + "/" + mqtt_fn + "/debug";
       ha_serial_recv_topic = mqtt_topic + "/" + mqtt_fn + "/serial/recv";
+      ha_profile_topic = mqtt_topic + "/" + mqtt_fn + "/profile";
       ha_serial_send_topic = mqtt_topic + "/" + mqtt_fn + "/serial/send";
       ha_debug_set_topic = mqtt_topic + "/" + mqtt_fn + "/debug/set";
+      ha_log_level_set_topic = mqtt_topic + "/" + mqtt_fn + "/log_level/set";
+      ha_reset_topic = mqtt_topic + "/" + mqtt_fn + "/reset";
       ha_custom_packet_s21 = mqtt_topic + "/" + mqtt_fn + "/send/s21";
       ha_custom_query_experimental = mqtt_topic + "/" + mqtt_fn + "/send/s21exp";
+      ha_custom_query_experimental_response = mqtt_topic + "/" + mqtt_fn + "/send/s21exp/response";
       ha_availability_topic = mqtt_topic + "/" + mqtt_fn + "/availability";
       ha_switch_unit_led_set_topic = mqtt_topic + "/" + mqtt_fn + "/led/set";
       ha_switch_unit_beep_set_topic = mqtt_topic + "/" + mqtt_fn + "/beep/set";
+      ha_command_topic = mqtt_topic + "/" + mqtt_fn + "/command";
+      ha_command_ack_topic = mqtt_topic + "/" + mqtt_fn + "/command/ack";
 
       if (others_haa)
       {
@@ -2839,25 +3867,10 @@ void setup()
       // write_log("Not found MQTT config go to configuration page");
     }
     // write_log("Connection to HVAC");
-    ac.setSettingsChangedCallback(hpSettingsChanged);
-    ac.setStatusChangedCallback(hpStatusChanged);
     // ac.setPacketCallback(hpPacketDebug);
     // Allow Remote/Panel
     ac.connect(acSerial);
-    HVACStatus currentStatus = ac.getStatus();
-    HVACSettings currentSettings = ac.getSettings();
-    rootInfo["roomTemperature"] = convertCelsiusToLocalUnit(currentStatus.roomTemperature, useFahrenheit);
-    rootInfo["outsideTemperature"] = convertCelsiusToLocalUnit(currentStatus.outsideTemperature, useFahrenheit);
-    rootInfo["internalCoilTemperature"] = convertCelsiusToLocalUnit(currentStatus.coilTemperature, useFahrenheit);
-    rootInfo["temperature"] = convertCelsiusToLocalUnit(currentSettings.temperature, useFahrenheit);
-    rootInfo["fan"] = currentSettings.fan;
-    rootInfo["fanRPM"] = int(currentStatus.fanRPM);
-    rootInfo["vane"] = currentSettings.horizontalVane;
-    rootInfo["wideVane"] = currentSettings.verticalVane;
-    rootInfo["mode"] = hpGetMode(currentSettings);
-    rootInfo["action"] = hpGetAction(currentStatus, currentSettings);
-    rootInfo["compressorFrequency"] = currentStatus.compressorFrequency;
-    rootInfo["errorCode"] = currentStatus.errorCode;
+    readHeatPumpStatus(localState, ac.getStatus(), ac.getSettings(), ac.daikinUART->currentProtocol());
     lastTempSend = millis();
   }
   else
@@ -2867,9 +3880,18 @@ void setup()
     initCaptivePortal();
   }
   initOTA();
+  if (!captive && others_power_save)
+    setPowerSave(true);
+  setupJobs();
+  if (!captive)
+    startControllerTask();
 
   Log.ln(TAG, "---Setup completed---");
 
+#ifdef DK2MQTT_BENCHMARK
+  runBenchmarks();
+#endif
+
   digitalWrite(LED_ACT, LOW);
 
   // Enable watchdog
@@ -2877,109 +3899,296 @@ void setup()
   esp_task_wdt_add(NULL);
 }
 
-void loop()
+// What used to be checked on every loop() pass, now jobs of the scheduler. Budgets are the longest
+// run expected, the unit's own jobs run on the controller task (see setupControllerJobs).
+void setupJobs()
+{
+  scheduler.add("wifi", wifiStep, WIFI_CHECK_INTERVAL_MS, 1000);
+  otaJob = scheduler.add("ota", []()
+                {
+                  PROFILE_SCOPE(PROF_OTA);
+                  ArduinoOTA.handle(); }, powerSave.enabled() ? OTA_POWER_SAVE_POLL_INTERVAL_MS : OTA_POLL_INTERVAL_MS, 5000);
+  scheduler.add("led", ledStep, LED_INTERVAL_MS, 1000);
+  scheduler.add("button", handleButton, BUTTON_POLL_INTERVAL_MS, 1000);
+  blinkJob = scheduler.add("blink", blinkStep, 0, 1000);
+  scheduler.add("power", []()
+                { powerSave.sample(); }, POWER_SAMPLE_INTERVAL_MS, 1000);
+  if (captive)
+  {
+    scheduler.add("dns", []()
+                  { dnsServer.processNextRequest(); }, DNS_POLL_INTERVAL_MS, 5000);
+    return;
+  }
+  if (mqtt_config)
+  {
+    mqttJob = scheduler.add("mqtt", mqttStep, powerSave.enabled() ? MQTT_POWER_SAVE_POLL_INTERVAL_MS : MQTT_POLL_INTERVAL_MS, 50000);
+    scheduler.add("profile", profilePublishStep, PROFILE_PUBLISH_INTERVAL_MS, 5000);
+    mqttConnectJob = scheduler.add("mqtt_connect", mqttConnectStep, MQTT_RETRY_INTERVAL_MS, 1000000);
+  }
+}
+
+// Everything that talks to the unit. Budgets are a UART exchange at 2400 baud with its timeout,
+// the beep of a command included.
+void setupControllerJobs()
 {
+  hvacJob = controllerScheduler.add("hvac", hvacStep, 0, 400000);
+  controllerScheduler.at(hvacJob, 0);
+  s21expJob = controllerScheduler.add("s21exp", s21expStep, 0, 400000);
+  passthroughJob = controllerScheduler.add("passthrough", passthroughStep, 0, 400000);
+  controllerScheduler.add("command_confirm", []()
+                          { hpCheckCommandConfirmed(false); }, COMMAND_CONFIRM_CHECK_INTERVAL_MS, 1000);
+}
 
-  server.handleClient();
-  ArduinoOTA.handle();
-  esp_task_wdt_reset();
-  bool mqttOK = false;
+// Owns ac and the UART: runs the controller jobs, applies the commands as they arrive and publishes
+// the snapshot. Alone on its core, so a sync cycle keeps its pace whatever WiFi, MQTT and the web
+// server are doing on the other one.
+void controllerTaskRun(void *parameter)
+{
+  esp_task_wdt_add(NULL);
+  for (;;)
+  {
+    esp_task_wdt_reset();
+    uint32_t idleMs = controllerScheduler.run();
+    publishControllerSnapshot();
+
+    // Sleep until the next job is due, a command ends it early. At least a tick, so the idle task
+    // of this core runs even while a job keeps re-arming itself right away.
+    ControllerCommand command;
+    if (xQueueReceive(controllerCommands, &command, max(pdMS_TO_TICKS(idleMs), (TickType_t)1)) == pdTRUE)
+    {
+      resetReport.stage(STAGE_HVAC_COMMAND);
+      controllerCommandRun(command);
+    }
+  }
+}
+
+void startControllerTask()
+{
+  setupControllerJobs();
+  // Above loop() and the web task, should anything else ever be pinned to its core
+  xTaskCreatePinnedToCore(controllerTaskRun, "controller", CONTROLLER_TASK_STACK_SIZE, NULL, 2, &controllerTask, CONTROLLER_TASK_CORE);
+}
 
-  // reset board to attempt to connect to wifi again if in ap mode or wifi dropped out and time limit passed
+// reset board to attempt to connect to wifi again if in ap mode or wifi dropped out and time limit passed
+void wifiStep()
+{
   if (WiFi.getMode() == WIFI_STA && WiFi.status() == WL_CONNECTED)
   {
     wifi_timeout = millis() + WIFI_RETRY_INTERVAL_MS;
+    if (!wifiWasConnected && wifiJoinedOnce)
+      wifiReconnects++;
+    wifiWasConnected = true;
+    wifiJoinedOnce = true;
   }
-  else if (wifi_config_exists && millis() > wifi_timeout)
+  else
   {
-    ESP.restart();
+    wifiWasConnected = false;
+    if (wifi_config_exists && millis() > wifi_timeout)
+    {
+      ESP.restart();
+    }
   }
+}
 
-  if (!captive)
-  {
-    digitalWrite(LED_ACT, LOW);
-    // Sync HVAC UNIT
-    if (!ac.isConnected()) // AC Not Connected
+// Reconnects to the unit with backoff, then runs the sync cycle one exchange at a time. Re-arms
+// itself for whatever comes next. Controller task.
+void hvacStep()
+{
+  if (!ac.isConnected()) // AC Not Connected
+  {
+    Log.ln(TAG, "Reconnect HVAC");
+    // If we've retried more than the max number of tries, keep retrying at that fixed interval, which is several minutes.
+    hpConnectionRetries = min(hpConnectionRetries + 1u, HP_MAX_RETRIES);
+    hpConnectionTotalRetries++;
+    resetReport.stage(STAGE_HVAC_CONNECT);
+    bool connected;
     {
-      digitalWrite(LED_PWR, millis() / 1000 %2);
-      // Use exponential backoff for retries, where each retry is double the length of the previous one.
-      unsigned long timeNextSync = (1 << hpConnectionRetries) * HP_RETRY_INTERVAL_MS + lastHpSync;
-      if (((millis() > timeNextSync) | lastHpSync == 0))
-      {
-        Log.ln(TAG, "Reconnect HVAC");
-        lastHpSync = millis();
-        // If we've retried more than the max number of tries, keep retrying at that fixed interval, which is several minutes.
-        hpConnectionRetries = min(hpConnectionRetries + 1u, HP_MAX_RETRIES);
-        hpConnectionTotalRetries++;
-        if (ac.connect(acSerial))
-        {
-          ac.sync();
-          if (firstSync)
-          {
-            onFirstSyncSuccess();
-          }
-
-          if (_debugMode)
-          {
-            acSerial->setTimeout(200);
-          }
-        }
-      }
+      PROFILE_SCOPE(PROF_HVAC_CONNECT);
+      connected = ac.connect(acSerial);
     }
-    else
+    if (connected && _debugMode)
     {
-      digitalWrite(LED_PWR, ledEnabled? HIGH: LOW);
-      hpConnectionRetries = 0;
-
-      if (!_debugMode && ac.sync())
-      {
-        if (firstSync)
-        {
-          onFirstSyncSuccess();
-        }
-        ac.readState();
-        Log.ln(TAG, "PSRAM size:\t" + String(ESP.getPsramSize()));
-        Log.ln(TAG, "PSRAM Free:\t" + String(ESP.getFreePsram()));
-        Log.ln(TAG, "Heap left:\t" + String(esp_get_free_heap_size()));
-        Log.ln(TAG, "Free Stack Space:\t" + String(uxTaskGetStackHighWaterMark(NULL)));
-      }
+      acSerial->setTimeout(200);
     }
+    // Use exponential backoff for retries, where each retry is double the length of the previous one.
+    controllerScheduler.at(hvacJob, connected ? 0 : (1 << hpConnectionRetries) * HP_RETRY_INTERVAL_MS);
+    return;
+  }
+  hpConnectionRetries = 0;
+
+  // Debug mode leaves the UART to the raw frames
+  if (_debugMode)
+  {
+    controllerScheduler.at(hvacJob, HP_RETRY_INTERVAL_MS);
+    return;
+  }
 
-    if (mqtt_config)
+  resetReport.stage(STAGE_HVAC_SYNC);
+  unsigned long stepStart = micros();
+  SyncResult result;
+  {
+    PROFILE_SCOPE(PROF_SYNC_STEP);
+    result = ac.syncStep();
+  }
+  if (result == SYNC_WAIT)
+  {
+    controllerScheduler.at(hvacJob, ac.msUntilSync());
+    return;
+  }
+  syncCycleUs += micros() - stepStart;
+  if (result == SYNC_BUSY)
+  {
+    // Commands and raw frames get their turn between two exchanges
+    controllerScheduler.at(hvacJob, HP_SYNC_STEP_INTERVAL_MS);
+    return;
+  }
+  if (result == SYNC_GUARD)
+  {
+    // Quiet line before or after the cycle, see DaikinController::syncStep
+    controllerScheduler.at(hvacJob, SYNC_LINE_GUARD_MS);
+    return;
+  }
+
+  metrics.syncCycle(syncCycleUs);
+  syncCycleUs = 0;
+  if (result == SYNC_DONE)
+  {
+    // HA discovery is sent by the loop task once it sees this in the snapshot
+    hpSynced = true;
+    ac.readState();
+    hpCheckCommandConfirmed(true);
+    LOGD(TAG, "PSRAM size:\t%u", (unsigned)ESP.getPsramSize());
+    LOGD(TAG, "PSRAM Free:\t%u", (unsigned)ESP.getFreePsram());
+    LOGD(TAG, "Heap left:\t%u", (unsigned)esp_get_free_heap_size());
+    LOGD(TAG, "Free Stack Space:\t%u", (unsigned)uxTaskGetStackHighWaterMark(NULL));
+  }
+  controllerScheduler.at(hvacJob, ac.msUntilSync());
+}
+
+void mqttStep()
+{
+  resetReport.stage(STAGE_MQTT);
+  if (mqttConnectRequested)
+  {
+    mqttConnectRequested = false;
+    scheduler.at(mqttConnectJob, 0);
+  }
+  {
+    PROFILE_SCOPE(PROF_MQTT_PUBLISH);
+    controllerResultsStep();
+  }
+  ControllerSnapshot snapshot = controllerSnapshot.read();
+  int state = mqtt_client.state();
+  // Keep sampling while offline, hpStatusChanged buffers into stateHistory
+  if (state < MQTT_CONNECTED)
+  {
+    PROFILE_SCOPE(PROF_MQTT_PUBLISH);
+    hpStatusChanged(snapshot);
+  }
+  // MQTT connected send status, on a config problem (state > MQTT_CONNECTED) do nothing
+  else if (state == MQTT_CONNECTED)
+  {
+    if (firstSync && snapshot.synced)
     {
-      // MQTT failed retry to connect
-      if (mqtt_client.state() < MQTT_CONNECTED)
-      {
+      onFirstSyncSuccess();
+    }
+    {
+      PROFILE_SCOPE(PROF_MQTT_PUBLISH);
+      replayStateHistory();
+      hpStatusChanged(snapshot);
+    }
+    PROFILE_SCOPE(PROF_MQTT_LOOP);
+    mqtt_client.loop();
+  }
+}
 
-        if ((millis() - lastMqttRetry > MQTT_RETRY_INTERVAL_MS) || lastMqttRetry == 0)
-        {
-          mqttConnect();
-        }
-      }
-      // MQTT config problem on MQTT do nothing
-      else if (mqtt_client.state() > MQTT_CONNECTED)
-        return;
-      // MQTT connected send status
-      else
-      {
-        mqttOK = true;
-        hpStatusChanged(ac.getStatus());
-        mqtt_client.loop();
-      }
+// Publish what the controller task queued. Results that find the broker down are dropped, like
+// they were when published straight away.
+void controllerResultsStep()
+{
+  static ControllerResult result; // loop task only, kept off its stack
+  while (xQueueReceive(controllerResults, &result, 0) == pdTRUE)
+  {
+    const String *topic = &ha_command_ack_topic;
+    if (result.topic == RESULT_S21EXP)
+      topic = &ha_custom_query_experimental_response;
+    else if (result.topic == RESULT_SERIAL_RECV)
+      topic = &ha_serial_recv_topic;
+    if (!mqtt_client.publish(topic->c_str(), result.payload, false))
+    {
+      if (_debugMode && mqtt_client.connected())
+        mqtt_client.publishUncounted(ha_debug_topic.c_str(), (char *)("Failed to publish controller result"));
     }
   }
-  else
+}
+
+void mqttConnectStep()
+{
+  if (mqtt_client.state() < MQTT_CONNECTED)
   {
-    dnsServer.processNextRequest();
+    resetReport.stage(STAGE_MQTT);
+    PROFILE_SCOPE(PROF_MQTT_CONNECT);
+    mqttConnect();
   }
+}
 
-    //Handle ACT LED
-  if (!mqttOK && mqtt_config ){
-    digitalWrite(LED_ACT,HIGH);
-  }else{
-    digitalWrite(LED_ACT,LOW);
+// Section latencies for dashboards without a Prometheus scraper
+void profilePublishStep()
+{
+  if (!mqtt_client.connected())
+    return;
+  char payload[PROFILE_JSON_SIZE];
+  if (profiler.writeJson(payload, sizeof(payload)) == 0)
+    return;
+  if (!mqtt_client.publish(ha_profile_topic.c_str(), payload, false))
+  {
+    if (_debugMode)
+      mqtt_client.publishUncounted(ha_debug_topic.c_str(), (char *)("Failed to publish profile"));
   }
+}
 
+void ledStep()
+{
+  if (!captive)
+  {
+    digitalWrite(LED_PWR, controllerSnapshot.read().connected ? (ledEnabled ? HIGH : LOW) : millis() / 1000 % 2);
+  }
+  // Lit while MQTT is set up but not connected, unless a short press is being answered
+  if (blinksLeft == 0)
+  {
+    digitalWrite(LED_ACT, mqtt_config && !mqtt_client.connected() ? HIGH : LOW);
+  }
+}
+
+void blinkStep()
+{
+  if (blinksLeft == 0)
+    return;
+  digitalWrite(LED_ACT, blinksLeft % 2 == 0 ? HIGH : LOW);
+  if (--blinksLeft > 0)
+    scheduler.at(blinkJob, 200);
+}
+
+// Runs the loop jobs that are due, returns the milliseconds until the next one. Also called by the
+// benchmarks, which need the jobs running before setup() returns.
+uint32_t loopPass()
+{
+  resetReport.stage(STAGE_LOOP);
+
+  unsigned long passStart = micros();
+  uint32_t idleMs = scheduler.run();
+  mqttState = mqtt_client.state();
+  unsigned long passUs = micros() - passStart;
+  metrics.loopIteration(passUs);
+  resetReport.loopIteration(passUs);
+  return idleMs;
+}
+
+void loop()
+{
+  esp_task_wdt_reset();
+  uint32_t idleMs = loopPass();
 
-  handleButton();
+  // Sleep until the next job is due, the unit is not waiting on us anymore
+  vTaskDelay(max(pdMS_TO_TICKS(idleMs), (TickType_t)1));
 }
\ No newline at end of file
@@ -0,0 +1,249 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "metrics.h"
+
+Metrics metrics;
+
+void Histogram::observe(uint32_t us)
+{
+  // Index of the smallest power of two >= us, relative to the first bucket
+  int log2 = us <= 1 ? 0 : 32 - __builtin_clz(us - 1);
+  int index = log2 - METRICS_FIRST_BUCKET_LOG2;
+  if (index < 0)
+    index = 0;
+  if (index >= METRICS_BUCKETS)
+    index = METRICS_BUCKETS - 1;
+  buckets[index]++;
+  count++;
+  sumUs += us;
+}
+
+void Metrics::uartExchange(const char *command, uint32_t us, bool ok, bool timeout)
+{
+  portENTER_CRITICAL(&lock);
+  UartCommandMetrics *slot = nullptr;
+  for (uint8_t i = 0; i < uartCount; i++)
+  {
+    if (strcmp(uart[i].command, command) == 0)
+    {
+      slot = &uart[i];
+      break;
+    }
+  }
+  if (slot == nullptr && uartCount < METRICS_UART_COMMANDS)
+  {
+    slot = &uart[uartCount++];
+    strlcpy(slot->command, command, sizeof(slot->command));
+  }
+  if (slot == nullptr)
+  {
+    uartUntracked++;
+  }
+  else if (timeout)
+  {
+    slot->timeouts++;
+  }
+  else
+  {
+    if (!ok)
+      slot->errors++;
+    slot->roundTrip.observe(us);
+  }
+  portEXIT_CRITICAL(&lock);
+}
+
+void Metrics::syncCycle(uint32_t us)
+{
+  portENTER_CRITICAL(&lock);
+  sync.observe(us);
+  portEXIT_CRITICAL(&lock);
+}
+
+void Metrics::loopIteration(uint32_t us)
+{
+  portENTER_CRITICAL(&lock);
+  loop.observe(us);
+  portEXIT_CRITICAL(&lock);
+}
+
+void Metrics::mqttPublish(bool ok)
+{
+  portENTER_CRITICAL(&lock);
+  if (ok)
+    mqttPublished++;
+  else
+    mqttFailed++;
+  portEXIT_CRITICAL(&lock);
+}
+
+void Metrics::mqttConnected()
+{
+  portENTER_CRITICAL(&lock);
+  mqttConnects++;
+  portEXIT_CRITICAL(&lock);
+}
+
+void Metrics::logServed(uint32_t bytes)
+{
+  portENTER_CRITICAL(&lock);
+  logBytesServed += bytes;
+  portEXIT_CRITICAL(&lock);
+}
+
+// Label value as the exposition format wants it. S21 command names are raw frame bytes, anything
+// unprintable is spelled out as \\xNN so distinct commands keep distinct labels.
+static void labelValue(const char *value, char *out, size_t size)
+{
+  size_t len = 0;
+  for (; *value && len + 5 < size; value++)
+  {
+    uint8_t c = (uint8_t)*value;
+    if (c == '\\' || c == '"')
+    {
+      out[len++] = '\\';
+      out[len++] = c;
+    }
+    else if (c == '\n')
+    {
+      out[len++] = '\\';
+      out[len++] = 'n';
+    }
+    else if (c < 0x20 || c > 0x7e)
+    {
+      len += snprintf(out + len, size - len, "\\\\x%02x", c);
+    }
+    else
+    {
+      out[len++] = c;
+    }
+  }
+  out[len] = '\0';
+}
+
+void Metrics::write(HtmlWriter &out)
+{
+  // Copied out one piece at a time, the lock is never held while writing to the socket
+  UartCommandMetrics command;
+  uint8_t count;
+  portENTER_CRITICAL(&lock);
+  count = uartCount;
+  portEXIT_CRITICAL(&lock);
+
+  // Escaped once, the name of a table entry never changes after it was added
+  char names[METRICS_UART_COMMANDS][sizeof(command.command) * 5];
+  for (uint8_t i = 0; i < count; i++)
+    labelValue(uart[i].command, names[i], sizeof(names[i]));
+
+  char labels[40];
+  writeHelp(out, "dk2mqtt_uart_roundtrip_seconds", "histogram", "Time from sending a command to the end of its answer");
+  for (uint8_t i = 0; i < count; i++)
+  {
+    portENTER_CRITICAL(&lock);
+    command = uart[i];
+    portEXIT_CRITICAL(&lock);
+    snprintf(labels, sizeof(labels), "command=\"%s\"", names[i]);
+    writeHistogram(out, "dk2mqtt_uart_roundtrip_seconds", labels, command.roundTrip);
+  }
+  writeHelp(out, "dk2mqtt_uart_timeouts_total", "counter", "Commands the unit did not answer");
+  char line[96];
+  for (uint8_t i = 0; i < count; i++)
+  {
+    portENTER_CRITICAL(&lock);
+    uint32_t timeouts = uart[i].timeouts;
+    portEXIT_CRITICAL(&lock);
+    out.write(line, snprintf(line, sizeof(line), "dk2mqtt_uart_timeouts_total{command=\"%s\"} %u\n", names[i], timeouts));
+  }
+  writeHelp(out, "dk2mqtt_uart_errors_total", "counter", "Commands answered with a NAK or a malformed frame");
+  for (uint8_t i = 0; i < count; i++)
+  {
+    portENTER_CRITICAL(&lock);
+    uint32_t errors = uart[i].errors;
+    portEXIT_CRITICAL(&lock);
+    out.write(line, snprintf(line, sizeof(line), "dk2mqtt_uart_errors_total{command=\"%s\"} %u\n", names[i], errors));
+  }
+
+  Histogram histogram;
+  portENTER_CRITICAL(&lock);
+  histogram = sync;
+  portEXIT_CRITICAL(&lock);
+  writeHelp(out, "dk2mqtt_sync_seconds", "histogram", "Duration of a full controller sync");
+  writeHistogram(out, "dk2mqtt_sync_seconds", "", histogram);
+
+  portENTER_CRITICAL(&lock);
+  histogram = loop;
+  portEXIT_CRITICAL(&lock);
+  writeHelp(out, "dk2mqtt_loop_seconds", "histogram", "Time a loop() pass spent running the jobs due");
+  writeHistogram(out, "dk2mqtt_loop_seconds", "", histogram);
+
+  portENTER_CRITICAL(&lock);
+  uint32_t published = mqttPublished, failed = mqttFailed, connects = mqttConnects, untracked = uartUntracked;
+  uint32_t logBytes = logBytesServed;
+  portEXIT_CRITICAL(&lock);
+  writeCounter(out, "dk2mqtt_uart_untracked_total", "Exchanges for commands beyond the per-command table", untracked);
+  writeCounter(out, "dk2mqtt_mqtt_published_total", "MQTT messages accepted by the client", published);
+  writeCounter(out, "dk2mqtt_mqtt_publish_failed_total", "MQTT publishes that failed", failed);
+  writeCounter(out, "dk2mqtt_mqtt_connects_total", "Successful MQTT connections", connects);
+  writeCounter(out, "dk2mqtt_log_served_bytes_total", "Log text sent by /api/logs", logBytes);
+}
+
+void Metrics::writeGauge(HtmlWriter &out, const char *name, const char *help, double value)
+{
+  char line[64];
+  writeHelp(out, name, "gauge", help);
+  out.write(line, snprintf(line, sizeof(line), "%s %.6g\n", name, value));
+}
+
+void Metrics::writeCounter(HtmlWriter &out, const char *name, const char *help, uint32_t value)
+{
+  char line[64];
+  writeHelp(out, name, "counter", help);
+  out.write(line, snprintf(line, sizeof(line), "%s %u\n", name, value));
+}
+
+void Metrics::writeHelp(HtmlWriter &out, const char *name, const char *type, const char *help)
+{
+  out.print("# HELP ");
+  out.print(name);
+  out.print(" ");
+  out.print(help);
+  out.print("\n# TYPE ");
+  out.print(name);
+  out.print(" ");
+  out.print(type);
+  out.print("\n");
+}
+
+void Metrics::writeHistogram(HtmlWriter &out, const char *name, const char *labels, const Histogram &histogram)
+{
+  char line[128];
+  const char *separator = labels[0] ? "," : "";
+  uint32_t cumulative = 0;
+  for (int i = 0; i < METRICS_BUCKETS; i++)
+  {
+    cumulative += histogram.buckets[i];
+    if (i == METRICS_BUCKETS - 1)
+      out.write(line, snprintf(line, sizeof(line), "%s_bucket{%s%sle=\"+Inf\"} %u\n", name, labels, separator, cumulative));
+    else
+      out.write(line, snprintf(line, sizeof(line), "%s_bucket{%s%sle=\"%.6f\"} %u\n", name, labels, separator,
+                               (1UL << (METRICS_FIRST_BUCKET_LOG2 + i)) / 1e6, cumulative));
+  }
+  const char *open = labels[0] ? "{" : "";
+  const char *close = labels[0] ? "}" : "";
+  out.write(line, snprintf(line, sizeof(line), "%s_sum%s%s%s %.6f\n", name, open, labels, close, histogram.sumUs / 1e6));
+  out.write(line, snprintf(line, sizeof(line), "%s_count%s%s%s %u\n", name, open, labels, close, histogram.count));
+}
@@ -0,0 +1,82 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include "html_template.h"
+
+// Histogram bucket upper bounds are powers of two microseconds: 2^7 (128 us) .. 2^23 (8.4 s), then +Inf.
+#define METRICS_FIRST_BUCKET_LOG2 7
+#define METRICS_BUCKETS 18
+
+// Distinct UART commands tracked, S21 queries and sets plus X50 commands fit with room to spare.
+#define METRICS_UART_COMMANDS 24
+
+struct Histogram
+{
+  uint32_t buckets[METRICS_BUCKETS]; // per bucket, made cumulative when written out
+  uint32_t count;
+  uint64_t sumUs;
+
+  void observe(uint32_t us);
+};
+
+struct UartCommandMetrics
+{
+  char command[4]; // "F1", "RH" for S21, hex "CA" for X50, "raw" for passthrough
+  uint32_t timeouts;
+  uint32_t errors; // NAK or malformed answer
+  Histogram roundTrip;
+};
+
+// Counters and histograms for /metrics. Recorded from the controller task (UART) and the loop task
+// (MQTT) and read by the web task, each update and each copy for output is done under a spinlock.
+class Metrics
+{
+public:
+  void uartExchange(const char *command, uint32_t us, bool ok, bool timeout);
+  void syncCycle(uint32_t us);
+  void loopIteration(uint32_t us);
+  void mqttPublish(bool ok);
+  void mqttConnected();
+  void logServed(uint32_t bytes);
+
+  // Prometheus text exposition of everything above.
+  void write(HtmlWriter &out);
+  // Single sample lines, for the gauges the caller reads itself.
+  static void writeGauge(HtmlWriter &out, const char *name, const char *help, double value);
+  static void writeCounter(HtmlWriter &out, const char *name, const char *help, uint32_t value);
+  // The HELP and TYPE lines, for callers writing labelled samples themselves.
+  static void writeHelp(HtmlWriter &out, const char *name, const char *type, const char *help);
+
+private:
+  portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+  UartCommandMetrics uart[METRICS_UART_COMMANDS] = {};
+  uint8_t uartCount = 0;
+  uint32_t uartUntracked = 0; // exchanges for commands that did not fit the table
+  Histogram sync = {};
+  Histogram loop = {};
+  uint32_t mqttPublished = 0;
+  uint32_t mqttFailed = 0;
+  uint32_t mqttConnects = 0;
+  uint32_t logBytesServed = 0; // /api/logs body bytes, as streamed
+
+  static void writeHistogram(HtmlWriter &out, const char *name, const char *labels, const Histogram &histogram);
+};
+
+extern Metrics metrics;
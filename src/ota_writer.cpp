@@ -0,0 +1,181 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "ota_writer.h"
+#include "logger.h"
+
+#define TAG "ota"
+
+bool OtaWriter::begin(size_t maxSize)
+{
+  if (running)
+    abort();
+  if (!Update.begin(maxSize))
+    return false;
+
+  if (task == nullptr)
+  {
+    filled = xQueueCreate(2, sizeof(Block));
+    empty = xQueueCreate(2, sizeof(uint8_t));
+    // Above the web task on the same core, a filled buffer is flashed as soon as it is handed over
+    // while lwIP keeps receiving into the TCP window.
+    xTaskCreatePinnedToCore(writerTask, "otaWriter", 4096, this, 2, &task, 0);
+  }
+  buffers[0] = (uint8_t *)malloc(OTA_BUFFER_SIZE);
+  buffers[1] = (uint8_t *)malloc(OTA_BUFFER_SIZE);
+  if (buffers[0] == nullptr || buffers[1] == nullptr)
+  {
+    release();
+    Update.abort();
+    return false;
+  }
+
+  xQueueReset(filled);
+  xQueueReset(empty);
+  uint8_t second = 1;
+  xQueueSend(empty, &second, 0);
+  current = 0;
+  holding = true;
+  fillLen = 0;
+  failed = false;
+  mismatch = false;
+  digestHex[0] = '\0';
+  counters = {};
+  mbedtls_sha256_init(&sha);
+  mbedtls_sha256_starts_ret(&sha, 0);
+  running = true;
+  tBegin = micros();
+  return true;
+}
+
+bool OtaWriter::write(const uint8_t *data, size_t len)
+{
+  while (len > 0)
+  {
+    if (failed)
+      return false;
+    size_t chunk = min(len, (size_t)(OTA_BUFFER_SIZE - fillLen));
+    memcpy(buffers[current] + fillLen, data, chunk);
+    fillLen += chunk;
+    data += chunk;
+    len -= chunk;
+    counters.bytes += chunk;
+    if (fillLen == OTA_BUFFER_SIZE)
+      submit(true);
+  }
+  return !failed;
+}
+
+bool OtaWriter::end(const char *expectedSha256)
+{
+  if (!running)
+    return false;
+  if (fillLen > 0)
+    submit(false);
+  drain();
+  counters.elapsedUs = micros() - tBegin;
+
+  uint8_t digest[32];
+  mbedtls_sha256_finish_ret(&sha, digest);
+  mbedtls_sha256_free(&sha);
+  for (int i = 0; i < 32; i++)
+    snprintf(digestHex + i * 2, 3, "%02x", digest[i]);
+  release();
+
+  if (failed)
+  {
+    Update.abort();
+    return false;
+  }
+  // Checked before Update.end(), which would make the new image the boot partition
+  if (expectedSha256 != nullptr && expectedSha256[0] && strcasecmp(expectedSha256, digestHex) != 0)
+  {
+    mismatch = true;
+    Update.abort();
+    LOGE(TAG, "SHA-256 mismatch, got %s", digestHex);
+    return false;
+  }
+
+  unsigned long elapsedMs = counters.elapsedUs / 1000;
+  Log.ln(TAG, "%u bytes in %lu ms (%lu KB/s), stalled %lu ms, flash %lu ms, sha256 %s",
+         counters.bytes, elapsedMs, elapsedMs ? counters.bytes / elapsedMs : 0,
+         counters.stallUs / 1000, counters.flashUs / 1000, digestHex);
+  return Update.end(true);
+}
+
+void OtaWriter::abort()
+{
+  if (!running)
+    return;
+  // The writer may still be inside Update.write(), let it finish before pulling the rug
+  failed = true;
+  drain();
+  mbedtls_sha256_free(&sha);
+  release();
+  Update.abort();
+}
+
+void OtaWriter::submit(bool takeNext)
+{
+  Block block = {current, fillLen};
+  xQueueSend(filled, &block, portMAX_DELAY);
+  holding = false;
+  fillLen = 0;
+  if (takeNext)
+  {
+    unsigned long tStart = micros();
+    xQueueReceive(empty, &current, portMAX_DELAY);
+    counters.stallUs += micros() - tStart;
+    holding = true;
+  }
+}
+
+// Wait until the writer has handed back every buffer that is not held by write().
+void OtaWriter::drain()
+{
+  uint8_t index;
+  for (int i = holding ? 1 : 0; i < 2; i++)
+    xQueueReceive(empty, &index, portMAX_DELAY);
+}
+
+void OtaWriter::release()
+{
+  free(buffers[0]);
+  free(buffers[1]);
+  buffers[0] = buffers[1] = nullptr;
+  running = false;
+}
+
+void OtaWriter::writerTask(void *parameter)
+{
+  OtaWriter *writer = (OtaWriter *)parameter;
+  Block block;
+  for (;;)
+  {
+    xQueueReceive(writer->filled, &block, portMAX_DELAY);
+    if (!writer->failed)
+    {
+      unsigned long tStart = micros();
+      uint8_t *data = writer->buffers[block.index];
+      if (Update.write(data, block.len) != block.len)
+        writer->failed = true;
+      mbedtls_sha256_update_ret(&writer->sha, data, block.len);
+      writer->counters.flashUs += micros() - tStart;
+    }
+    xQueueSend(writer->empty, &block.index, portMAX_DELAY);
+  }
+}
@@ -0,0 +1,77 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include <Update.h>
+#include "mbedtls/sha256.h"
+
+// One flash sector, Update erases and writes in sectors anyway
+#define OTA_BUFFER_SIZE 4096
+
+struct OtaStats
+{
+  uint32_t bytes;
+  unsigned long elapsedUs; // begin() to end()
+  unsigned long stallUs;   // time write() waited for the flash writer to free a buffer
+  unsigned long flashUs;   // time spent in Update.write() and hashing
+};
+
+// Firmware upload pipeline: write() fills one buffer while a writer task puts the other one into
+// flash and the SHA-256, so receiving and flashing overlap instead of taking turns.
+// begin/write/end/abort are called from one task (the web task, via handleUploadLoop).
+class OtaWriter
+{
+public:
+  bool begin(size_t maxSize);
+  bool write(const uint8_t *data, size_t len);
+  // Flushes and waits for the writer. If expectedSha256 (hex) is given and does not match, the
+  // image is discarded and shaMismatch() is set. Otherwise the image is finalised with Update.end().
+  bool end(const char *expectedSha256);
+  void abort();
+  bool shaMismatch() const { return mismatch; }
+  const char *sha256() const { return digestHex; } // valid after end()
+  const OtaStats &stats() const { return counters; }
+
+private:
+  struct Block
+  {
+    uint8_t index;
+    uint16_t len;
+  };
+
+  uint8_t *buffers[2] = {nullptr, nullptr};
+  uint8_t current = 0;
+  uint16_t fillLen = 0;
+  bool holding = false; // buffers[current] belongs to write(), not to the queues
+  bool running = false;
+  volatile bool failed = false;
+  bool mismatch = false;
+  char digestHex[65] = "";
+  unsigned long tBegin = 0;
+  OtaStats counters = {};
+  mbedtls_sha256_context sha;
+  QueueHandle_t filled = nullptr; // Block, to the writer task
+  QueueHandle_t empty = nullptr;  // buffer index, back from the writer task
+  TaskHandle_t task = nullptr;
+
+  static void writerTask(void *parameter);
+  void submit(bool takeNext);
+  void drain();
+  void release();
+};
@@ -0,0 +1,92 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "power_save.h"
+#include <WiFi.h>
+#include "esp_freertos_hooks.h"
+#include "logger.h"
+#include "metrics.h"
+
+#define TAG "power"
+
+PowerSave powerSave;
+
+// Written by each core's own tick interrupt only
+static DRAM_ATTR TaskHandle_t idleTasks[POWER_CORES];
+static volatile DRAM_ATTR uint32_t busyTicks[POWER_CORES];
+
+// A tick that finds anything but the idle task running counts as busy.
+static void IRAM_ATTR countBusyTick()
+{
+  BaseType_t core = xPortGetCoreID();
+  if (xTaskGetCurrentTaskHandleForCPU(core) != idleTasks[core])
+    busyTicks[core]++;
+}
+
+void PowerSave::begin()
+{
+  startTick = windowTick = xTaskGetTickCount();
+  for (uint8_t core = 0; core < POWER_CORES; core++)
+  {
+    idleTasks[core] = xTaskGetIdleTaskHandleForCPU(core);
+    esp_register_freertos_tick_hook_for_cpu(countBusyTick, core);
+  }
+}
+
+void PowerSave::enable()
+{
+  on = true;
+  // The station wakes for every few DTIM beacons only, the AP buffers what arrives meanwhile
+  WiFi.setSleep(WIFI_PS_MAX_MODEM);
+  Log.ln(TAG, "Modem sleep enabled");
+}
+
+void PowerSave::disable()
+{
+  WiFi.setSleep(WIFI_PS_MIN_MODEM);
+  on = false;
+}
+
+void PowerSave::sample()
+{
+  TickType_t now = xTaskGetTickCount();
+  uint32_t elapsed = now - windowTick;
+  if (elapsed == 0)
+    return;
+  for (uint8_t core = 0; core < POWER_CORES; core++)
+  {
+    uint32_t busy = busyTicks[core];
+    uint32_t windowBusyTicks = busy - windowBusy[core];
+    windowBusy[core] = busy;
+    windowIdle[core] = windowBusyTicks >= elapsed ? 0 : 100.0f * (elapsed - windowBusyTicks) / elapsed;
+  }
+  windowTick = now;
+}
+
+void PowerSave::write(HtmlWriter &out)
+{
+  char line[80];
+  uint32_t elapsed = xTaskGetTickCount() - startTick;
+  Metrics::writeHelp(out, "dk2mqtt_cpu_idle_seconds_total", "counter", "Time each core spent in its idle task, sampled every tick");
+  for (uint8_t core = 0; core < POWER_CORES; core++)
+  {
+    uint32_t busy = min((uint32_t)busyTicks[core], elapsed);
+    out.write(line, snprintf(line, sizeof(line), "dk2mqtt_cpu_idle_seconds_total{core=\"%u\"} %.3f\n", core,
+                             (float)(elapsed - busy) / configTICK_RATE_HZ));
+  }
+  Metrics::writeGauge(out, "dk2mqtt_power_save", "1 while WiFi modem sleep and the longer polls are on", on ? 1 : 0);
+}
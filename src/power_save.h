@@ -0,0 +1,53 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include "html_template.h"
+
+#define POWER_CORES 2
+
+// CPU idle share of each core, sampled from the tick interrupt, and the power save mode: WiFi
+// modem sleep, the station wakes for every few DTIM beacons only. Automatic light sleep needs a
+// framework built with power management and tickless idle, which the Arduino libraries are not.
+// The longer poll intervals that go with the mode are the caller's, see setPowerSave().
+class PowerSave
+{
+public:
+  // Starts sampling the idle share, power save on or not.
+  void begin();
+  void enable();
+  void disable();
+  bool enabled() const { return on; }
+
+  // Ends a measurement window, called every POWER_SAMPLE_INTERVAL_MS by a loop job.
+  void sample();
+  // Idle share of a core over the last window, 0 to 100.
+  float idlePercent(uint8_t core) const { return core < POWER_CORES ? windowIdle[core] : 0; }
+  // Prometheus idle time counters per core and the power save state.
+  void write(HtmlWriter &out);
+
+private:
+  bool on = false;
+  TickType_t startTick = 0;
+  TickType_t windowTick = 0;
+  uint32_t windowBusy[POWER_CORES] = {};
+  float windowIdle[POWER_CORES] = {};
+};
+
+extern PowerSave powerSave;
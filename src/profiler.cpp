@@ -0,0 +1,132 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "profiler.h"
+#include "metrics.h"
+
+Profiler profiler;
+
+static const char *const sectionNames[PROF_COUNT] = {
+    "http", "events", "syslog", "mqtt_loop", "mqtt_connect", "mqtt_publish",
+    "button", "ota", "sync_step", "hvac_connect", "command"};
+
+const char *Profiler::name(uint8_t section)
+{
+  return section < PROF_COUNT ? sectionNames[section] : "";
+}
+
+void Profiler::record(ProfileSection section, uint32_t cycles)
+{
+  uint8_t index = bucket(cycles);
+  portENTER_CRITICAL(&lock);
+  Section &s = sections[section];
+  s.buckets[index]++;
+  s.count++;
+  s.sumCycles += cycles;
+  if (cycles > s.maxCycles)
+    s.maxCycles = cycles;
+  portEXIT_CRITICAL(&lock);
+}
+
+ProfileStats Profiler::stats(ProfileSection section)
+{
+  // Copied out so the percentiles are computed without holding the lock
+  Section copy;
+  ProfileStats stats;
+  float cyclesPerUs = ESP.getCpuFreqMHz();
+  portENTER_CRITICAL(&lock);
+  copy = sections[section];
+  portEXIT_CRITICAL(&lock);
+  stats.count = copy.count;
+  stats.sumUs = copy.sumCycles / cyclesPerUs;
+  stats.p50Us = percentile(copy, 0.5f) / cyclesPerUs;
+  stats.p99Us = percentile(copy, 0.99f) / cyclesPerUs;
+  stats.maxUs = copy.maxCycles / cyclesPerUs;
+  return stats;
+}
+
+void Profiler::write(HtmlWriter &out)
+{
+  char line[128];
+  ProfileStats all[PROF_COUNT];
+  for (uint8_t i = 0; i < PROF_COUNT; i++)
+    all[i] = stats((ProfileSection)i);
+
+  Metrics::writeHelp(out, "dk2mqtt_section_seconds", "summary", "Time spent in each profiled section");
+  for (uint8_t i = 0; i < PROF_COUNT; i++)
+  {
+    out.write(line, snprintf(line, sizeof(line), "dk2mqtt_section_seconds{section=\"%s\",quantile=\"0.5\"} %.6g\n", name(i), all[i].p50Us / 1e6));
+    out.write(line, snprintf(line, sizeof(line), "dk2mqtt_section_seconds{section=\"%s\",quantile=\"0.99\"} %.6g\n", name(i), all[i].p99Us / 1e6));
+    out.write(line, snprintf(line, sizeof(line), "dk2mqtt_section_seconds_sum{section=\"%s\"} %.6g\n", name(i), all[i].sumUs / 1e6));
+    out.write(line, snprintf(line, sizeof(line), "dk2mqtt_section_seconds_count{section=\"%s\"} %u\n", name(i), all[i].count));
+  }
+  Metrics::writeHelp(out, "dk2mqtt_section_max_seconds", "gauge", "Longest run of each profiled section since boot");
+  for (uint8_t i = 0; i < PROF_COUNT; i++)
+    out.write(line, snprintf(line, sizeof(line), "dk2mqtt_section_max_seconds{section=\"%s\"} %.6g\n", name(i), all[i].maxUs / 1e6));
+}
+
+size_t Profiler::writeJson(char *out, size_t size)
+{
+  size_t len = 0;
+  for (uint8_t i = 0; i < PROF_COUNT; i++)
+  {
+    ProfileStats s = stats((ProfileSection)i);
+    int written = snprintf(out + len, size - len, "%s\"%s\":{\"n\":%u,\"p50Us\":%.1f,\"p99Us\":%.1f,\"maxUs\":%.1f}",
+                           i == 0 ? "{" : ",", name(i), s.count, s.p50Us, s.p99Us, s.maxUs);
+    if (written < 0 || len + written >= size)
+      return 0;
+    len += written;
+  }
+  if (len + 2 > size)
+    return 0;
+  out[len++] = '}';
+  out[len] = '\0';
+  return len;
+}
+
+uint8_t Profiler::bucket(uint32_t cycles)
+{
+  if (cycles < (1UL << PROFILE_FIRST_LOG2))
+    return 0;
+  // Octave from the top bit, then the two bits below it pick the quarter
+  int log2 = 31 - __builtin_clz(cycles);
+  uint32_t quarter = (cycles >> (log2 - 2)) & (PROFILE_SUB_BUCKETS - 1);
+  return (log2 - PROFILE_FIRST_LOG2) * PROFILE_SUB_BUCKETS + quarter;
+}
+
+uint32_t Profiler::bucketUpper(uint8_t index)
+{
+  uint32_t octave = 1UL << (PROFILE_FIRST_LOG2 + index / PROFILE_SUB_BUCKETS);
+  // The last bucket ends at the wrap of the counter
+  uint64_t upper = (uint64_t)octave * (PROFILE_SUB_BUCKETS + 1 + index % PROFILE_SUB_BUCKETS) / PROFILE_SUB_BUCKETS;
+  return upper > UINT32_MAX ? UINT32_MAX : (uint32_t)upper;
+}
+
+float Profiler::percentile(const Section &section, float quantile)
+{
+  if (section.count == 0)
+    return 0;
+  uint32_t rank = (uint32_t)ceilf(quantile * section.count);
+  uint32_t cumulative = 0;
+  for (uint8_t i = 0; i < PROFILE_BUCKETS; i++)
+  {
+    cumulative += section.buckets[i];
+    if (cumulative >= rank)
+      return min(bucketUpper(i), section.maxCycles);
+  }
+  return section.maxCycles;
+}
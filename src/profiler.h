@@ -0,0 +1,107 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include "html_template.h"
+
+// Each power of two cycles is split in PROFILE_SUB_BUCKETS, so a percentile read back is at most
+// 19% above the real one. Buckets go from 2^PROFILE_FIRST_LOG2 cycles (about 0.3 us at 240 MHz)
+// to the wrap of the 32 bit cycle counter (about 18 s).
+#define PROFILE_FIRST_LOG2 6
+#define PROFILE_SUB_BUCKETS 4
+#define PROFILE_BUCKETS ((32 - PROFILE_FIRST_LOG2) * PROFILE_SUB_BUCKETS)
+// Every section in the MQTT profile document
+#define PROFILE_JSON_SIZE 1024
+
+// Instrumented parts of the firmware, named as in /metrics and on the profile topic.
+enum ProfileSection : uint8_t
+{
+  PROF_HTTP,          // server.handleClient(), web task
+  PROF_EVENTS,        // eventStreamStep(), web task
+  PROF_SYSLOG,        // syslogSink.step(), web task
+  PROF_MQTT_LOOP,     // mqtt_client.loop() with the message callbacks, loop task
+  PROF_MQTT_CONNECT,  // mqttConnect(), loop task
+  PROF_MQTT_PUBLISH,  // state and controller results publishing, loop task
+  PROF_BUTTON,        // handleButton(), loop task
+  PROF_OTA,           // ArduinoOTA.handle(), loop task
+  PROF_SYNC_STEP,     // ac.syncStep(), one UART exchange, controller task
+  PROF_HVAC_CONNECT,  // ac.connect(), controller task
+  PROF_COMMAND,       // a posted command applied to the unit, controller task
+  PROF_COUNT
+};
+
+// Times in microseconds, percentiles are the upper bound of the bucket they fall in.
+struct ProfileStats
+{
+  uint32_t count;
+  float sumUs;
+  float p50Us;
+  float p99Us;
+  float maxUs;
+};
+
+// Latency histograms of the sections above, since boot. Recording is a few dozen cycles plus a
+// spinlock, cheap enough to stay on in production. Each section is recorded by one task, the web
+// and loop tasks read them.
+class Profiler
+{
+public:
+  void record(ProfileSection section, uint32_t cycles);
+  ProfileStats stats(ProfileSection section);
+  static const char *name(uint8_t section);
+
+  // Prometheus summary (p50, p99, sum, count) plus the max of each section.
+  void write(HtmlWriter &out);
+  // {"http":{"n":12,"p50Us":80.5,"p99Us":1100,"maxUs":1520.3},...} for MQTT.
+  // Returns the length written, 0 if the buffer is too small.
+  size_t writeJson(char *out, size_t size);
+
+private:
+  struct Section
+  {
+    uint32_t buckets[PROFILE_BUCKETS];
+    uint32_t count;
+    uint32_t maxCycles;
+    uint64_t sumCycles;
+  };
+
+  portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+  Section sections[PROF_COUNT] = {};
+
+  static uint8_t bucket(uint32_t cycles);
+  static uint32_t bucketUpper(uint8_t index);
+  static float percentile(const Section &section, float quantile);
+};
+
+extern Profiler profiler;
+
+// Times the enclosing block with the CPU cycle counter. The tasks running the sections are pinned,
+// so both reads come from the same core's counter.
+class ProfileScope
+{
+public:
+  explicit ProfileScope(ProfileSection section) : section(section), start(ESP.getCycleCount()) {}
+  ~ProfileScope() { profiler.record(section, ESP.getCycleCount() - start); }
+
+private:
+  ProfileSection section;
+  uint32_t start;
+};
+
+#define PROFILE_SCOPE(section) ProfileScope profileScope(section)
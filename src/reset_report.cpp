@@ -0,0 +1,209 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "reset_report.h"
+#include "logger.h"
+
+#define RESET_MAGIC 0x52535431 // "RST1"
+// Lines of the crashed boot sent with the JSON, fewer when they do not fit
+#define RESET_LOG_LINES 16
+
+struct ResetMemory
+{
+  uint32_t magic;
+  ResetSnapshot current;
+  CrashRecord crash;
+};
+
+static ResetMemory memory __NOINIT_ATTR;
+
+ResetReport resetReport;
+
+void ResetReport::begin()
+{
+  resetReason = esp_reset_reason();
+  if (memory.magic != RESET_MAGIC || resetReason == ESP_RST_POWERON)
+  {
+    memset(&memory, 0, sizeof(memory));
+    memory.magic = RESET_MAGIC;
+  }
+  else if (resetReason == ESP_RST_PANIC || resetReason == ESP_RST_INT_WDT || resetReason == ESP_RST_TASK_WDT ||
+           resetReason == ESP_RST_WDT || resetReason == ESP_RST_BROWNOUT)
+  {
+    memory.crash.valid = true;
+    memory.crash.reason = resetReason;
+    memory.crash.bootsSince = 0;
+    memory.crash.logSeq = Log.bootStart();
+    memory.crash.snapshot = memory.current;
+    memory.crash.snapshot.uartCommand[sizeof(memory.crash.snapshot.uartCommand) - 1] = '\0';
+  }
+  else if (memory.crash.valid && memory.crash.bootsSince < UINT16_MAX)
+  {
+    memory.crash.bootsSince++;
+  }
+  memset(&memory.current, 0, sizeof(memory.current));
+  memory.current.stage = STAGE_BOOT;
+}
+
+void ResetReport::stage(ResetStage stage)
+{
+  memory.current.stage = stage;
+  memory.current.stageMs = millis();
+}
+
+void ResetReport::uartCommand(const char *command)
+{
+  // Custom packets can carry any byte, keep the name printable (it ends up in JSON)
+  size_t i = 0;
+  for (; i + 1 < sizeof(memory.current.uartCommand) && command[i]; i++)
+    memory.current.uartCommand[i] = isalnum((unsigned char)command[i]) ? command[i] : '?';
+  memory.current.uartCommand[i] = '\0';
+  memory.current.uartCommandMs = millis();
+}
+
+void ResetReport::loopIteration(uint32_t us)
+{
+  memory.current.loopMs = millis();
+  memory.current.loopUs = us;
+  if (us > memory.current.loopMaxUs)
+    memory.current.loopMaxUs = us;
+}
+
+const CrashRecord &ResetReport::lastCrash() const
+{
+  return memory.crash;
+}
+
+const char *ResetReport::reasonName(uint8_t reason)
+{
+  switch (reason)
+  {
+  case ESP_RST_POWERON:
+    return "power_on";
+  case ESP_RST_EXT:
+    return "external";
+  case ESP_RST_SW:
+    return "software";
+  case ESP_RST_PANIC:
+    return "panic";
+  case ESP_RST_INT_WDT:
+    return "int_wdt";
+  case ESP_RST_TASK_WDT:
+    return "task_wdt";
+  case ESP_RST_WDT:
+    return "wdt";
+  case ESP_RST_DEEPSLEEP:
+    return "deep_sleep";
+  case ESP_RST_BROWNOUT:
+    return "brownout";
+  case ESP_RST_SDIO:
+    return "sdio";
+  default:
+    return "unknown";
+  }
+}
+
+const char *ResetReport::stageName(uint8_t stage)
+{
+  static const char *const names[STAGE_COUNT] = {"boot", "loop", "hvac_command", "hvac_connect", "hvac_sync", "mqtt"};
+  return stage < STAGE_COUNT ? names[stage] : "unknown";
+}
+
+size_t ResetReport::describe(char *out, size_t size) const
+{
+  const CrashRecord &crash = memory.crash;
+  int len;
+  if (!crash.valid)
+  {
+    len = snprintf(out, size, "%s", reasonName(resetReason));
+  }
+  else
+  {
+    const ResetSnapshot &s = crash.snapshot;
+    len = snprintf(out, size, "%s; last crash %s %u reset(s) ago: last loop at %.1f s (%lu ms, max %lu ms), %s since %.1f s, UART %s sent at %.1f s",
+                   reasonName(resetReason), reasonName(crash.reason), (unsigned)crash.bootsSince + 1,
+                   s.loopMs / 1000.0, (unsigned long)(s.loopUs / 1000), (unsigned long)(s.loopMaxUs / 1000),
+                   stageName(s.stage), s.stageMs / 1000.0, s.uartCommand[0] ? s.uartCommand : "-", s.uartCommandMs / 1000.0);
+  }
+  if (len < 0 || size == 0)
+    return 0;
+  return min((size_t)len, size - 1);
+}
+
+// Appends text as the inside of a JSON string, stops before overflowing (keeping the closing quote's room).
+static size_t appendJsonText(char *out, size_t size, size_t len, const char *text, size_t textLen)
+{
+  for (size_t i = 0; i < textLen && len + 8 < size; i++)
+  {
+    char c = text[i];
+    if (c == '"' || c == '\\')
+    {
+      out[len++] = '\\';
+      out[len++] = c;
+    }
+    else if (c == '\n')
+    {
+      out[len++] = '\\';
+      out[len++] = 'n';
+    }
+    else if ((uint8_t)c < 0x20)
+    {
+      len += snprintf(out + len, size - len, "\\u%04x", (uint8_t)c);
+    }
+    else
+    {
+      out[len++] = c;
+    }
+  }
+  return len;
+}
+
+size_t ResetReport::writeJson(char *out, size_t size) const
+{
+  const CrashRecord &crash = memory.crash;
+  if (size < 32)
+    return 0;
+  size_t len = snprintf(out, size, "{\"reason\":\"%s\"", reasonName(resetReason));
+  if (crash.valid)
+  {
+    const ResetSnapshot &s = crash.snapshot;
+    len += snprintf(out + len, size - len,
+                    ",\"crash\":{\"reason\":\"%s\",\"resetsAgo\":%u,\"loopMs\":%lu,\"loopUs\":%lu,\"loopMaxUs\":%lu,"
+                    "\"stage\":\"%s\",\"stageMs\":%lu,\"uartCommand\":\"%s\",\"uartCommandMs\":%lu",
+                    reasonName(crash.reason), (unsigned)crash.bootsSince + 1, (unsigned long)s.loopMs, (unsigned long)s.loopUs,
+                    (unsigned long)s.loopMaxUs, stageName(s.stage), (unsigned long)s.stageMs, s.uartCommand, (unsigned long)s.uartCommandMs);
+    if (len + 16 >= size)
+      return 0;
+
+    // The last lines that still fit, fewer lines when they are long
+    char text[RESET_JSON_SIZE / 2];
+    size_t textLen = 0;
+    for (uint32_t lines = min((uint32_t)RESET_LOG_LINES, crash.logSeq); lines > 0; lines /= 2)
+    {
+      uint32_t from = crash.logSeq - lines;
+      textLen = Log.read(from, crash.logSeq, text, sizeof(text));
+      if (from == crash.logSeq)
+        break;
+      textLen = 0;
+    }
+    len += snprintf(out + len, size - len, ",\"log\":\"");
+    len = appendJsonText(out, size, len, text, textLen);
+    len += snprintf(out + len, size - len, "\"}");
+  }
+  len += snprintf(out + len, size - len, "}");
+  return len;
+}
@@ -0,0 +1,88 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include <esp_system.h>
+
+// Enough for the crash description plus the last lines logged before it.
+#define RESET_JSON_SIZE 2048
+
+// What the loop or controller task was busy with, so a watchdog reset can be pinned on a part of
+// the firmware. Both tasks set it, the stage is the one entered last.
+enum ResetStage : uint8_t
+{
+  STAGE_BOOT,
+  STAGE_LOOP,
+  STAGE_HVAC_COMMAND,
+  STAGE_HVAC_CONNECT,
+  STAGE_HVAC_SYNC,
+  STAGE_MQTT,
+  STAGE_COUNT
+};
+
+// Written as the firmware runs, all times are millis() of that boot.
+struct ResetSnapshot
+{
+  uint32_t loopMs;        // start of the last loop iteration
+  uint32_t loopUs;        // duration of the iteration before it
+  uint32_t loopMaxUs;
+  uint32_t stageMs;       // when the stage was entered
+  uint32_t uartCommandMs; // when the last command was sent
+  char uartCommand[4];    // last command sent to the unit, named as in /metrics
+  uint8_t stage;
+};
+
+struct CrashRecord
+{
+  bool valid;
+  uint8_t reason;       // esp_reset_reason_t
+  uint16_t bootsSince;  // resets since, safe mode restarts included
+  uint32_t logSeq;      // log position after the last line of the boot that crashed
+  ResetSnapshot snapshot;
+};
+
+// Reset diagnostics. The snapshot of the running boot and the last crash are kept in memory that
+// survives resets other than power loss, as is the log (see LogRing), so what hung can be looked
+// at after the watchdog fired and safe mode restarted, without a USB cable.
+// Updated by the loop and controller tasks, the crash record only changes in begin().
+class ResetReport
+{
+public:
+  // Call early in setup(), after the log is up: files a watchdog, panic or brownout reset as the
+  // last crash and starts a new snapshot.
+  void begin();
+  void stage(ResetStage stage);
+  void uartCommand(const char *command);
+  void loopIteration(uint32_t us);
+
+  esp_reset_reason_t reason() const { return resetReason; }
+  const CrashRecord &lastCrash() const;
+
+  static const char *reasonName(uint8_t reason);
+  static const char *stageName(uint8_t stage);
+  // "software; last crash task_wdt 1 reset ago: ..." for the status page and the log.
+  size_t describe(char *out, size_t size) const;
+  // Same as JSON for MQTT, with the last log lines before the crash while the log still has them.
+  size_t writeJson(char *out, size_t size) const;
+
+private:
+  esp_reset_reason_t resetReason = ESP_RST_UNKNOWN;
+};
+
+extern ResetReport resetReport;
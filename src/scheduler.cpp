@@ -0,0 +1,226 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "scheduler.h"
+#include "logger.h"
+#include "metrics.h"
+
+#define TAG "sched"
+
+// Values of a job writeJobs() puts in a metric family
+enum JobField : uint8_t
+{
+  JOB_RUNS,
+  JOB_OVERRUNS,
+  JOB_RUN_SECONDS,
+  JOB_RUN_MAX_SECONDS,
+  JOB_LATE_MAX_SECONDS
+};
+
+Scheduler *Scheduler::instances[SCHEDULER_TASKS];
+uint8_t Scheduler::instanceCount = 0;
+
+Scheduler scheduler("loop");
+
+Scheduler::Scheduler(const char *task) : task(task)
+{
+  // Schedulers are globals, constructed before any task runs
+  if (instanceCount < SCHEDULER_TASKS)
+    instances[instanceCount++] = this;
+}
+
+int Scheduler::add(const char *name, JobFunction run, uint32_t periodMs, uint32_t budgetUs)
+{
+  if (jobCount >= SCHEDULER_JOBS)
+  {
+    LOGE(TAG, "No room for job %s", name);
+    return -1;
+  }
+  SchedulerJob job = {};
+  job.name = name;
+  job.run = run;
+  job.periodMs = periodMs;
+  job.budgetUs = budgetUs;
+  job.dueMs = millis();
+  job.armed = periodMs != 0;
+  portENTER_CRITICAL(&lock);
+  jobs[jobCount] = job;
+  portEXIT_CRITICAL(&lock);
+  return jobCount++;
+}
+
+void Scheduler::at(int id, uint32_t delayMs)
+{
+  if (id < 0 || id >= jobCount)
+    return;
+  jobs[id].dueMs = millis() + delayMs;
+  jobs[id].armed = true;
+}
+
+void Scheduler::every(int id, uint32_t periodMs)
+{
+  if (id < 0 || id >= jobCount || periodMs == 0)
+    return;
+  portENTER_CRITICAL(&lock);
+  jobs[id].periodMs = periodMs;
+  portEXIT_CRITICAL(&lock);
+  at(id, periodMs);
+}
+
+void Scheduler::cancel(int id)
+{
+  if (id >= 0 && id < jobCount)
+    jobs[id].armed = false;
+}
+
+uint32_t Scheduler::run()
+{
+  uint32_t passStart = micros();
+  uint32_t now = millis();
+  uint32_t due = 0;
+  for (uint8_t i = 0; i < jobCount; i++)
+  {
+    if (jobs[i].armed && (int32_t)(jobs[i].dueMs - now) <= 0)
+      due |= 1UL << i;
+  }
+
+  while (due)
+  {
+    int next = -1;
+    for (uint8_t i = 0; i < jobCount; i++)
+    {
+      if ((due & (1UL << i)) && (next < 0 || (int32_t)(jobs[i].dueMs - jobs[next].dueMs) < 0))
+        next = i;
+    }
+    due &= ~(1UL << next);
+    SchedulerJob &job = jobs[next];
+    // Cancelled by a job that ran before it in this pass
+    if (!job.armed)
+      continue;
+
+    uint32_t start = millis();
+    uint32_t lateMs = start - job.dueMs;
+    if (job.periodMs == 0)
+      job.armed = false;
+    else if ((int32_t)(job.dueMs + job.periodMs - start) > 0)
+      job.dueMs += job.periodMs;
+    else
+      job.dueMs = start + job.periodMs; // fell a whole period behind, skip rather than run it back to back
+
+    uint32_t runStart = micros();
+    job.run(); // may re-arm itself
+    account(job, micros() - runStart, lateMs);
+  }
+
+  uint32_t passUs = micros() - passStart;
+  portENTER_CRITICAL(&lock);
+  passMax = max(passMax, passUs);
+  portEXIT_CRITICAL(&lock);
+
+  now = millis();
+  uint32_t wait = SCHEDULER_IDLE_MAX_MS;
+  for (uint8_t i = 0; i < jobCount; i++)
+  {
+    if (!jobs[i].armed)
+      continue;
+    int32_t left = (int32_t)(jobs[i].dueMs - now);
+    wait = min(wait, (uint32_t)max(left, (int32_t)0));
+  }
+  return wait;
+}
+
+void Scheduler::account(SchedulerJob &job, uint32_t us, uint32_t lateMs)
+{
+  bool overrun = us > job.budgetUs;
+  bool worst = us > job.maxUs;
+  portENTER_CRITICAL(&lock);
+  job.runs++;
+  job.lastUs = us;
+  job.totalUs += us;
+  job.maxUs = max(job.maxUs, us);
+  job.maxLateMs = max(job.maxLateMs, lateMs);
+  if (overrun)
+    job.overruns++;
+  portEXIT_CRITICAL(&lock);
+
+  // Every overrun is counted, only the ones that set a new worst are logged
+  if (overrun && worst)
+    LOGW(TAG, "Job %s/%s took %lu us, budget %lu us", task, job.name, (unsigned long)us, (unsigned long)job.budgetUs);
+}
+
+SchedulerJob Scheduler::job(uint8_t id)
+{
+  SchedulerJob copy = {};
+  portENTER_CRITICAL(&lock);
+  if (id < jobCount)
+    copy = jobs[id];
+  portEXIT_CRITICAL(&lock);
+  return copy;
+}
+
+uint32_t Scheduler::passMaxUs()
+{
+  portENTER_CRITICAL(&lock);
+  uint32_t us = passMax;
+  portEXIT_CRITICAL(&lock);
+  return us;
+}
+
+void Scheduler::writeAll(HtmlWriter &out)
+{
+  // One HELP per family, followed by the jobs of every task
+  Metrics::writeHelp(out, "dk2mqtt_job_runs_total", "counter", "Runs of each job");
+  for (uint8_t i = 0; i < instanceCount; i++)
+    instances[i]->writeJobs(out, "dk2mqtt_job_runs_total", JOB_RUNS);
+  Metrics::writeHelp(out, "dk2mqtt_job_overruns_total", "counter", "Runs longer than the job's budget");
+  for (uint8_t i = 0; i < instanceCount; i++)
+    instances[i]->writeJobs(out, "dk2mqtt_job_overruns_total", JOB_OVERRUNS);
+  Metrics::writeHelp(out, "dk2mqtt_job_run_seconds_total", "counter", "Time spent running each job");
+  for (uint8_t i = 0; i < instanceCount; i++)
+    instances[i]->writeJobs(out, "dk2mqtt_job_run_seconds_total", JOB_RUN_SECONDS);
+  Metrics::writeHelp(out, "dk2mqtt_job_run_max_seconds", "gauge", "Longest run of each job");
+  for (uint8_t i = 0; i < instanceCount; i++)
+    instances[i]->writeJobs(out, "dk2mqtt_job_run_max_seconds", JOB_RUN_MAX_SECONDS);
+  Metrics::writeHelp(out, "dk2mqtt_job_late_max_seconds", "gauge", "Longest a job started past its deadline");
+  for (uint8_t i = 0; i < instanceCount; i++)
+    instances[i]->writeJobs(out, "dk2mqtt_job_late_max_seconds", JOB_LATE_MAX_SECONDS);
+
+  char line[96];
+  Metrics::writeHelp(out, "dk2mqtt_task_pass_max_seconds", "gauge", "Longest scheduler pass of each task, all its jobs due at once");
+  for (uint8_t i = 0; i < instanceCount; i++)
+    out.write(line, snprintf(line, sizeof(line), "dk2mqtt_task_pass_max_seconds{task=\"%s\"} %.6f\n", instances[i]->task, instances[i]->passMaxUs() / 1e6));
+}
+
+void Scheduler::writeJobs(HtmlWriter &out, const char *name, uint8_t field)
+{
+  // Job names and count only change during setup, the numbers are copied one job at a time
+  char line[128];
+  for (uint8_t i = 0; i < jobCount; i++)
+  {
+    SchedulerJob copy = job(i);
+    int len = snprintf(line, sizeof(line), "%s{task=\"%s\",job=\"%s\"} ", name, task, copy.name);
+    switch (field)
+    {
+    case JOB_RUNS: len += snprintf(line + len, sizeof(line) - len, "%u\n", copy.runs); break;
+    case JOB_OVERRUNS: len += snprintf(line + len, sizeof(line) - len, "%u\n", copy.overruns); break;
+    case JOB_RUN_SECONDS: len += snprintf(line + len, sizeof(line) - len, "%.6f\n", copy.totalUs / 1e6); break;
+    case JOB_RUN_MAX_SECONDS: len += snprintf(line + len, sizeof(line) - len, "%.6f\n", copy.maxUs / 1e6); break;
+    case JOB_LATE_MAX_SECONDS: len += snprintf(line + len, sizeof(line) - len, "%.3f\n", copy.maxLateMs / 1e3); break;
+    }
+    out.write(line, min(len, (int)sizeof(line) - 1));
+  }
+}
@@ -0,0 +1,95 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include "html_template.h"
+
+// Jobs registered at once, ids fit a bit mask
+#define SCHEDULER_JOBS 16
+// Longest sleep run() asks for when nothing is armed
+#define SCHEDULER_IDLE_MAX_MS 100
+// Schedulers reported by writeAll(), one per task running jobs
+#define SCHEDULER_TASKS 2
+
+typedef void (*JobFunction)();
+
+struct SchedulerJob
+{
+  const char *name;
+  JobFunction run;
+  uint32_t periodMs; // 0 for a one-shot job
+  uint32_t budgetUs; // longer runs are overruns
+  uint32_t dueMs;
+  bool armed;
+  // Accounting, times of a run in microseconds
+  uint32_t runs;
+  uint32_t overruns;
+  uint32_t lastUs;
+  uint32_t maxUs;
+  uint32_t maxLateMs; // longest start past the deadline
+  uint64_t totalUs;
+};
+
+// Deadline based cooperative scheduler, one per task running jobs. Jobs are plain functions that do
+// a bounded piece of work and return: periodic ones run every periodMs, one-shot ones each time they
+// are armed, so a job that has to wait re-arms itself instead of calling delay(). The longest run of
+// any job bounds how long the task can be held up, each job's run time is accounted and a run over
+// its budget is logged, so the job to blame shows up in /metrics.
+// Jobs are added and run by the task owning the scheduler, the accounting can be read from any task.
+class Scheduler
+{
+public:
+  // task labels the jobs in /metrics
+  explicit Scheduler(const char *task);
+
+  // Returns the job id, -1 when the table is full. Periodic jobs are due right away.
+  int add(const char *name, JobFunction run, uint32_t periodMs, uint32_t budgetUs);
+  // (Re)arms a job delayMs from now, a periodic job keeps its period from there.
+  void at(int id, uint32_t delayMs);
+  // Gives a periodic job a new period, its next run is periodMs from now.
+  void every(int id, uint32_t periodMs);
+  void cancel(int id);
+  // Runs every job due, earliest deadline first and each at most once, then returns the
+  // milliseconds until the next one is due.
+  uint32_t run();
+
+  uint8_t count() const { return jobCount; }
+  // Copy of a job's accounting.
+  SchedulerJob job(uint8_t id);
+  // Longest run() pass, the worst the task was held up.
+  uint32_t passMaxUs();
+  // Prometheus text exposition of the job accounting of every scheduler.
+  static void writeAll(HtmlWriter &out);
+
+private:
+  static Scheduler *instances[SCHEDULER_TASKS];
+  static uint8_t instanceCount;
+
+  const char *task;
+  portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+  SchedulerJob jobs[SCHEDULER_JOBS] = {};
+  uint8_t jobCount = 0;
+  uint32_t passMax = 0;
+
+  void account(SchedulerJob &job, uint32_t us, uint32_t lateMs);
+  void writeJobs(HtmlWriter &out, const char *name, uint8_t field);
+};
+
+// Jobs of the loop task
+extern Scheduler scheduler;
@@ -0,0 +1,106 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "session.h"
+
+void SessionTable::create(char *cookie, size_t size)
+{
+  // Reuse an expired slot, otherwise replace the least recently used session
+  unsigned long now = millis();
+  Session *slot = &slots[0];
+  for (Session &candidate : slots)
+  {
+    if (!candidate.active || now - candidate.lastUsed > SESSION_IDLE_TIMEOUT_MS)
+    {
+      slot = &candidate;
+      break;
+    }
+    if (now - candidate.lastUsed > now - slot->lastUsed)
+      slot = &candidate;
+  }
+
+  static const char hex[] = "0123456789abcdef";
+  for (size_t i = 0; i < SESSION_TOKEN_BYTES; i += 4)
+  {
+    // The RF subsystem is up once WiFi runs, esp_random() is then a true random source
+    uint32_t random = esp_random();
+    for (size_t j = 0; j < 4; j++)
+    {
+      slot->token[(i + j) * 2] = hex[(random >> (j * 8 + 4)) & 0xf];
+      slot->token[(i + j) * 2 + 1] = hex[(random >> (j * 8)) & 0xf];
+    }
+  }
+  slot->lastUsed = now;
+  slot->active = true;
+  snprintf(cookie, size, SESSION_COOKIE_NAME "=%.*s; Path=/; HttpOnly; SameSite=Strict", SESSION_TOKEN_LEN, slot->token);
+}
+
+bool SessionTable::validate(const char *cookieHeader)
+{
+  Session *session = find(cookieHeader);
+  if (session == nullptr)
+    return false;
+  session->lastUsed = millis();
+  return true;
+}
+
+void SessionTable::revoke(const char *cookieHeader)
+{
+  Session *session = find(cookieHeader);
+  if (session != nullptr)
+    session->active = false;
+}
+
+Session *SessionTable::find(const char *cookieHeader)
+{
+  const char *token = tokenOf(cookieHeader);
+  if (token == nullptr)
+    return nullptr;
+
+  // No early exit, neither on the first differing byte nor on the matching slot, so the response
+  // time says nothing about how much of a guessed token was right.
+  unsigned long now = millis();
+  Session *match = nullptr;
+  for (Session &session : slots)
+  {
+    if (session.active && now - session.lastUsed > SESSION_IDLE_TIMEOUT_MS)
+      session.active = false;
+    uint8_t diff = session.active ? 0 : 1;
+    for (size_t i = 0; i < SESSION_TOKEN_LEN; i++)
+      diff |= session.token[i] ^ token[i];
+    if (diff == 0)
+      match = &session;
+  }
+  return match;
+}
+
+const char *SessionTable::tokenOf(const char *cookieHeader)
+{
+  // Cookie: a=1; M2MSESSIONID=<token>; b=2
+  static const size_t nameLen = sizeof(SESSION_COOKIE_NAME) - 1;
+  for (const char *c = cookieHeader; c != nullptr && *c; c = strchr(c, ';'))
+  {
+    while (*c == ';' || *c == ' ')
+      c++;
+    if (strncmp(c, SESSION_COOKIE_NAME "=", nameLen + 1) != 0)
+      continue;
+    const char *token = c + nameLen + 1;
+    size_t len = strcspn(token, "; ");
+    return len == SESSION_TOKEN_LEN ? token : nullptr;
+  }
+  return nullptr;
+}
@@ -0,0 +1,58 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <Arduino.h>
+
+// Logged in browsers at the same time, the oldest session is dropped to make room.
+#define SESSION_SLOTS 8
+// A session unused for a day is forgotten.
+#define SESSION_IDLE_TIMEOUT_MS (24UL * 60 * 60 * 1000)
+// Random bytes per token, sent hex encoded in the cookie.
+#define SESSION_TOKEN_BYTES 16
+#define SESSION_TOKEN_LEN (SESSION_TOKEN_BYTES * 2)
+#define SESSION_COOKIE_NAME "M2MSESSIONID"
+
+struct Session
+{
+  char token[SESSION_TOKEN_LEN]; // hex, not null terminated
+  unsigned long lastUsed;         // millis(), sessions expire after SESSION_IDLE_TIMEOUT_MS without requests
+  bool active;
+};
+
+// Login sessions for the web interface. Each login gets a random token from the hardware RNG,
+// a request is authenticated when its cookie matches one of the live tokens. The table lives in RAM,
+// so saving a new password (which reboots) logs every browser out.
+// All calls come from the web task.
+class SessionTable
+{
+public:
+  // New session, writes the Set-Cookie header value for it into cookie.
+  void create(char *cookie, size_t size);
+  // True when the Cookie header carries a live token, which is then kept alive.
+  bool validate(const char *cookieHeader);
+  // Logout, forgets the session of this Cookie header.
+  void revoke(const char *cookieHeader);
+
+private:
+  Session slots[SESSION_SLOTS] = {};
+
+  // Slot holding the cookie's token or nullptr. Compares against every live slot in constant time.
+  Session *find(const char *cookieHeader);
+  static const char *tokenOf(const char *cookieHeader);
+};
@@ -0,0 +1,200 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "state_encoder.h"
+
+size_t StateEncoder::encodeState(const HVACState &state, char *buffer, size_t size)
+{
+  StateEncoder encoder(buffer, size);
+  encoder.begin();
+  encoder.addState(state);
+  return encoder.end();
+}
+
+size_t StateEncoder::encodeSample(const HVACState &state, unsigned long ageMs, char *buffer, size_t size)
+{
+  // Replayed samples carry their age in seconds, there is no wall clock to stamp them with.
+  StateEncoder encoder(buffer, size);
+  encoder.begin();
+  encoder.addState(state);
+  encoder.addInt("sampleAge", ageMs / 1000);
+  return encoder.end();
+}
+
+size_t StateEncoder::encodeDelta(const HVACState &previous, const HVACState &state, char *buffer, size_t size)
+{
+  StateEncoder encoder(buffer, size);
+  encoder.begin();
+  if (state.outsideTemperature != previous.outsideTemperature)
+    encoder.addFloat("outsideTemperature", state.outsideTemperature);
+  if (state.coilTemperature != previous.coilTemperature)
+    encoder.addFloat("internalCoilTemperature", state.coilTemperature);
+  if (state.temperature != previous.temperature)
+    encoder.addFloat("temperature", state.temperature);
+  if (strcmp(state.fan, previous.fan) != 0)
+    encoder.addString("fan", state.fan);
+  if (state.fanRPM != previous.fanRPM)
+    encoder.addInt("fanRPM", state.fanRPM);
+  if (state.roomTemperature != previous.roomTemperature)
+    encoder.addFloat("roomTemperature", state.roomTemperature);
+  if (strcmp(state.vane, previous.vane) != 0)
+    encoder.addString("vane", state.vane);
+  if (strcmp(state.wideVane, previous.wideVane) != 0)
+    encoder.addString("wideVane", state.wideVane);
+  // mode and action point to string literals, but not necessarily the same literal for the same text
+  if (strcmp(state.mode, previous.mode) != 0)
+    encoder.addString("mode", state.mode);
+  if (strcmp(state.action, previous.action) != 0)
+    encoder.addString("action", state.action);
+  if (state.compressorFrequency != previous.compressorFrequency)
+    encoder.addInt("compressorFrequency", state.compressorFrequency);
+  if (strcmp(state.errorCode, previous.errorCode) != 0)
+    encoder.addString("errorCode", state.errorCode);
+  if (state.hasEnergyMeter && (!previous.hasEnergyMeter || state.energyMeter != previous.energyMeter))
+    encoder.addFloat("energyMeter", state.energyMeter);
+  return encoder.end();
+}
+
+size_t StateEncoder::encodeSettings(const HVACState &state, char *buffer, size_t size)
+{
+  StateEncoder encoder(buffer, size);
+  encoder.begin();
+  encoder.addFloat("temperature", state.temperature);
+  encoder.addString("fan", state.fan);
+  encoder.addString("vane", state.vane);
+  encoder.addString("wideVane", state.wideVane);
+  encoder.addString("mode", state.mode);
+  return encoder.end();
+}
+
+void StateEncoder::addState(const HVACState &state)
+{
+  // Same key order as the former ArduinoJson document, HA templates don't care but diffs in logs are easier to read.
+  addFloat("outsideTemperature", state.outsideTemperature);
+  addFloat("internalCoilTemperature", state.coilTemperature);
+  addFloat("temperature", state.temperature);
+  addString("fan", state.fan);
+  addInt("fanRPM", state.fanRPM);
+  addFloat("roomTemperature", state.roomTemperature);
+  addString("vane", state.vane);
+  addString("wideVane", state.wideVane);
+  addString("mode", state.mode);
+  addString("action", state.action);
+  addInt("compressorFrequency", state.compressorFrequency);
+  addString("errorCode", state.errorCode);
+  if (state.hasEnergyMeter)
+  {
+    addFloat("energyMeter", state.energyMeter);
+  }
+}
+
+void StateEncoder::begin()
+{
+  len = 0;
+  overflow = size == 0;
+  raw("{", 1);
+}
+
+size_t StateEncoder::end()
+{
+  raw("}", 1);
+  if (overflow || len >= size)
+  {
+    if (size)
+      buffer[0] = '\0';
+    return 0;
+  }
+  buffer[len] = '\0';
+  return len;
+}
+
+void StateEncoder::raw(const char *text, size_t textLen)
+{
+  // Keep one byte for the terminating null.
+  if (overflow || len + textLen >= size)
+  {
+    overflow = true;
+    return;
+  }
+  memcpy(buffer + len, text, textLen);
+  len += textLen;
+}
+
+void StateEncoder::key(const char *name)
+{
+  if (len > 1)
+    raw(",", 1);
+  raw("\"", 1);
+  raw(name, strlen(name));
+  raw("\":", 2);
+}
+
+void StateEncoder::addString(const char *name, const char *value)
+{
+  key(name);
+  raw("\"", 1);
+  if (value != nullptr)
+  {
+    // Values may come straight from MQTT payloads, escape what would break the document.
+    for (const char *c = value; *c; c++)
+    {
+      if (*c == '"' || *c == '\\')
+      {
+        char escaped[2] = {'\\', *c};
+        raw(escaped, 2);
+      }
+      else if ((uint8_t)*c < 0x20)
+      {
+        char escaped[7];
+        snprintf(escaped, sizeof(escaped), "\\u%04x", (uint8_t)*c);
+        raw(escaped, 6);
+      }
+      else
+      {
+        raw(c, 1);
+      }
+    }
+  }
+  raw("\"", 1);
+}
+
+void StateEncoder::addInt(const char *name, int value)
+{
+  char number[12];
+  int numberLen = snprintf(number, sizeof(number), "%d", value);
+  key(name);
+  raw(number, numberLen);
+}
+
+void StateEncoder::addFloat(const char *name, float value)
+{
+  key(name);
+  if (isnan(value) || isinf(value))
+  {
+    raw("null", 4);
+    return;
+  }
+
+  // Two decimals are enough for every value we publish, drop the trailing zeros like ArduinoJson does.
+  char number[16];
+  int numberLen = snprintf(number, sizeof(number), "%.2f", value);
+  while (numberLen > 0 && number[numberLen - 1] == '0')
+    numberLen--;
+  if (numberLen > 0 && number[numberLen - 1] == '.')
+    numberLen--;
+  raw(number, numberLen);
+}
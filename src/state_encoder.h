@@ -0,0 +1,73 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <Arduino.h>
+
+// Big enough for the full state document with the longest field values.
+#define STATE_JSON_SIZE 384
+
+// State published to Home Assistant, already converted to HA values and local temperature unit.
+// Strings are either static (mode, action) or copied in, so the struct can be freely copied.
+struct HVACState
+{
+  float temperature;
+  float roomTemperature;
+  float outsideTemperature;
+  float coilTemperature;
+  float energyMeter;
+  int fanRPM;
+  int compressorFrequency;
+  bool hasEnergyMeter;
+  const char *mode;
+  const char *action;
+  char fan[8];
+  char vane[8];
+  char wideVane[8];
+  char errorCode[8];
+};
+
+// Writes the state/settings JSON documents straight into a caller supplied buffer.
+// Returns the length written (excluding the terminating null), or 0 if the buffer is too small.
+class StateEncoder
+{
+public:
+  static size_t encodeState(const HVACState &state, char *buffer, size_t size);
+  static size_t encodeSettings(const HVACState &state, char *buffer, size_t size);
+  // State document plus "sampleAge" (seconds), used when replaying samples buffered while offline.
+  static size_t encodeSample(const HVACState &state, unsigned long ageMs, char *buffer, size_t size);
+  // Only the fields that differ from previous, "{}" when nothing changed. Same keys as encodeState.
+  static size_t encodeDelta(const HVACState &previous, const HVACState &state, char *buffer, size_t size);
+
+private:
+  char *buffer;
+  size_t size;
+  size_t len = 0;
+  bool overflow = false;
+
+  StateEncoder(char *buffer, size_t size) : buffer(buffer), size(size){};
+
+  void begin();
+  size_t end();
+  void addState(const HVACState &state);
+  void key(const char *name);
+  void raw(const char *text, size_t textLen);
+  void addString(const char *name, const char *value);
+  void addInt(const char *name, int value);
+  void addFloat(const char *name, float value);
+};
@@ -0,0 +1,53 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "state_history.h"
+
+void StateHistory::push(const HVACState &state, unsigned long now)
+{
+  samples[head].takenAt = now;
+  samples[head].state = state;
+  head = (head + 1) % STATE_HISTORY_SIZE;
+  if (count == STATE_HISTORY_SIZE)
+  {
+    dropped++;
+  }
+  else
+  {
+    count++;
+  }
+}
+
+const StateSample *StateHistory::front() const
+{
+  if (count == 0)
+    return nullptr;
+  return &samples[(head + STATE_HISTORY_SIZE - count) % STATE_HISTORY_SIZE];
+}
+
+void StateHistory::pop()
+{
+  if (count > 0)
+    count--;
+}
+
+uint32_t StateHistory::takeDropped()
+{
+  uint32_t result = dropped;
+  dropped = 0;
+  return result;
+}
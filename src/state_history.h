@@ -0,0 +1,50 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include "state_encoder.h"
+
+// Samples kept while the broker is unreachable, at the default 15s update interval this is 16 minutes.
+#define STATE_HISTORY_SIZE 64
+
+struct StateSample
+{
+  unsigned long takenAt; // millis()
+  HVACState state;
+};
+
+// Fixed size ring of state samples, the oldest sample is overwritten (and counted as dropped) when full.
+class StateHistory
+{
+public:
+  void push(const HVACState &state, unsigned long now);
+  // Oldest sample, or nullptr when empty. Only removed by pop() so a failed publish can be retried.
+  const StateSample *front() const;
+  void pop();
+  bool empty() const { return count == 0; }
+  size_t size() const { return count; }
+  // Dropped samples since the last call, reset on read so each replay reports its own losses.
+  uint32_t takeDropped();
+
+private:
+  StateSample samples[STATE_HISTORY_SIZE];
+  size_t head = 0; // next slot to write
+  size_t count = 0;
+  uint32_t dropped = 0;
+};
@@ -0,0 +1,81 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "state_snapshot.h"
+
+// NaN (no reading yet) equals itself here, otherwise an absent sensor would look changed on every sync.
+static bool sameFloat(float a, float b)
+{
+  return a == b || (isnan(a) && isnan(b));
+}
+
+// Field by field, a byte compare would also see the padding between them.
+static bool sameSnapshot(const ControllerSnapshot &a, const ControllerSnapshot &b)
+{
+  return a.settings.power == b.settings.power &&
+         a.settings.mode == b.settings.mode &&
+         sameFloat(a.settings.temperature, b.settings.temperature) &&
+         a.settings.fan == b.settings.fan &&
+         a.settings.verticalVane == b.settings.verticalVane &&
+         a.settings.horizontalVane == b.settings.horizontalVane &&
+         sameFloat(a.status.roomTemperature, b.status.roomTemperature) &&
+         sameFloat(a.status.outsideTemperature, b.status.outsideTemperature) &&
+         sameFloat(a.status.coilTemperature, b.status.coilTemperature) &&
+         sameFloat(a.status.energyMeter, b.status.energyMeter) &&
+         a.status.fanRPM == b.status.fanRPM &&
+         a.status.operating == b.status.operating &&
+         a.status.compressorFrequency == b.status.compressorFrequency &&
+         strncmp(a.status.modelName, b.status.modelName, sizeof(a.status.modelName)) == 0 &&
+         strncmp(a.status.errorCode, b.status.errorCode, sizeof(a.status.errorCode)) == 0 &&
+         a.connected == b.connected &&
+         a.synced == b.synced &&
+         a.protocol == b.protocol &&
+         a.hpConnectionTotalRetries == b.hpConnectionTotalRetries;
+}
+
+void StateSnapshot::publish(const ControllerSnapshot &snapshot)
+{
+  // Only the writer changes data, it can compare without the sequence dance
+  if (sameSnapshot(snapshot, data))
+    return;
+
+  uint32_t version = data.version + 1;
+  __atomic_store_n(&sequence, sequence + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  data = snapshot;
+  data.version = version;
+  __atomic_store_n(&sequence, sequence + 1, __ATOMIC_RELEASE);
+}
+
+ControllerSnapshot StateSnapshot::read() const
+{
+  ControllerSnapshot copy;
+  for (;;)
+  {
+    uint32_t before = __atomic_load_n(&sequence, __ATOMIC_ACQUIRE);
+    if (before & 1)
+    {
+      // The controller task is in the middle of a copy, a few hundred ns at most
+      taskYIELD();
+      continue;
+    }
+    copy = data;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&sequence, __ATOMIC_RELAXED) == before)
+      return copy;
+  }
+}
@@ -0,0 +1,50 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include "DaikinController/DaikinController.h"
+
+// What the web pages and the MQTT side need to know about the controller.
+// Setting strings point into the controller's static value tables, so the struct can be copied freely.
+struct ControllerSnapshot
+{
+  HVACSettings settings;
+  HVACStatus status;
+  bool connected;
+  bool synced; // a sync cycle completed since boot
+  uint8_t protocol;
+  unsigned int hpConnectionTotalRetries;
+  uint32_t version; // bumped by publish() whenever anything above changed
+};
+
+// Single writer (controller task), any number of readers (loop and web tasks). The writer never
+// waits; a reader that raced a publish() simply copies again (sequence lock).
+class StateSnapshot
+{
+public:
+  // Bumps the version only when a field differs from the current snapshot.
+  void publish(const ControllerSnapshot &snapshot);
+  ControllerSnapshot read() const;
+  // Cheap check for a changed snapshot, without copying it.
+  uint32_t version() const { return __atomic_load_n(&data.version, __ATOMIC_RELAXED); }
+
+private:
+  uint32_t sequence = 0; // odd while a publish() is in progress
+  ControllerSnapshot data = {};
+};
@@ -0,0 +1,186 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "syslog_sink.h"
+#include <WiFi.h>
+
+#define TAG "syslog"
+// Sending time a datagram costs, in milliseconds
+#define SYSLOG_COST (1000 / SYSLOG_RATE)
+
+SyslogSink syslogSink;
+
+// RFC 5424 severities of the log levels
+static const uint8_t severities[] = {7, 3, 4, 6, 7, 7};
+
+bool SyslogSink::validServer(const char *server)
+{
+  const char *colon = strrchr(server, ':');
+  size_t hostLen = colon != nullptr ? colon - server : strlen(server);
+  if (hostLen >= sizeof(host) || (hostLen == 0 && colon != nullptr))
+    return false;
+  for (size_t i = 0; i < hostLen; i++)
+  {
+    if (!isalnum(server[i]) && server[i] != '.' && server[i] != '-')
+      return false;
+  }
+  if (colon == nullptr)
+    return true;
+  char *end;
+  unsigned long port = strtoul(colon + 1, &end, 10);
+  return isdigit(colon[1]) && *end == '\0' && port > 0 && port <= 65535;
+}
+
+void SyslogSink::begin(const char *server, const char *name)
+{
+  strlcpy(host, validServer(server) ? server : "", sizeof(host));
+  char *colon = strrchr(host, ':');
+  if (colon != nullptr)
+  {
+    *colon = '\0';
+    port = atoi(colon + 1);
+    if (port == 0)
+      port = SYSLOG_PORT;
+  }
+  if (name[0] != '\0')
+    strlcpy(hostname, name, sizeof(hostname));
+  resolved = false;
+  lastResolveMs = 0;
+  // A lookup still running is for the old server, its result is ignored
+  lookupPending = false;
+  lastStepMs = millis();
+  credit = SYSLOG_BURST * SYSLOG_COST;
+  // Lines of the boot before a reset are in the reset report, their times would mislead here
+  cursor = Log.bootStart();
+}
+
+void SyslogSink::step()
+{
+  uint32_t now = millis();
+  if (!enabled() || now - lastStepMs < SYSLOG_INTERVAL_MS)
+    return;
+  credit = min(credit + min(now - lastStepMs, (uint32_t)(SYSLOG_BURST * SYSLOG_COST)), (uint32_t)(SYSLOG_BURST * SYSLOG_COST));
+  lastStepMs = now;
+  // Meanwhile lines pile up, the backlog limit sorts them out once the server is reachable
+  if (WiFi.status() != WL_CONNECTED || !resolve())
+    return;
+
+  uint32_t end = Log.end();
+  if (end - cursor > SYSLOG_BACKLOG_MAX)
+  {
+    droppedCount += end - SYSLOG_BACKLOG_MAX - cursor;
+    cursor = end - SYSLOG_BACKLOG_MAX;
+  }
+
+  if (droppedCount != reportedDropped && take())
+  {
+    char text[64];
+    snprintf(text, sizeof(text), "%lu log records dropped", (unsigned long)(droppedCount - reportedDropped));
+    if (send(LOG_LEVEL_WARN, TAG, now, 0, text))
+      reportedDropped = droppedCount;
+  }
+
+  LogRecord record;
+  char text[LOG_RECORD_MAX];
+  while (cursor < end && take())
+  {
+    uint32_t expected = cursor;
+    if (!Log.readRecord(cursor, end, record, text, sizeof(text)))
+    {
+      // The ring rotated past everything that was left
+      droppedCount += cursor - expected;
+      break;
+    }
+    droppedCount += cursor - 1 - expected;
+    send(record.level, record.tag, record.ms, cursor, text);
+  }
+}
+
+// Once per server: begin() is the only thing that clears resolved. Names are looked up on
+// resolveTask, step() runs on the web task and must not wait for the DNS server.
+bool SyslogSink::resolve()
+{
+  if (resolved)
+    return true;
+  if (__atomic_load_n(&lookupRunning, __ATOMIC_ACQUIRE))
+    return false;
+  if (lookupPending)
+  {
+    lookupPending = false;
+    resolved = lookupFound;
+    if (resolved)
+      address = lookupAddress;
+    else
+      LOGW(TAG, "Server %s not found", lookupHost);
+    return resolved;
+  }
+  if (lastResolveMs != 0 && millis() - lastResolveMs < SYSLOG_RESOLVE_INTERVAL_MS)
+    return false;
+  lastResolveMs = millis();
+  if (address.fromString(host))
+  {
+    resolved = true;
+    return true;
+  }
+
+  strlcpy(lookupHost, host, sizeof(lookupHost));
+  lookupPending = true;
+  __atomic_store_n(&lookupRunning, true, __ATOMIC_RELEASE);
+  if (xTaskCreate(resolveTask, "syslog dns", SYSLOG_RESOLVE_STACK_SIZE, this, 1, NULL) != pdPASS)
+  {
+    lookupPending = false;
+    __atomic_store_n(&lookupRunning, false, __ATOMIC_RELEASE);
+  }
+  return false;
+}
+
+void SyslogSink::resolveTask(void *arg)
+{
+  SyslogSink *sink = (SyslogSink *)arg;
+  sink->lookupFound = WiFi.hostByName(sink->lookupHost, sink->lookupAddress) == 1;
+  __atomic_store_n(&sink->lookupRunning, false, __ATOMIC_RELEASE);
+  vTaskDelete(NULL);
+}
+
+bool SyslogSink::take()
+{
+  if (credit < SYSLOG_COST)
+    return false;
+  credit -= SYSLOG_COST;
+  return true;
+}
+
+// sequenceId is the log sequence number plus one (RFC 5424 starts them at 1), 0 for none
+bool SyslogSink::send(uint8_t level, const char *tag, uint32_t ms, uint32_t sequenceId, const char *text)
+{
+  // No wall clock, so no TIMESTAMP: the receiver stamps the message and sysUpTime (hundredths of a
+  // second) keeps the order within a boot
+  uint8_t severity = level < sizeof(severities) ? severities[level] : 7;
+  int len = snprintf(message, sizeof(message), "<%u>1 - %s dk2mqtt - %.32s [meta", SYSLOG_FACILITY * 8 + severity, hostname, tag);
+  if (sequenceId != 0)
+    len += snprintf(message + len, sizeof(message) - len, " sequenceId=\"%lu\"", (unsigned long)sequenceId);
+  len += snprintf(message + len, sizeof(message) - len, " sysUpTime=\"%lu\"] %s", (unsigned long)(ms / 10), text);
+  len = min(len, (int)sizeof(message) - 1);
+
+  if (!udp.beginPacket(address, port) || udp.write((const uint8_t *)message, len) != (size_t)len || !udp.endPacket())
+  {
+    failedCount++;
+    return false;
+  }
+  sentCount++;
+  return true;
+}
@@ -0,0 +1,92 @@
+/*
+  Daikin2mqtt - Daikin Heat Pump to MQTT control for Home Assistant.
+  Copyright (c) 2024 - MaxMacSTN
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#pragma once
+
+#include <Arduino.h>
+#include <WiFiUdp.h>
+#include "logger.h"
+
+#define SYSLOG_PORT 514
+// Header plus the longest log line, one message per datagram (RFC 5426)
+#define SYSLOG_MESSAGE_MAX (LOG_RECORD_MAX + 160)
+// Records are collected and sent at most this often
+#define SYSLOG_INTERVAL_MS 100
+// Sustained datagrams per second, and how many may go out at once after a quiet spell
+#define SYSLOG_RATE 20
+#define SYSLOG_BURST 50
+// Records waiting beyond this are skipped and counted as dropped rather than trickled out for minutes
+#define SYSLOG_BACKLOG_MAX 256
+// Between attempts to resolve a host name that did not resolve
+#define SYSLOG_RESOLVE_INTERVAL_MS 60000
+// Host name lookups run on a task of their own, WiFi.hostByName blocks until the DNS server answers
+#define SYSLOG_RESOLVE_STACK_SIZE 3072
+// local0
+#define SYSLOG_FACILITY 16
+
+// Optional copy of the log to a remote syslog server, RFC 5424 messages over UDP. It reads the log
+// ring with its own cursor like the /events subscribers, so logging never waits on the network:
+// what the sink cannot send in time (rate limit, backlog, ring rotated past it) is counted as dropped
+// and reported to the server in a message of its own.
+// step() is called from one task only, the counters can be read from any.
+class SyslogSink
+{
+public:
+  // "host" or "host:port", empty or invalid turns the sink off. hostname is what the messages are sent from.
+  void begin(const char *server, const char *hostname);
+  // Empty, or a host name or IPv4 address with an optional :port.
+  static bool validServer(const char *server);
+  bool enabled() const { return host[0] != '\0'; }
+  // Sends the lines logged since the last call, as far as the rate limit allows.
+  void step();
+
+  uint32_t sent() const { return sentCount; }
+  uint32_t dropped() const { return droppedCount; }
+  uint32_t failed() const { return failedCount; }
+
+private:
+  WiFiUDP udp;
+  char host[64] = "";
+  char hostname[33] = "-";
+  uint16_t port = SYSLOG_PORT;
+  IPAddress address;
+  bool resolved = false;
+  uint32_t lastResolveMs = 0;
+  // Lookup in progress on the resolver task. It only writes the lookup* fields and clears
+  // lookupRunning last; step() picks the result up unless begin() has cleared lookupPending meanwhile.
+  char lookupHost[64];
+  IPAddress lookupAddress;
+  bool lookupFound = false;
+  bool lookupRunning = false;
+  bool lookupPending = false;
+  uint32_t lastStepMs = 0;
+  uint32_t cursor = 0;
+  // Token bucket in milliseconds of sending time, a datagram costs 1000 / SYSLOG_RATE
+  uint32_t credit = 0;
+  uint32_t sentCount = 0;
+  uint32_t droppedCount = 0;
+  uint32_t failedCount = 0;
+  uint32_t reportedDropped = 0; // dropped count last reported to the server
+  char message[SYSLOG_MESSAGE_MAX];
+
+  bool resolve();
+  static void resolveTask(void *arg);
+  bool take();
+  bool send(uint8_t level, const char *tag, uint32_t ms, uint32_t sequence, const char *text);
+};
+
+extern SyslogSink syslogSink;
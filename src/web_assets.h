@@ -0,0 +1,149 @@
+// Generated by tools/web_assets.py from web/, do not edit.
+
+#pragma once
+
+#include <Arduino.h>
+
+#define WEB_ASSETS_VERSION "89611891"
+
+struct WebAsset
+{
+  const char *path;
+  const char *contentType;
+  const uint8_t *data; // gzip
+  size_t length;
+  const char *etag;
+};
+
+// control.js, 2571 bytes, 911 gzipped
+const uint8_t web_control_js_gz[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x55, 0x51, 0x6f, 0xda, 0x48,
+    0x10, 0x7e, 0xe7, 0x57, 0x4c, 0x5e, 0x62, 0x5b, 0xe7, 0x9a, 0x44, 0xa7, 0x7b, 0xa1, 0xa5, 0x55,
+    0xda, 0x10, 0x5d, 0x4e, 0x09, 0x4e, 0x1b, 0xda, 0xea, 0x84, 0x50, 0xb4, 0xd8, 0x03, 0xf8, 0xce,
+    0x5e, 0x73, 0xbb, 0x6b, 0x12, 0x94, 0xf2, 0xdf, 0x6f, 0xc6, 0x5e, 0x83, 0xa1, 0x40, 0x72, 0xd2,
+    0xf9, 0x01, 0xbc, 0xbb, 0x33, 0xdf, 0x7c, 0x33, 0xb3, 0xf3, 0xb9, 0xdd, 0x86, 0x4f, 0xb9, 0x34,
+    0x2a, 0x4f, 0x61, 0x2e, 0xa6, 0xe8, 0x43, 0x34, 0x99, 0x42, 0xa2, 0x41, 0xa3, 0x81, 0x44, 0xa6,
+    0x89, 0x44, 0x18, 0x2f, 0xc1, 0xcc, 0xb0, 0x3c, 0xee, 0xc0, 0x73, 0x96, 0x48, 0x1f, 0x32, 0xf1,
+    0xe4, 0x83, 0x36, 0x38, 0xf7, 0x61, 0x86, 0xc2, 0xf8, 0xf0, 0xf4, 0xdb, 0xd9, 0xaa, 0x15, 0xe5,
+    0x52, 0x1b, 0xf8, 0xa7, 0x40, 0xb5, 0xbc, 0x13, 0x4a, 0x64, 0x1a, 0xba, 0xe0, 0x3e, 0x26, 0x32,
+    0xce, 0x1f, 0x83, 0x34, 0x8f, 0x84, 0x49, 0x72, 0x19, 0x68, 0x14, 0x2a, 0x9a, 0x05, 0x7a, 0x9e,
+    0x26, 0xc6, 0x75, 0x3e, 0x38, 0xde, 0xf0, 0x7c, 0x04, 0x3f, 0x7e, 0x80, 0xe3, 0x78, 0x2d, 0xa0,
+    0xa7, 0x3e, 0x39, 0xad, 0xd7, 0x0a, 0xe3, 0x22, 0x42, 0xd7, 0xfd, 0x7c, 0x4f, 0xe4, 0x0a, 0xa5,
+    0x50, 0x1a, 0x0f, 0xba, 0xef, 0xe1, 0xb9, 0x3c, 0xe6, 0xa7, 0x8a, 0x3b, 0xfc, 0x1b, 0x97, 0x3e,
+    0x2c, 0x44, 0x5a, 0xe0, 0x88, 0x02, 0x5b, 0xd3, 0x1a, 0xae, 0xeb, 0x78, 0x6f, 0xd7, 0x0e, 0x0a,
+    0x4d, 0xa1, 0x24, 0x84, 0xe3, 0xbf, 0x30, 0x32, 0x81, 0xd0, 0x3a, 0x99, 0xca, 0x12, 0xff, 0x99,
+    0x41, 0x46, 0x9d, 0x0a, 0x05, 0x4e, 0xba, 0x5d, 0x28, 0x64, 0x8c, 0x13, 0xaa, 0x42, 0x0c, 0x1f,
+    0xec, 0x6e, 0x87, 0xa8, 0xae, 0x2c, 0xd8, 0x8a, 0x5c, 0xf8, 0xbd, 0x35, 0x29, 0x64, 0xc4, 0xe9,
+    0x71, 0xdd, 0x06, 0x98, 0xcd, 0xdd, 0xb1, 0x67, 0x09, 0x2e, 0x84, 0x02, 0x43, 0x7c, 0xe2, 0x3c,
+    0x2a, 0x32, 0x26, 0x34, 0x45, 0xd3, 0x4b, 0x91, 0x5f, 0x3f, 0x2e, 0xaf, 0x63, 0xd7, 0x19, 0xf4,
+    0x6e, 0xef, 0x6a, 0x72, 0xc9, 0x04, 0xdc, 0x31, 0x9c, 0x9e, 0x82, 0x09, 0xaa, 0x60, 0xef, 0xb8,
+    0x1f, 0x01, 0x95, 0xdb, 0x6b, 0xe4, 0x5b, 0x1f, 0x76, 0xa1, 0x5f, 0x64, 0x63, 0x54, 0xae, 0xdd,
+    0xf0, 0xe0, 0x97, 0xd2, 0x9c, 0x1b, 0x63, 0xf9, 0x01, 0xa6, 0x1a, 0x4b, 0xd8, 0x93, 0x2d, 0xdc,
+    0xf7, 0x15, 0x6e, 0x22, 0x5f, 0x87, 0xfb, 0x66, 0x17, 0xb7, 0xfc, 0x3d, 0x98, 0xd2, 0x15, 0xe7,
+    0xf4, 0xe0, 0x78, 0x81, 0x2e, 0xc6, 0x19, 0x55, 0x9f, 0xb2, 0x5b, 0xb5, 0x5a, 0xcc, 0xa2, 0x71,
+    0x39, 0x86, 0x55, 0xe6, 0xa3, 0x9a, 0xc1, 0x0b, 0x05, 0x5a, 0x73, 0xdb, 0x03, 0xb1, 0x86, 0x3f,
+    0x61, 0x9a, 0x7c, 0x23, 0x9b, 0xd5, 0xcf, 0xe7, 0xdc, 0x19, 0x7d, 0xac, 0x07, 0xb7, 0xe1, 0x65,
+    0x8f, 0x42, 0x58, 0xcb, 0x2a, 0x47, 0xbb, 0x18, 0xfe, 0x3a, 0x0a, 0xe2, 0x44, 0x8b, 0x71, 0x4a,
+    0x77, 0x80, 0xee, 0x73, 0x63, 0xdb, 0x32, 0xea, 0x82, 0xf3, 0x7b, 0xef, 0x62, 0xe0, 0x94, 0x59,
+    0x32, 0x0b, 0x26, 0x41, 0x03, 0xc1, 0x1c, 0xfe, 0x2f, 0x12, 0x67, 0xfb, 0x49, 0x9c, 0x35, 0x49,
+    0x5c, 0x7c, 0x1d, 0x84, 0x4c, 0xa2, 0xe9, 0x78, 0x2c, 0xde, 0xd5, 0x45, 0xff, 0x50, 0xb8, 0xf3,
+    0xfd, 0xe1, 0xce, 0x9b, 0xe1, 0x3e, 0x7f, 0xbd, 0xee, 0x0d, 0xd6, 0xf1, 0x0e, 0x46, 0xf9, 0x76,
+    0xd1, 0xe7, 0xac, 0x1a, 0x70, 0x46, 0x15, 0xf8, 0xf6, 0xb8, 0xd3, 0xf7, 0xeb, 0xcb, 0xde, 0x21,
+    0x47, 0x6a, 0x75, 0xbb, 0x0d, 0x37, 0xc9, 0x02, 0xab, 0x81, 0xd4, 0x30, 0x2f, 0xf4, 0x8c, 0x0c,
+    0xac, 0x4e, 0x15, 0x32, 0x21, 0x41, 0xca, 0x65, 0x5a, 0x2d, 0x27, 0x09, 0xa6, 0xb1, 0xa6, 0x57,
+    0x61, 0x20, 0x9a, 0x09, 0x39, 0x25, 0x4b, 0xa1, 0x90, 0x06, 0x55, 0x1a, 0xab, 0x58, 0x33, 0x71,
+    0x9b, 0xc7, 0xc8, 0xb5, 0x7a, 0xe6, 0xbb, 0xf3, 0x10, 0xe5, 0x79, 0xda, 0xb1, 0xf5, 0xf4, 0x21,
+    0x56, 0x4b, 0x5a, 0x5c, 0x7e, 0xf9, 0x93, 0xde, 0xed, 0xc9, 0xa7, 0x30, 0xbc, 0x71, 0x2a, 0xe9,
+    0xeb, 0xd8, 0xe6, 0xfb, 0x30, 0x11, 0xf2, 0x81, 0xa3, 0xd2, 0x0e, 0x57, 0x76, 0xb5, 0xa3, 0x0a,
+    0xf7, 0x98, 0x92, 0xd8, 0xb8, 0x52, 0x64, 0x68, 0x55, 0xaa, 0x79, 0x47, 0x75, 0x79, 0xba, 0xbf,
+    0x5b, 0xfa, 0xe3, 0xb2, 0x4f, 0x5e, 0xa5, 0xab, 0x47, 0x2d, 0xdf, 0x48, 0x85, 0xf5, 0xa2, 0xb9,
+    0x5e, 0xbb, 0x09, 0x0a, 0xb8, 0x40, 0xeb, 0x59, 0x2a, 0x58, 0x65, 0xd4, 0x9c, 0xf3, 0x6a, 0x67,
+    0x3d, 0x50, 0xe5, 0x7f, 0x3d, 0xd7, 0x76, 0x90, 0xac, 0x6a, 0xf7, 0x16, 0x84, 0x72, 0x9f, 0x17,
+    0x2a, 0xda, 0x62, 0x8b, 0xbc, 0xcd, 0xf5, 0x92, 0xf8, 0x08, 0x0d, 0x1b, 0xd7, 0x69, 0x57, 0x47,
+    0xb5, 0x9e, 0x55, 0xab, 0x40, 0xc4, 0x71, 0x69, 0x75, 0x93, 0x90, 0x84, 0x48, 0x12, 0x16, 0x47,
+    0x1b, 0x61, 0x90, 0x8a, 0xe6, 0xe2, 0x8e, 0x96, 0x97, 0xc5, 0xe0, 0x43, 0x42, 0xff, 0xe3, 0x3e,
+    0xec, 0x07, 0x73, 0xa1, 0x34, 0xba, 0x18, 0xc4, 0xc2, 0x88, 0x86, 0x84, 0x97, 0xe9, 0xb3, 0x5d,
+    0xa0, 0xf2, 0x3c, 0x63, 0xc9, 0x45, 0x25, 0x48, 0xd5, 0x77, 0x54, 0xbb, 0x99, 0xf6, 0xd1, 0x1b,
+    0x57, 0xa3, 0xd0, 0x8d, 0x33, 0xf8, 0x64, 0xf8, 0x9b, 0xc8, 0x05, 0xec, 0xc2, 0xde, 0x20, 0x1b,
+    0x1e, 0xab, 0x2d, 0xe6, 0x86, 0x4c, 0x5e, 0xab, 0xf5, 0xdb, 0x59, 0x98, 0x43, 0x19, 0xbc, 0xd0,
+    0x5d, 0xf6, 0xdb, 0x4d, 0x92, 0xf7, 0xd6, 0xdd, 0xfd, 0x09, 0x7e, 0x1f, 0xf7, 0x0d, 0x8f, 0x8c,
+    0x26, 0xe1, 0x78, 0x09, 0x37, 0x77, 0xd9, 0xb9, 0x0b, 0xbf, 0xf7, 0xbe, 0x38, 0x3e, 0x34, 0x5c,
+    0x59, 0x19, 0xf2, 0xc9, 0xc4, 0xa1, 0xcf, 0xa5, 0x13, 0x5e, 0x5d, 0x39, 0xfc, 0xb9, 0x0c, 0xfb,
+    0xcd, 0x9c, 0xeb, 0x78, 0x76, 0xea, 0x86, 0x1b, 0xe7, 0xd1, 0x6e, 0xa8, 0x9d, 0x70, 0xa5, 0x40,
+    0xfa, 0xb0, 0xcf, 0x71, 0x1b, 0x7e, 0x75, 0x34, 0x45, 0x1a, 0xd4, 0x57, 0x67, 0xc8, 0x93, 0x5c,
+    0xe7, 0x47, 0x7e, 0xde, 0xf1, 0xe2, 0x2d, 0x84, 0x7c, 0x7d, 0xf1, 0x4a, 0x7d, 0xab, 0xb1, 0xd9,
+    0xf3, 0x05, 0xf0, 0xc7, 0x24, 0xc6, 0x6f, 0xff, 0x25, 0xc0, 0x5a, 0x44, 0xeb, 0x20, 0x35, 0xc2,
+    0x4f, 0x81, 0x56, 0xe5, 0xa7, 0xeb, 0x5f, 0x63, 0x0e, 0x4b, 0xf8, 0x0b, 0x0a, 0x00, 0x00,
+};
+
+// countdown.js, 368 bytes, 236 gzipped
+const uint8_t web_countdown_js_gz[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x5d, 0x90, 0xc1, 0x4e, 0xc3, 0x30,
+    0x0c, 0x86, 0xef, 0x7d, 0x0a, 0x4b, 0x1c, 0xd2, 0x0a, 0xd6, 0x96, 0x2b, 0xd5, 0x38, 0x20, 0x90,
+    0x40, 0x82, 0x0b, 0xda, 0x0b, 0x64, 0xa9, 0xdb, 0x45, 0x74, 0x36, 0x4a, 0x9c, 0x4d, 0x08, 0xf5,
+    0xdd, 0x49, 0x1a, 0x34, 0x36, 0x7c, 0xb2, 0x7f, 0xfb, 0xff, 0x6c, 0xb9, 0x69, 0xe0, 0x1d, 0xb7,
+    0xcc, 0xd2, 0x78, 0x7d, 0x40, 0xf8, 0xd4, 0x23, 0xfa, 0x3b, 0x30, 0x1c, 0x48, 0xa0, 0xe7, 0x23,
+    0x81, 0x25, 0xb8, 0xca, 0xa5, 0xec, 0x90, 0x60, 0x64, 0xd8, 0x6a, 0xf3, 0x01, 0xc2, 0xa9, 0x06,
+    0x17, 0x9d, 0x8b, 0xa9, 0x38, 0x68, 0xf7, 0x6b, 0x5b, 0xc3, 0x6d, 0xdb, 0x15, 0xe5, 0x10, 0xc8,
+    0x88, 0x65, 0xca, 0xea, 0x63, 0x64, 0x95, 0x15, 0x7c, 0x17, 0x10, 0xa3, 0x67, 0x13, 0xf6, 0x48,
+    0x52, 0x8f, 0x28, 0x4f, 0x13, 0xa6, 0xf4, 0xe1, 0xeb, 0xa5, 0x2f, 0xd5, 0x32, 0xaa, 0xaa, 0xda,
+    0x12, 0xa1, 0x7b, 0xde, 0xbc, 0xbd, 0x46, 0x58, 0x86, 0x5e, 0x83, 0xf2, 0xaa, 0x5b, 0xdc, 0x1e,
+    0x65, 0x63, 0xf7, 0xc8, 0x41, 0x4e, 0x3b, 0x4e, 0xe4, 0x14, 0x76, 0x28, 0xb3, 0xe7, 0x1e, 0xda,
+    0x73, 0x3d, 0x45, 0x6e, 0xac, 0x56, 0xdd, 0x85, 0xea, 0x50, 0x82, 0xbb, 0x38, 0xf4, 0xaf, 0x3f,
+    0x03, 0x4e, 0x1e, 0xff, 0x61, 0x8e, 0x96, 0xe2, 0x73, 0xea, 0x89, 0x8d, 0x4e, 0xeb, 0xeb, 0x9d,
+    0xc3, 0x21, 0x9e, 0xaa, 0x1a, 0x75, 0x66, 0x5c, 0xb2, 0xf9, 0x26, 0x7e, 0xa3, 0x6d, 0x23, 0x70,
+    0xae, 0x12, 0xf6, 0x07, 0xb5, 0xca, 0x14, 0xcb, 0x70, 0x01, 0x00, 0x00,
+};
+
+// style.css, 1961 bytes, 671 gzipped
+const uint8_t web_style_css_gz[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xc5, 0x55, 0xdb, 0x6e, 0x9b, 0x40,
+    0x10, 0x7d, 0xf7, 0x57, 0xac, 0x54, 0x45, 0x6a, 0x25, 0x83, 0xc0, 0x18, 0x27, 0xc6, 0xea, 0x97,
+    0x54, 0x7e, 0x18, 0xd8, 0xc1, 0xac, 0x0c, 0xbb, 0x74, 0x59, 0xe2, 0x24, 0x55, 0xfe, 0xbd, 0x7b,
+    0x61, 0x0d, 0x84, 0xd8, 0xe9, 0x5b, 0xe1, 0x05, 0x66, 0x0f, 0x33, 0x67, 0x66, 0xce, 0x0c, 0x94,
+    0x3d, 0xaf, 0x4b, 0x86, 0x35, 0xed, 0x50, 0xad, 0x19, 0x6f, 0x7b, 0xb5, 0xee, 0xb0, 0xc6, 0x42,
+    0x91, 0x3f, 0x2b, 0xa2, 0xaf, 0x16, 0x28, 0x65, 0xfc, 0x94, 0x91, 0xb4, 0x7d, 0x39, 0x58, 0x4b,
+    0x29, 0xb8, 0x0a, 0x3a, 0xf6, 0x86, 0x19, 0x89, 0xb1, 0x39, 0xac, 0xde, 0x57, 0xab, 0xb0, 0x01,
+    0xc6, 0x87, 0x0f, 0x14, 0xbe, 0xa8, 0x00, 0x6a, 0x76, 0xe2, 0x59, 0x8d, 0xa5, 0x72, 0xdf, 0x50,
+    0xd6, 0xb5, 0x35, 0xbc, 0x66, 0x84, 0xf1, 0x9a, 0x71, 0x0c, 0xf2, 0x5a, 0x14, 0x67, 0x77, 0xd4,
+    0x30, 0x1e, 0x5c, 0x18, 0x55, 0x55, 0x96, 0x6c, 0x23, 0x1f, 0xa3, 0x10, 0xb5, 0x90, 0x19, 0xf9,
+    0x86, 0x60, 0x6e, 0x1b, 0xc3, 0x93, 0x1c, 0xc2, 0xe4, 0x50, 0x9c, 0x4f, 0x52, 0xf4, 0x9c, 0x06,
+    0x1e, 0xbc, 0x2d, 0xcd, 0x6d, 0xc1, 0xed, 0x80, 0x6a, 0x40, 0x9e, 0x18, 0xcf, 0x48, 0x14, 0xa6,
+    0xd8, 0x90, 0xc8, 0x9e, 0xd9, 0x24, 0x7f, 0xa9, 0xd7, 0x16, 0x7f, 0x16, 0x15, 0x16, 0xe7, 0x5c,
+    0xbc, 0x1c, 0xd7, 0x13, 0xa3, 0x04, 0xca, 0xc4, 0x71, 0x70, 0xe0, 0x98, 0xb9, 0x44, 0x47, 0x87,
+    0x81, 0x64, 0xa7, 0x4a, 0x65, 0x64, 0xe7, 0xf9, 0x3e, 0xa3, 0x54, 0xac, 0x80, 0x7a, 0x48, 0x9c,
+    0x04, 0xb1, 0x39, 0x99, 0x07, 0x93, 0xc0, 0x4f, 0xf8, 0xc1, 0xef, 0x7e, 0xff, 0x30, 0xc2, 0x32,
+    0x2e, 0xd4, 0x77, 0x8b, 0x3d, 0xfe, 0x98, 0x12, 0x6a, 0xa1, 0xeb, 0x2e, 0x42, 0xd2, 0x19, 0x4b,
+    0xde, 0x37, 0x39, 0xca, 0x23, 0xf9, 0xc0, 0x33, 0x8a, 0x1e, 0x1c, 0x23, 0x9d, 0x95, 0x69, 0x92,
+    0x6d, 0x5d, 0xae, 0x3f, 0x46, 0x19, 0x68, 0x93, 0x3b, 0x0b, 0x2e, 0x98, 0x9f, 0x99, 0x0a, 0xee,
+    0x62, 0x1a, 0xf1, 0x76, 0x17, 0x30, 0x36, 0x40, 0x97, 0x9e, 0xda, 0x6b, 0xde, 0xbb, 0xc8, 0x5e,
+    0x36, 0xbd, 0x99, 0xa2, 0x96, 0x54, 0xff, 0xd5, 0x93, 0x05, 0x1b, 0xe5, 0x0c, 0xf2, 0x73, 0x7a,
+    0xd1, 0xfe, 0x8d, 0xe6, 0x40, 0x22, 0x0c, 0x11, 0x24, 0xba, 0x73, 0x2e, 0x38, 0x1e, 0x66, 0xe5,
+    0x7e, 0x1a, 0x42, 0x56, 0xe8, 0x1a, 0x98, 0xc4, 0x4f, 0xbe, 0x85, 0x4b, 0xa1, 0x0b, 0xdd, 0xd5,
+    0xb2, 0x16, 0x97, 0x8c, 0x40, 0xaf, 0xc4, 0x27, 0x5c, 0xe3, 0xd2, 0xdc, 0x73, 0xae, 0xbb, 0xb4,
+    0x88, 0xe3, 0xd4, 0xb2, 0xca, 0x05, 0x7d, 0x5d, 0x0e, 0x05, 0x29, 0x90, 0x2b, 0x94, 0x93, 0x59,
+    0x2a, 0xa1, 0x61, 0xb5, 0x9e, 0x0d, 0x1d, 0x8e, 0x02, 0x87, 0x75, 0x07, 0xbc, 0x0b, 0x3a, 0x94,
+    0xac, 0xfc, 0x2c, 0xe6, 0x63, 0x0c, 0x9b, 0xad, 0xcb, 0x9a, 0x7e, 0x9c, 0x51, 0x5f, 0x8f, 0xbc,
+    0x57, 0x4a, 0xf0, 0x35, 0x81, 0xd0, 0x3d, 0x0d, 0xb8, 0x3b, 0x53, 0x78, 0x8b, 0xa0, 0xeb, 0x7a,
+    0x46, 0xa2, 0xe9, 0x6b, 0x60, 0x46, 0xa4, 0xef, 0xcc, 0x58, 0x25, 0xd2, 0x4f, 0xc6, 0x8c, 0x65,
+    0x1a, 0xef, 0x77, 0x79, 0x3a, 0xaf, 0x4c, 0x09, 0xa5, 0xbe, 0x9c, 0xcd, 0x86, 0xf7, 0x4d, 0xd8,
+    0x84, 0xdb, 0xab, 0x97, 0xe9, 0x72, 0x09, 0x37, 0x57, 0xf3, 0x42, 0x33, 0x5e, 0xc2, 0x4a, 0x4f,
+    0x55, 0xc7, 0x14, 0x13, 0x3c, 0xa0, 0xbd, 0x04, 0xf3, 0x60, 0x68, 0x6d, 0xbb, 0x21, 0xad, 0xfb,
+    0xc7, 0x45, 0x2f, 0x3b, 0xc3, 0xad, 0x15, 0xcc, 0xa5, 0x7c, 0xad, 0x5d, 0x56, 0x99, 0xee, 0x8f,
+    0x15, 0x74, 0xef, 0x8b, 0xdd, 0x63, 0xc4, 0x89, 0x8f, 0x11, 0xb8, 0x86, 0x84, 0xb9, 0x44, 0x7a,
+    0x7b, 0x3f, 0xd1, 0x6d, 0x92, 0x26, 0xe9, 0x88, 0xbc, 0xe1, 0xf3, 0x8a, 0xdf, 0x27, 0x4e, 0x5e,
+    0x16, 0x7f, 0x92, 0xfc, 0xce, 0xe6, 0x7b, 0x2c, 0x36, 0xbb, 0xdd, 0x88, 0xfc, 0xca, 0x73, 0x0a,
+    0x50, 0xee, 0x9c, 0x67, 0x98, 0x2a, 0x94, 0x62, 0x21, 0x7c, 0x95, 0xdc, 0xf0, 0x18, 0x8f, 0x7e,
+    0x99, 0xea, 0x59, 0x00, 0xdd, 0xae, 0x71, 0xab, 0x4f, 0x45, 0xe3, 0xac, 0x06, 0xfe, 0x7b, 0x0e,
+    0xb7, 0xab, 0x72, 0x89, 0x1f, 0xcc, 0x13, 0x06, 0x9e, 0x5c, 0x5c, 0x42, 0x82, 0xc5, 0xe1, 0x3f,
+    0xb3, 0x0a, 0xaf, 0xe5, 0x5b, 0x48, 0xde, 0x8b, 0xf2, 0x3a, 0x76, 0x1b, 0xbf, 0x31, 0xfc, 0xef,
+    0x46, 0xff, 0x17, 0x9c, 0xd1, 0xec, 0xbe, 0x16, 0xbe, 0x98, 0x3f, 0x0d, 0xaa, 0x36, 0x6b, 0x52,
+    0x25, 0x77, 0x96, 0xc5, 0xfb, 0xea, 0x2f, 0x38, 0xa9, 0xbd, 0x27, 0xa9, 0x07, 0x00, 0x00,
+};
+
+const WebAsset web_assets[] = {
+    {"/control.js", "application/javascript", web_control_js_gz, sizeof(web_control_js_gz), "\"ba28cae2ad0343c0\""},
+    {"/countdown.js", "application/javascript", web_countdown_js_gz, sizeof(web_countdown_js_gz), "\"5e3e2b18a7cad25a\""},
+    {"/style.css", "text/css", web_style_css_gz, sizeof(web_style_css_gz), "\"155f6ca24d5a47e0\""},
+};
+const size_t web_assets_count = sizeof(web_assets) / sizeof(WebAsset);
@@ -0,0 +1,177 @@
+"""
+Daikin2mqtt - build time HTML template compiler.
+
+Splits every `const char html_*[] PROGMEM` page in src/html_*.h into literal
+segments and placeholder ids (_NAME_) and writes src/html_templates.h, so the
+web server can stream a page without copying it into a String and running one
+String::replace pass per placeholder.
+
+Segments point into the original PROGMEM strings (offset/length), the page text
+is not duplicated in flash.
+
+A placeholder _TXT_NAME_ whose txt_name message exists in the reference
+language is mapped to its TextId (tools/language_packs.py), renderTemplate()
+writes those messages itself.
+
+Used as a PlatformIO pre script (extra_scripts = pre:tools/html_templates.py),
+can also be run by hand: python tools/html_templates.py
+"""
+
+import os
+import re
+import sys
+
+SOURCES = ["html_common.h", "html_init.h", "html_menu.h", "html_pages.h"]
+OUTPUT = "html_templates.h"
+REFERENCE_LANGUAGE = "languages/en-GB.h"
+
+PAGE_RE = re.compile(r"const\s+char\s+(html_\w+)\s*\[\]\s*PROGMEM\s*=")
+PLACEHOLDER_RE = re.compile(r"_[A-Z0-9]+(?:_[A-Z0-9]+)*_")
+TEXT_RE = re.compile(r"^\s*const\s+char\s+(txt_\w+)\s*\[\]\s*PROGMEM", re.M)
+
+ESCAPES = {"n": "\n", "t": "\t", "r": "\r", "\\": "\\", "'": "'", '"': '"', "0": "\0"}
+
+
+def parse_literal(source, pos, path):
+    """Parse the concatenated C string literals starting at pos up to ';', return (bytes, end)."""
+    out = bytearray()
+    while True:
+        while source[pos].isspace():
+            pos += 1
+        if source.startswith("//", pos):
+            pos = source.index("\n", pos)
+            continue
+        if source.startswith("/*", pos):
+            pos = source.index("*/", pos) + 2
+            continue
+        if source[pos] == ";":
+            return bytes(out), pos
+        if source.startswith('R"', pos):
+            open_paren = source.index("(", pos)
+            delimiter = ")" + source[pos + 2:open_paren] + '"'
+            end = source.index(delimiter, open_paren)
+            out += source[open_paren + 1:end].encode("utf-8")
+            pos = end + len(delimiter)
+            continue
+        if source[pos] == '"':
+            pos += 1
+            while source[pos] != '"':
+                if source[pos] == "\\":
+                    pos += 1
+                    if source[pos] == "x":
+                        match = re.match(r"[0-9a-fA-F]+", source[pos + 1:])
+                        out.append(int(match.group(0), 16) & 0xFF)
+                        pos += 1 + len(match.group(0))
+                        continue
+                    if source[pos] not in ESCAPES:
+                        raise ValueError("%s: unsupported escape \\%s" % (path, source[pos]))
+                    out += ESCAPES[source[pos]].encode("utf-8")
+                else:
+                    out += source[pos].encode("utf-8")
+                pos += 1
+            pos += 1
+            continue
+        raise ValueError("%s: unexpected '%s' in page literal" % (path, source[pos]))
+
+
+def split_page(text):
+    """Return [(offset, length, placeholder or None)], the last segment has no placeholder."""
+    segments = []
+    start = 0
+    decoded = text.decode("latin-1")  # 1 char per byte, offsets stay byte offsets
+    for match in PLACEHOLDER_RE.finditer(decoded):
+        segments.append((start, match.start() - start, match.group(0)))
+        start = match.end()
+    segments.append((start, len(text) - start, None))
+    return segments
+
+
+def field_id(placeholder):
+    return "HF" + placeholder[:-1]
+
+
+def text_id(placeholder, texts):
+    """TextId of a _TXT_NAME_ placeholder, TXT_NONE when it is not a message."""
+    name = "txt_" + placeholder[len("_TXT_"):-1].lower()
+    return "TXT_" + name[len("txt_"):].upper() if placeholder.startswith("_TXT_") and name in texts else "TXT_NONE"
+
+
+def generate(src_dir):
+    pages = []
+    for name in SOURCES:
+        path = os.path.join(src_dir, name)
+        with open(path, encoding="utf-8") as f:
+            source = f.read()
+        for match in PAGE_RE.finditer(source):
+            text, _ = parse_literal(source, match.end(), path)
+            pages.append((match.group(1), split_page(text)))
+
+    fields = sorted({s[2] for _, segments in pages for s in segments if s[2]})
+    with open(os.path.join(src_dir, REFERENCE_LANGUAGE), encoding="utf-8") as f:
+        texts = {name.lower() for name in TEXT_RE.findall(f.read())}
+    if len(fields) >= 255:
+        raise ValueError("too many placeholders for an uint8_t field id")
+
+    lines = [
+        "// Generated by tools/html_templates.py from %s, do not edit." % ", ".join(SOURCES),
+        "// Each page is a list of {offset, length, field}: write length bytes of the page",
+        "// from offset, then the value of field (HF_NONE for the last segment).",
+        "",
+        "#pragma once",
+        "",
+        '#include "html_template.h"',
+        '#include "language_packs.h"',
+        "",
+        "enum HtmlField : uint8_t",
+        "{",
+        "  HF_NONE = 0,",
+    ]
+    lines += ["  %s," % field_id(f) for f in fields]
+    lines += ["  HF_COUNT", "};", ""]
+
+    lines.append("// Placeholder text of each field, for code that still uses String::replace")
+    lines.append("const char *const html_field_names[HF_COUNT] PROGMEM = {")
+    lines.append('    "",')
+    lines += ['    "%s",' % f for f in fields]
+    lines += ["};", ""]
+
+    lines.append("// Message written for each field by renderTemplate, TXT_NONE for fields left to the page resolver")
+    lines.append("const uint8_t html_field_texts[HF_COUNT] PROGMEM = {")
+    lines.append("    TXT_NONE,")
+    lines += ["    %s," % text_id(f, texts) for f in fields]
+    lines += ["};", ""]
+
+    for page, segments in pages:
+        lines.append("const HtmlSegment %s_segments[] PROGMEM = {" % page)
+        for offset, length, placeholder in segments:
+            lines.append("    {%d, %d, %s}," % (offset, length, field_id(placeholder) if placeholder else "HF_NONE"))
+        lines.append("};")
+        lines.append(
+            "const HtmlTemplate %s_template = {%s, %s_segments, sizeof(%s_segments) / sizeof(HtmlSegment), html_field_texts};"
+            % (page, page, page, page)
+        )
+        lines.append("")
+
+    return "\n".join(lines)
+
+
+def run(src_dir):
+    output = os.path.join(src_dir, OUTPUT)
+    content = generate(src_dir)
+    current = None
+    if os.path.exists(output):
+        with open(output, encoding="utf-8") as f:
+            current = f.read()
+    # Only touch the file when it changes so PlatformIO does not rebuild everything.
+    if current != content:
+        with open(output, "w", encoding="utf-8", newline="\n") as f:
+            f.write(content)
+        print("html_templates: updated %s" % output)
+
+
+try:
+    Import("env")  # noqa: F821, provided by PlatformIO
+    run(os.path.join(env["PROJECT_DIR"], "src"))  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        run(os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src"))
@@ -0,0 +1,153 @@
+"""
+Daikin2mqtt - build time language pack compiler.
+
+Reads every src/languages/*.h (`const char txt_*[] PROGMEM = "...";`) and writes
+src/language_packs.h: a TextId per message of the reference language and, for
+each language, its texts as one raw deflate stream. The firmware inflates the
+selected language once at boot (see language.h), so all languages fit in flash
+at the cost of a single one, and the language is picked on the Unit page
+instead of at compile time.
+
+Messages missing from a translation fall back to the reference text.
+
+Used as a PlatformIO pre script (extra_scripts = pre:tools/language_packs.py),
+can also be run by hand: python tools/language_packs.py
+"""
+
+import glob
+import os
+import re
+import zlib
+
+LANGUAGES_DIR = "languages"
+REFERENCE = "en-GB"
+OUTPUT = "language_packs.h"
+
+# Shown in the Unit page language list, the file name is used for languages not listed here.
+NAMES = {
+    "da-DA": "Dansk",
+    "en-GB": "English",
+    "es-ES": "Español",
+    "fr-FR": "Français",
+    "it-IT": "Italiano",
+    "ja-JP": "日本語",
+    "zh-CN": "中文",
+}
+
+TEXT_RE = re.compile(r'const\s+char\s+(txt_\w+)\s*\[\]\s*PROGMEM\s*=\s*((?:"(?:[^"\\]|\\.)*"\s*)+);')
+LITERAL_RE = re.compile(r'"((?:[^"\\]|\\.)*)"')
+COMMENT_RE = re.compile(r"//[^\n]*|/\*.*?\*/", re.S)
+ESCAPES = {"n": "\n", "t": "\t", "r": "\r", "\\": "\\", "'": "'", '"': '"'}
+
+
+def unescape(literal, path):
+    out = []
+    i = 0
+    while i < len(literal):
+        c = literal[i]
+        if c == "\\":
+            i += 1
+            if literal[i] not in ESCAPES:
+                raise ValueError("%s: unsupported escape \\%s" % (path, literal[i]))
+            c = ESCAPES[literal[i]]
+        out.append(c)
+        i += 1
+    return "".join(out)
+
+
+def read_language(path):
+    with open(path, encoding="utf-8") as f:
+        source = COMMENT_RE.sub("", f.read())
+    texts = {}
+    for match in TEXT_RE.finditer(source):
+        texts[match.group(1)] = "".join(unescape(part, path) for part in LITERAL_RE.findall(match.group(2)))
+    return texts
+
+
+def text_id(name):
+    return "TXT_" + name[len("txt_"):].upper()
+
+
+def c_bytes(data):
+    lines = []
+    for i in range(0, len(data), 20):
+        lines.append("    " + "".join("0x%02x," % b for b in data[i:i + 20]))
+    return lines
+
+
+def generate(src_dir):
+    paths = sorted(glob.glob(os.path.join(src_dir, LANGUAGES_DIR, "*.h")))
+    languages = [(os.path.splitext(os.path.basename(p))[0], read_language(p)) for p in paths]
+    reference = dict(languages)[REFERENCE]
+    names = list(reference)
+    if len(names) >= 255:
+        raise ValueError("too many messages for an uint8_t text id")
+
+    lines = [
+        "// Generated by tools/language_packs.py from src/%s/*.h, do not edit." % LANGUAGES_DIR,
+        "// Each pack is the null terminated texts of every TextId, in order, compressed with raw deflate.",
+        "",
+        "#pragma once",
+        "",
+        "#include <Arduino.h>",
+        "",
+        "enum TextId : uint8_t",
+        "{",
+        "  TXT_NONE = 0, // empty text, also marks template fields that are not a message",
+    ]
+    lines += ["  %s," % text_id(name) for name in names]
+    lines += ["  TXT_COUNT", "};", ""]
+    lines += [
+        "struct LanguagePack",
+        "{",
+        "  const char *code;",
+        "  const char *name;",
+        "  const uint8_t *data;",
+        "  uint16_t size;     // compressed",
+        "  uint16_t textSize; // inflated, all texts with their terminating nulls",
+        "};",
+        "",
+    ]
+
+    packs = []
+    for code, texts in languages:
+        raw = b"\0" + b"".join(texts.get(name, reference[name]).encode("utf-8") + b"\0" for name in names)
+        compressor = zlib.compressobj(9, zlib.DEFLATED, -15)
+        data = compressor.compress(raw) + compressor.flush()
+        if len(raw) > 0xFFFF:
+            raise ValueError("%s: texts too large for an uint16_t size" % code)
+        symbol = "language_pack_" + code.replace("-", "_")
+        lines.append("const uint8_t %s[] PROGMEM = {" % symbol)
+        lines += c_bytes(data)
+        lines += ["};", ""]
+        packs.append((code, NAMES.get(code, code), symbol, len(data), len(raw)))
+
+    lines.append("const LanguagePack language_packs[] PROGMEM = {")
+    for code, name, symbol, size, text_size in packs:
+        lines.append('    {"%s", "%s", %s, %d, %d},' % (code, name, symbol, size, text_size))
+    lines += ["};", "const size_t language_packs_count = sizeof(language_packs) / sizeof(LanguagePack);", ""]
+    lines.append('#define LANGUAGE_DEFAULT "%s"' % REFERENCE)
+    lines.append("")
+    return "\n".join(lines)
+
+
+def run(src_dir):
+    output = os.path.join(src_dir, OUTPUT)
+    content = generate(src_dir)
+    current = None
+    if os.path.exists(output):
+        with open(output, encoding="utf-8") as f:
+            current = f.read()
+    # Only touch the file when it changes so PlatformIO does not rebuild everything.
+    if current != content:
+        with open(output, "w", encoding="utf-8", newline="\n") as f:
+            f.write(content)
+        print("language_packs: updated %s" % output)
+
+
+try:
+    Import("env")  # noqa: F821, provided by PlatformIO
+    run(os.path.join(env["PROJECT_DIR"], "src"))  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        run(os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src"))
@@ -0,0 +1,101 @@
+"""
+Daikin2mqtt - build time compression of the static web assets.
+
+Gzips every file in web/ and writes src/web_assets.h with the compressed bytes,
+content type and ETag of each asset, plus WEB_ASSETS_VERSION which pages append
+to asset URLs (?v=) so browsers can cache them for good and still pick up a new
+firmware's assets.
+
+Used as a PlatformIO pre script (extra_scripts = pre:tools/web_assets.py),
+can also be run by hand: python tools/web_assets.py
+"""
+
+import gzip
+import hashlib
+import os
+import re
+
+OUTPUT = "web_assets.h"
+
+CONTENT_TYPES = {
+    ".css": "text/css",
+    ".js": "application/javascript",
+    ".html": "text/html",
+    ".svg": "image/svg+xml",
+    ".ico": "image/x-icon",
+}
+
+
+def generate(web_dir):
+    assets = []
+    for name in sorted(os.listdir(web_dir)):
+        path = os.path.join(web_dir, name)
+        extension = os.path.splitext(name)[1]
+        if not os.path.isfile(path) or extension not in CONTENT_TYPES:
+            continue
+        with open(path, "rb") as f:
+            content = f.read()
+        # mtime=0 keeps the output identical between builds
+        compressed = gzip.compress(content, compresslevel=9, mtime=0)
+        etag = hashlib.sha1(content).hexdigest()[:16]
+        symbol = "web_" + re.sub(r"\W", "_", name) + "_gz"
+        assets.append((name, CONTENT_TYPES[extension], symbol, compressed, etag, len(content)))
+
+    version = hashlib.sha1("".join(a[4] for a in assets).encode()).hexdigest()[:8]
+
+    lines = [
+        "// Generated by tools/web_assets.py from web/, do not edit.",
+        "",
+        "#pragma once",
+        "",
+        "#include <Arduino.h>",
+        "",
+        '#define WEB_ASSETS_VERSION "%s"' % version,
+        "",
+        "struct WebAsset",
+        "{",
+        "  const char *path;",
+        "  const char *contentType;",
+        "  const uint8_t *data; // gzip",
+        "  size_t length;",
+        "  const char *etag;",
+        "};",
+        "",
+    ]
+    for name, _, symbol, compressed, _, size in assets:
+        lines.append("// %s, %d bytes, %d gzipped" % (name, size, len(compressed)))
+        lines.append("const uint8_t %s[] PROGMEM = {" % symbol)
+        for i in range(0, len(compressed), 16):
+            lines.append("    " + ", ".join("0x%02x" % b for b in compressed[i:i + 16]) + ",")
+        lines.append("};")
+        lines.append("")
+
+    lines.append("const WebAsset web_assets[] = {")
+    for name, content_type, symbol, _, etag, _ in assets:
+        lines.append('    {"/%s", "%s", %s, sizeof(%s), "\\"%s\\""},' % (name, content_type, symbol, symbol, etag))
+    lines.append("};")
+    lines.append("const size_t web_assets_count = sizeof(web_assets) / sizeof(WebAsset);")
+    lines.append("")
+    return "\n".join(lines)
+
+
+def run(project_dir):
+    output = os.path.join(project_dir, "src", OUTPUT)
+    content = generate(os.path.join(project_dir, "web"))
+    current = None
+    if os.path.exists(output):
+        with open(output, encoding="utf-8") as f:
+            current = f.read()
+    # Only touch the file when it changes so PlatformIO does not rebuild everything.
+    if current != content:
+        with open(output, "w", encoding="utf-8", newline="\n") as f:
+            f.write(content)
+        print("web_assets: updated %s" % output)
+
+
+try:
+    Import("env")  # noqa: F821, provided by PlatformIO
+    run(env["PROJECT_DIR"])  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        run(os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
@@ -0,0 +1,76 @@
+// Control page, cfg is set inline by the page: {min, max, step, heat, x50}
+const queryParams = (window.location.search.split('?')[1] || '')
+    .split('&')
+    .reduce((QS, current) => {
+        const [key, value] = current.split('=');
+        return Object.assign(QS, {[key]: value !== undefined ? value : ''});
+    }, {});
+
+function setTemp(b) {
+    var t = document.getElementById('TEMP');
+    if (b && t.value < cfg.max) {
+        t.value = Number(t.value) + cfg.step;
+    } else if (!b && t.value > cfg.min) {
+        t.value = Number(t.value) - cfg.step;
+    }
+    document.getElementById('FTEMP_').submit();
+}
+
+if (queryParams['TEMP']) {
+    document.getElementById('TEMP').value = queryParams['TEMP'];
+}
+
+if (!cfg.heat) {
+    var options = document.getElementById('MODE').options;
+    options[3].disabled = (options[3].value == 'HEAT');
+}
+if (cfg.x50) {
+
+    var options = document.getElementById('MODE').options;
+    options[0].disabled = (options[0].value == 'AUTO');
+
+    options = document.getElementById('FAN').options;
+    options[1].disabled = (options[1].value == 'QUIET');
+
+    document.getElementById('VANE').disabled = true;
+    document.getElementById('WIDEVANE').disabled = true;
+}
+
+// Live values pushed by the unit, only the fields that changed are sent
+const haModes = {heat_cool: 'AUTO', dry: 'DRY', cool: 'COOL', heat: 'HEAT', fan_only: 'FAN'};
+
+function setSelect(name, value) {
+    var select = document.getElementsByName(name)[0];
+    if (select && document.activeElement !== select) {
+        select.value = value;
+    }
+}
+
+if (window.EventSource) {
+    var events = new EventSource('/events');
+    events.addEventListener('state', (e) => {
+        var state = JSON.parse(e.data);
+        if (state.roomTemperature !== undefined) {
+            document.getElementById('roomTemp').textContent = state.roomTemperature;
+        }
+        var temp = document.getElementById('TEMP');
+        if (state.temperature !== undefined && document.activeElement !== temp) {
+            temp.value = state.temperature;
+        }
+        if (state.mode !== undefined) {
+            setSelect('POWER', state.mode == 'off' ? 'OFF' : 'ON');
+            if (haModes[state.mode]) {
+                setSelect('MODE', haModes[state.mode]);
+            }
+        }
+        if (state.fan !== undefined) {
+            setSelect('FAN', state.fan);
+        }
+        if (state.vane !== undefined) {
+            setSelect('VANE', state.vane);
+        }
+        if (state.wideVane !== undefined) {
+            setSelect('WIDEVANE', state.wideVane);
+        }
+    });
+}
@@ -0,0 +1,13 @@
+// Reboot/save pages: count down in #count then go back to the root page
+var count = 10;
+(function countDown() {
+    document.getElementById('count').innerHTML = count + 's';
+    setTimeout(function() {
+        if(count > 0) {
+            count --;
+            return countDown();
+        } else {
+            window.location.href = '/';
+        }
+    }, 1000);
+})();